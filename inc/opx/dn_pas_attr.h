@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/** ************************************************************************
+ *
+ * \file dn_pas_attr.h
+ *
+ * CPS attribute ids private to PAS, i.e. not defined by the YANG models.
+ *
+ * They are allocated from a range outside the one used by the YANG
+ * models; every one is allocated here, so that no two can collide.
+ */
+
+#ifndef __DN_PAS_ATTR_H
+#define __DN_PAS_ATTR_H
+
+#include "cps_api_object_attr.h"
+
+/** Start of the PAS private attribute id range */
+#define DN_PAS_ATTR_BASE                ((cps_api_attr_id_t) 0x7fff5000)
+
+/** Event sequence number of object (u64); see dn_pas_event_seq.h */
+#define DN_PAS_ATTR_EVENT_SEQ           (DN_PAS_ATTR_BASE + 0x00)
+
+/** Request filter: return only objects changed after given sequence
+    number (u64); see dn_pas_event_seq.h */
+#define DN_PAS_ATTR_CHANGES_SINCE       (DN_PAS_ATTR_BASE + 0x01)
+
+/** Packed DOM of BASE_PAS_MEDIA_OBJ events (bin); see dn_pas_media_dom.h */
+#define DN_PAS_ATTR_MEDIA_DOM_PACKED    (DN_PAS_ATTR_BASE + 0x10)
+
+#endif /* !defined(__DN_PAS_ATTR_H) */
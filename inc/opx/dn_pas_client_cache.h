@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/** ************************************************************************
+ *
+ * \file dn_pas_client_cache.h
+ *
+ * API for a client-side cache of PAS objects.
+ *
+ * The cache is loaded with one bulk CPS GET per object class at creation,
+ * and kept current from PAS OBSERVED events, so that applications need
+ * not issue periodic CPS GETs against PAS. PAS events only carry the
+ * attributes that changed; they are merged into the cached objects.
+ * Attributes that PAS does not report in events (e.g. fan speed) are as
+ * of the last GET; use dn_pas_cache_refresh() to re-read them.
+ */
+
+#ifndef __DN_PAS_CLIENT_CACHE_H
+#define __DN_PAS_CLIENT_CACHE_H
+
+#include "std_type_defs.h"
+#include "cps_api_object.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Opaque handle to a client cache */
+typedef struct dn_pas_cache dn_pas_cache_t;
+
+/** ************************************************************************
+ *
+ * \brief Change callback
+ *
+ * Called, from the CPS event thread, after a cached object is updated.
+ * The cache lock is not held; the callback may call cache accessors.
+ *
+ * \param[in] obj     Updated object, as cached; valid only for the
+ *                    duration of the callback
+ * \param[in] context Context given when the callback was registered
+ */
+
+typedef void (*dn_pas_cache_cb_t)(cps_api_object_t obj, void *context);
+
+/** ************************************************************************
+ *
+ * \brief Create a client cache
+ *
+ * \param[in] subcats Object sub-categories to cache, e.g. BASE_PAS_FAN_OBJ;
+ *                    NULL => all supported PAS objects
+ * \param[in] n       Number of entries in subcats
+ *
+ * \returns Cache handle, or NULL on failure
+ */
+
+dn_pas_cache_t *dn_pas_cache_create(const uint_t *subcats, size_t n);
+
+/** ************************************************************************
+ *
+ * \brief Destroy a client cache
+ *
+ * May be called from a change callback, of this or another cache.
+ *
+ * \param[in] cache Cache handle
+ */
+
+void dn_pas_cache_destroy(dn_pas_cache_t *cache);
+
+/** ************************************************************************
+ *
+ * \brief Re-read all objects of a sub-category from PAS
+ *
+ * \param[in] cache  Cache handle
+ * \param[in] subcat Object sub-category
+ *
+ * \returns Boolean; true <=> successful
+ */
+
+bool dn_pas_cache_refresh(dn_pas_cache_t *cache, uint_t subcat);
+
+/** ************************************************************************
+ *
+ * \brief Register a change callback
+ *
+ * \param[in] cache   Cache handle
+ * \param[in] subcat  Object sub-category; 0 => all
+ * \param[in] cb      Callback
+ * \param[in] context Passed to callback
+ *
+ * \returns Boolean; true <=> successful
+ */
+
+bool dn_pas_cache_cb_register(dn_pas_cache_t *cache,
+                              uint_t subcat,
+                              dn_pas_cache_cb_t cb,
+                              void *context
+                              );
+
+/** ************************************************************************
+ *
+ * \brief Get a copy of a cached object
+ *
+ * \param[in] cache Cache handle
+ * \param[in] key   Object whose key, and key attributes, identify the
+ *                  object to get, as for a CPS GET of a single instance
+ *
+ * \returns Copy of cached object, to be deleted by caller with
+ *          cps_api_object_delete(), or CPS_API_OBJECT_NULL if not cached
+ */
+
+cps_api_object_t dn_pas_cache_object_get(dn_pas_cache_t *cache,
+                                         cps_api_object_t key
+                                         );
+
+/** ************************************************************************
+ *
+ * \brief Typed accessors
+ *
+ * Each returns true <=> the object is cached and has the attribute.
+ */
+
+bool dn_pas_cache_entity_present_get(dn_pas_cache_t *cache,
+                                     uint_t entity_type,
+                                     uint_t slot,
+                                     bool *present
+                                     );
+
+bool dn_pas_cache_entity_oper_status_get(dn_pas_cache_t *cache,
+                                         uint_t entity_type,
+                                         uint_t slot,
+                                         uint_t *oper_status
+                                         );
+
+bool dn_pas_cache_fan_speed_get(dn_pas_cache_t *cache,
+                                uint_t entity_type,
+                                uint_t slot,
+                                uint_t fan_idx,
+                                uint_t *speed
+                                );
+
+bool dn_pas_cache_temperature_get(dn_pas_cache_t *cache,
+                                  uint_t entity_type,
+                                  uint_t slot,
+                                  const char *name,
+                                  int *temperature
+                                  );
+
+bool dn_pas_cache_media_present_get(dn_pas_cache_t *cache,
+                                    uint_t slot,
+                                    uint_t port,
+                                    bool *present
+                                    );
+
+bool dn_pas_cache_media_type_get(dn_pas_cache_t *cache,
+                                 uint_t slot,
+                                 uint_t port,
+                                 uint_t *type
+                                 );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__DN_PAS_CLIENT_CACHE_H) */
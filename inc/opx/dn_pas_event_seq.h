@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/** ************************************************************************
+ *
+ * \file dn_pas_event_seq.h
+ *
+ * Event sequence numbers and change queries for PAS objects.
+ *
+ * Every object PAS publishes as an event carries DN_PAS_ATTR_EVENT_SEQ,
+ * a sequence number which increases monotonically per object class
+ * (entity, fan, temperature, media, ...), also across PAS restarts. A consumer which finds a gap
+ * in the sequence, or which restarts, need not re-read everything; it
+ * issues a CPS GET for the class with DN_PAS_ATTR_CHANGES_SINCE set in
+ * the filter to the last sequence number it saw, and receives only the
+ * instances published since then. Each response object carries the
+ * sequence number of the last event published for it.
+ */
+
+#ifndef __DN_PAS_EVENT_SEQ_H
+#define __DN_PAS_EVENT_SEQ_H
+
+/* Defines DN_PAS_ATTR_EVENT_SEQ and DN_PAS_ATTR_CHANGES_SINCE */
+
+#include "dn_pas_attr.h"
+
+#endif /* !defined(__DN_PAS_EVENT_SEQ_H) */
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/** ************************************************************************
+ *
+ * \file dn_pas_media_dom.h
+ *
+ * Packed binary DOM (digital optical monitoring) attribute for media events.
+ *
+ * When enabled in the platform configuration (media dom-format), PAS
+ * publishes one media event per port per real-time data poll, carrying
+ * all DOM values of the port and of its channels in the single binary
+ * attribute DN_PAS_ATTR_MEDIA_DOM_PACKED, instead of individual CPS
+ * attributes. The layout is versioned; analog values are fixed point,
+ * in thousandths of the units of the corresponding CPS attributes, and
+ * all fields are little-endian. Use dn_pas_media_dom_get() or
+ * dn_pas_media_dom_decode() rather than accessing the layout directly.
+ */
+
+#ifndef __DN_PAS_MEDIA_DOM_H
+#define __DN_PAS_MEDIA_DOM_H
+
+#include "std_type_defs.h"
+#include "cps_api_object.h"
+#include "dn_pas_attr.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DN_PAS_MEDIA_DOM_VERSION        (1)
+#define DN_PAS_MEDIA_DOM_MAX_CHANNELS   (8)
+
+/** Channel flags */
+#define DN_PAS_MEDIA_DOM_CH_RX_LOSS     (1 << 0)
+#define DN_PAS_MEDIA_DOM_CH_TX_LOSS     (1 << 1)
+#define DN_PAS_MEDIA_DOM_CH_TX_FAULT    (1 << 2)
+#define DN_PAS_MEDIA_DOM_CH_TX_DISABLE  (1 << 3)
+
+/** Packed layout, version 1: header followed by num_channels channel records */
+typedef struct __attribute__((packed)) {
+    uint8_t  version;
+    uint8_t  num_channels;
+    uint8_t  temp_state;       /**< PLATFORM_MEDIA_STATUS_t */
+    uint8_t  voltage_state;    /**< PLATFORM_MEDIA_STATUS_t */
+    uint32_t port;
+    uint64_t poll_time;        /**< ns since epoch */
+    int32_t  temperature;      /**< Thousandths */
+    int32_t  voltage;          /**< Thousandths */
+} dn_pas_media_dom_packed_hdr_t;
+
+typedef struct __attribute__((packed)) {
+    int32_t rx_power;          /**< Thousandths */
+    int32_t tx_power;          /**< Thousandths */
+    int32_t tx_bias_current;   /**< Thousandths */
+    uint8_t rx_power_state;    /**< PLATFORM_MEDIA_STATUS_t */
+    uint8_t tx_power_state;    /**< PLATFORM_MEDIA_STATUS_t */
+    uint8_t tx_bias_state;     /**< PLATFORM_MEDIA_STATUS_t */
+    uint8_t flags;             /**< DN_PAS_MEDIA_DOM_CH_xxx */
+} dn_pas_media_dom_packed_chan_t;
+
+/** Decoded DOM values */
+typedef struct {
+    uint_t   port;
+    uint64_t poll_time;
+    double   temperature;
+    double   voltage;
+    uint_t   temp_state;
+    uint_t   voltage_state;
+    uint_t   num_channels;
+    struct {
+        double rx_power;
+        double tx_power;
+        double tx_bias_current;
+        uint_t rx_power_state;
+        uint_t tx_power_state;
+        uint_t tx_bias_state;
+        uint_t flags;
+    } channels[DN_PAS_MEDIA_DOM_MAX_CHANNELS];
+} dn_pas_media_dom_t;
+
+/**
+ * Encode DOM values into packed form
+ *
+ * @param[in]  dom   DOM values
+ * @param[out] buf   Buffer to receive packed form
+ * @param[in]  size  Size of buffer
+ *
+ * @return Length of packed form, or 0 if buffer too small
+ */
+size_t dn_pas_media_dom_encode(const dn_pas_media_dom_t *dom,
+                               void *buf,
+                               size_t size
+                               );
+
+/**
+ * Decode packed DOM values
+ *
+ * @param[in]  buf  Packed form
+ * @param[in]  len  Length of packed form
+ * @param[out] dom  Decoded DOM values
+ *
+ * @return true <=> packed form is valid and of a supported version
+ */
+bool dn_pas_media_dom_decode(const void *buf,
+                             size_t len,
+                             dn_pas_media_dom_t *dom
+                             );
+
+/**
+ * Decode packed DOM attribute of a CPS object
+ *
+ * @param[in]  obj  CPS object, e.g. received media event
+ * @param[out] dom  Decoded DOM values
+ *
+ * @return true <=> object has a valid packed DOM attribute
+ */
+bool dn_pas_media_dom_get(cps_api_object_t obj, dn_pas_media_dom_t *dom);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__DN_PAS_MEDIA_DOM_H) */
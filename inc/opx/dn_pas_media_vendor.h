@@ -71,6 +71,58 @@ bool dn_pas_media_vendor_is_qualified(sdi_resource_hdl_t res_hdl, bool *qualifie
 /* Read vendor-specific information from media adapter */
 t_std_error dn_pas_media_vendor_product_info_get(sdi_resource_hdl_t res_hdl, uint8_t *buf);
 
+/* Length of media ID EEPROM image, as passed to dn_pas_media_vendor_identify():
+   lower page and upper page 0, from device address auto
+*/
+#define DN_PAS_MEDIA_VENDOR_EEPROM_LEN  256
+
+/* Identify and qualify media from an image of its ID EEPROM, read once by
+   PAS, without reading the media again; returns media type, as
+   dn_pas_media_vendor_get_media_type()
+*/
+PLATFORM_MEDIA_TYPE_t dn_pas_media_vendor_identify(sdi_resource_hdl_t res_hdl,
+                                                   const uint8_t *eeprom,
+                                                   size_t eeprom_len,
+                                                   bool *qualified);
+
+/* Vendor media plug-in function table.
+
+   A plug-in may export dn_pas_media_vendor_ops_get(), returning its table;
+   otherwise, the functions above are looked up individually, once, when the
+   plug-in is loaded. Functions not supplied have their feature bit clear,
+   and are not called.
+*/
+
+#define DN_PAS_MEDIA_VENDOR_OPS_VERSION  1
+
+enum {
+    DN_PAS_MEDIA_VENDOR_FEAT_PROPRIETARY_INFO = 1 << 0,
+    DN_PAS_MEDIA_VENDOR_FEAT_MEDIA_TYPE       = 1 << 1,
+    DN_PAS_MEDIA_VENDOR_FEAT_QUALIFIED        = 1 << 2,
+    DN_PAS_MEDIA_VENDOR_FEAT_PRODUCT_INFO     = 1 << 3,
+    DN_PAS_MEDIA_VENDOR_FEAT_IDENTIFY         = 1 << 4
+};
+
+typedef struct {
+    uint32_t version;     /* DN_PAS_MEDIA_VENDOR_OPS_VERSION */
+    uint32_t features;    /* DN_PAS_MEDIA_VENDOR_FEAT_xxx */
+
+    bool (*get_info_from_proprietary_type)(PLATFORM_MEDIA_TYPE_t type,
+                                           dn_pas_media_vendor_basic_media_info_t *prop_info,
+                                           bool *is_fake_enum,
+                                           int  *prop_len);
+    PLATFORM_MEDIA_TYPE_t (*get_media_type)(sdi_resource_hdl_t resource_hdl,
+                                            bool *qualified);
+    bool (*is_qualified)(sdi_resource_hdl_t res_hdl, bool *qualified);
+    t_std_error (*product_info_get)(sdi_resource_hdl_t res_hdl, uint8_t *buf);
+    PLATFORM_MEDIA_TYPE_t (*identify)(sdi_resource_hdl_t res_hdl,
+                                      const uint8_t *eeprom,
+                                      size_t eeprom_len,
+                                      bool *qualified);
+} dn_pas_media_vendor_ops_t;
+
+const dn_pas_media_vendor_ops_t *dn_pas_media_vendor_ops_get(void);
+
 
 #ifdef __cplusplus
 }
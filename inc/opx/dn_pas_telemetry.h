@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/** ************************************************************************
+ *
+ * \file dn_pas_telemetry.h
+ *
+ * Layout of, and reader API for, the PAS shared-memory telemetry region.
+ *
+ * PAS publishes the current readings of every entity, fan, temperature
+ * sensor, power monitor, media port and media channel, and the polling
+ * counters of each media I2C mux segment, in a fixed-layout
+ * table in shared memory. Each record is protected by a sequence lock,
+ * so local readers get consistent copies without locks, IPC or
+ * allocation.
+ */
+
+#ifndef __DN_PAS_TELEMETRY_H
+#define __DN_PAS_TELEMETRY_H
+
+#include "std_type_defs.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Name of shared memory object, as given to shm_open(), i.e. under /dev/shm */
+#define DN_PAS_TELEMETRY_SHM_NAME   "/opx_pas_telemetry"
+
+#define DN_PAS_TELEMETRY_MAGIC      (0x50415354)  /**< "PAST" */
+#define DN_PAS_TELEMETRY_VERSION    (1)           /**< Layout version */
+#define DN_PAS_TELEMETRY_MAX_RECS   (4096)        /**< Table capacity */
+#define DN_PAS_TELEMETRY_NAME_LEN   (32)
+
+/** Resource class of a telemetry record */
+typedef enum {
+    DN_PAS_TELEMETRY_CLASS_NONE = 0,
+    DN_PAS_TELEMETRY_CLASS_ENTITY,
+    DN_PAS_TELEMETRY_CLASS_FAN,
+    DN_PAS_TELEMETRY_CLASS_TEMPERATURE,
+    DN_PAS_TELEMETRY_CLASS_POWER_MONITOR,
+    DN_PAS_TELEMETRY_CLASS_MEDIA,
+    DN_PAS_TELEMETRY_CLASS_MEDIA_CHANNEL,
+    DN_PAS_TELEMETRY_CLASS_MEDIA_SEGMENT,
+} dn_pas_telemetry_class_t;
+
+/** One telemetry record */
+typedef struct {
+    uint32_t seq;           /**< Sequence lock; odd <=> update in progress */
+    uint32_t cls;           /**< Resource class, dn_pas_telemetry_class_t */
+    uint32_t entity_type;   /**< Entity type; entity, fan, temperature,
+                                 power monitor */
+    uint32_t slot;          /**< Slot */
+    uint32_t idx;           /**< Fan, sensor or power monitor index,
+                                 media port, or media I2C bus */
+    uint32_t channel;       /**< Media channel, or media I2C mux segment */
+    char     name[DN_PAS_TELEMETRY_NAME_LEN];
+    uint8_t  valid;         /**< Readings valid */
+    uint8_t  present;       /**< Entity or media present */
+    uint8_t  oper_status;   /**< BASE_CMN_OPER_STATUS_TYPE_t */
+    uint8_t  fault_type;    /**< PLATFORM_FAULT_TYPE_t */
+    uint64_t poll_time;     /**< Time of last poll, ns since epoch */
+    union {
+        struct {
+            uint32_t obs_speed;     /**< Observed speed, RPM */
+            uint32_t targ_speed;    /**< Target speed, RPM */
+            uint32_t max_speed;     /**< Maximum speed, RPM */
+        } fan;
+        struct {
+            int32_t  cur;           /**< Current temperature, deg C */
+        } temperature;
+        struct {
+            float    voltage;       /**< Volts */
+            float    current;       /**< Amps */
+            float    power;         /**< Watts */
+        } power_monitor;
+        struct {
+            double   temperature;   /**< Module temperature, deg C */
+            double   voltage;       /**< Module voltage, V */
+            /** DOM and threshold EEPROM read counters; these wrap */
+            uint32_t read_xfers;        /**< Read transactions */
+            uint32_t read_xfers_saved;  /**< Transactions saved by merging
+                                             reads */
+            uint32_t read_page_selects; /**< Page select writes */
+            uint32_t read_page_selects_saved; /**< Page select writes saved
+                                                   by reading pages in
+                                                   order */
+        } media;
+        struct {
+            double   rx_power;      /**< Rx power, mW */
+            double   tx_power;      /**< Tx power, mW */
+            double   tx_bias;       /**< Tx bias current, mA */
+            uint8_t  state;         /**< Channel enabled */
+            uint8_t  rx_loss;
+            uint8_t  tx_loss;
+            uint8_t  tx_fault;
+        } media_channel;
+        struct {
+            uint64_t polls;         /**< Port polls */
+            uint64_t mux_switches;  /**< Port polls that switched the mux */
+            uint64_t poll_time_us;  /**< Total port poll time, us */
+            uint32_t max_poll_time_us; /**< Longest port poll time, us */
+            uint32_t port_count;    /**< Ports on the segment */
+        } media_segment;
+    } u;
+} dn_pas_telemetry_rec_t;
+
+/** Shared memory region header, followed by the record table */
+typedef struct {
+    uint32_t magic;         /**< DN_PAS_TELEMETRY_MAGIC */
+    uint32_t version;       /**< DN_PAS_TELEMETRY_VERSION */
+    uint32_t rec_size;      /**< sizeof(dn_pas_telemetry_rec_t) */
+    uint32_t max_recs;      /**< Capacity of record table */
+    uint32_t num_recs;      /**< Number of records in use */
+    uint32_t generation;    /**< Incremented each time PAS rebuilds the
+                                 table; record indexes are only stable
+                                 within a generation */
+    dn_pas_telemetry_rec_t recs[];
+} dn_pas_telemetry_hdr_t;
+
+/** Opaque handle to a mapped telemetry region */
+typedef struct dn_pas_telemetry dn_pas_telemetry_t;
+
+/** ************************************************************************
+ *
+ * \brief Open the PAS telemetry region, read-only
+ *
+ * \returns Handle, or NULL if PAS has not published the region, or its
+ *          layout version is not supported
+ */
+
+dn_pas_telemetry_t *dn_pas_telemetry_open(void);
+
+/** ************************************************************************
+ *
+ * \brief Close a PAS telemetry region
+ *
+ * \param[in] t Handle returned by dn_pas_telemetry_open()
+ */
+
+void dn_pas_telemetry_close(dn_pas_telemetry_t *t);
+
+/** ************************************************************************
+ *
+ * \brief Return the generation of the record table
+ *
+ * \param[in] t Handle returned by dn_pas_telemetry_open()
+ *
+ * \returns Generation; cached record indexes are stale if it has changed
+ */
+
+uint32_t dn_pas_telemetry_generation(dn_pas_telemetry_t *t);
+
+/** ************************************************************************
+ *
+ * \brief Return the number of records in use
+ *
+ * \param[in] t Handle returned by dn_pas_telemetry_open()
+ *
+ * \returns Number of records
+ */
+
+uint_t dn_pas_telemetry_count(dn_pas_telemetry_t *t);
+
+/** ************************************************************************
+ *
+ * \brief Read a consistent copy of a record, by index
+ *
+ * \param[in]  t   Handle returned by dn_pas_telemetry_open()
+ * \param[in]  idx Record index, 0 .. dn_pas_telemetry_count() - 1
+ * \param[out] rec Where to copy record
+ *
+ * \returns Boolean; true <=> successful
+ */
+
+bool dn_pas_telemetry_read(dn_pas_telemetry_t *t,
+                           uint_t idx,
+                           dn_pas_telemetry_rec_t *rec
+                           );
+
+/** ************************************************************************
+ *
+ * \brief Find a record and read a consistent copy of it
+ *
+ * \param[in]  t           Handle returned by dn_pas_telemetry_open()
+ * \param[in]  cls         Resource class
+ * \param[in]  entity_type Entity type; ignored for media classes
+ * \param[in]  slot        Slot
+ * \param[in]  idx         Resource index, media port or media I2C bus
+ * \param[in]  channel     Media channel or media I2C mux segment; ignored
+ *                         for other classes
+ * \param[out] rec         Where to copy record
+ *
+ * \returns Boolean; true <=> record found
+ */
+
+bool dn_pas_telemetry_find(dn_pas_telemetry_t *t,
+                           dn_pas_telemetry_class_t cls,
+                           uint_t entity_type,
+                           uint_t slot,
+                           uint_t idx,
+                           uint_t channel,
+                           dn_pas_telemetry_rec_t *rec
+                           );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__DN_PAS_TELEMETRY_H) */
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_actuator.h
+ *
+ */
+
+#ifndef __PAS_ACTUATOR_H
+#define __PAS_ACTUATOR_H
+
+#include "std_type_defs.h"
+#include "private/pas_res_structs.h"
+
+/*
+ * Return true if the given value has to be written to the actuator, i.e.
+ * the value differs from the last one written, the last write failed,
+ * or the configured re-assert interval has elapsed.
+ */
+bool dn_pas_actuator_write_needed(pas_actuator_t *act, int val);
+
+/* Record the outcome of a write of the given value to the actuator */
+void dn_pas_actuator_write_done(pas_actuator_t *act, int val, bool ok);
+
+/* Forget the last value written to the actuator */
+void dn_pas_actuator_invalidate(pas_actuator_t *act);
+
+/*
+ * Forget the last value written to all actuators, e.g. when hardware
+ * may have been written behind PAS's back
+ */
+void dn_pas_actuator_invalidate_all(void);
+
+#endif /* __PAS_ACTUATOR_H */
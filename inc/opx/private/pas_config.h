@@ -35,12 +35,30 @@
 #define PAS_MEDIA_PORT_DENSITY_DEFAULT (1)  /* Port density is normally 1, but can be higher. Example it is 2 for QSFP28-DD*/
 #define PAS_MEDIA_PORT_HOLDING_DEFAULT (2000) /* Default Media Initialization holding time */
 #define PAS_MEDIA_PORT_POLLING_DEFAULT (1000) /* Default Media Polling interval time */
+#define PAS_MEDIA_RTD_MAX_INTERVAL_DFLT (20) /* Default adaptive RTD interval cap */
+#define PAS_MEDIA_RTD_MARGIN_DFLT  (10)    /* Default adaptive RTD threshold margin, in %
+                                              of warning threshold span */
+#define PAS_MEDIA_RTD_RATE_DFLT    (5)     /* Default adaptive RTD rate of change, in %
+                                              of warning threshold span per read */
+#define PAS_MEDIA_DOM_REFRESH_DFLT (60000) /* Default analog DOM refresh interval in
+                                              flag-first mode, in ms */
+#define PAS_MEDIA_INSERTION_WORKERS_MAX (8) /* Max media insertion pipeline workers */
+#define PAS_MEDIA_DISCOVERY_WORKERS_MAX (32) /* Max startup media discovery workers */
+#define PAS_MEDIA_I2C_BUS_NONE         (0)  /* I2C bus of port not configured */
+#define PAS_MEDIA_I2C_SEG_NONE         (0)  /* No I2C mux, or segment not configured */
 #define PAS_MEDIA_PORT_STR_BUF_LEN     (20)
 
 #define PAS_EXTCTRL_MAX_SSOR_IN_LIST   (16)
 
 #define PAS_FAN_ALLWED_ERR_MARGIN_BUF  (5)
 
+#define PAS_ACTUATOR_REASSERT_INTERVAL_DFLT (60000) /* Default actuator re-assert interval, in ms */
+
+#define PAS_REMOTE_POLL_INTERVAL_DFLT  (5000) /* Default remote sensor poll interval, in ms */
+#define PAS_REMOTE_POLL_TIMEOUT_DFLT   (2000) /* Default remote sensor fetch timeout, in ms */
+#define PAS_REMOTE_SENSOR_MAX          (16)   /* Maximum number of remote sensors */
+#define PAS_REMOTE_NPU_SENSOR_NAME     "NPU temp sensor" /* Default remote sensor */
+
 #define PRE_STRINGIZE(enm) #enm
 #define STRINGIZE_ENUM(enm) PRE_STRINGIZE(enm)
 
@@ -82,6 +100,60 @@ struct pas_config_comm_dev {
     uint_t poll_interval;  /* Polling interval */
 };
 
+/* Actuator (fan, LED, external control) write configuration */
+
+struct pas_config_actuator {
+    uint_t reassert_interval;  /* Interval at which an unchanged value is
+                                  re-written, in ms; 0 => never */
+};
+
+/* Remote temperature sensor configuration */
+
+typedef struct _pas_config_remote_sensor_t {
+    char     name[NAME_MAX];       /* Temperature sensor name */
+    uint_t   slot;                 /* Slot of card the sensor belongs to */
+    char     key[NAME_MAX];        /* CPS object name or id */
+    char     attr[NAME_MAX];       /* CPS temperature attribute name or id */
+    char     key_attr[NAME_MAX];   /* CPS instance key attribute name or id,
+                                      empty => none */
+    uint32_t key_val;              /* Instance key attribute value */
+    uint_t   poll_interval;        /* Poll interval, in ms */
+} pas_config_remote_sensor;
+
+/* Remote sensor poller configuration */
+
+struct pas_config_remote_poller {
+    uint_t poll_interval;      /* Default poll interval, in ms */
+    uint_t timeout;            /* Fetch timeout, in ms */
+    bool   subscribe;          /* Subscribe to remote sensor events */
+    uint_t num_sensors;        /* Number of remote sensors */
+    pas_config_remote_sensor sensors[PAS_REMOTE_SENSOR_MAX];
+};
+
+/* Analog metric classes subject to publish policy */
+
+enum {
+    PAS_METRIC_TEMPERATURE = 0,      /* Temperature sensor temperature */
+    PAS_METRIC_MEDIA_TEMPERATURE,    /* Media module temperature */
+    PAS_METRIC_MEDIA_VOLTAGE,        /* Media module voltage */
+    PAS_METRIC_MEDIA_RX_POWER,       /* Media channel rx power */
+    PAS_METRIC_MEDIA_TX_POWER,       /* Media channel tx power */
+    PAS_METRIC_MEDIA_TX_BIAS,        /* Media channel tx bias current */
+    PAS_METRIC_MAX
+};
+
+/* Publish policy for an analog metric class */
+
+struct pas_config_publish_policy {
+    bool   valid;             /* Policy configured for this class */
+    double abs_deadband;      /* Changes not exceeding this are not published */
+    double rel_deadband;      /* Changes not exceeding this percentage of the
+                                 last published value are not published */
+    uint_t min_interval;      /* Minimum interval between publishes, in ms */
+    uint_t refresh_interval;  /* Publish unchanged value after this
+                                 interval, in ms; 0 => never */
+};
+
 /*
  * Media config for each media type.
  */
@@ -110,8 +182,23 @@ typedef struct
     uint_t poll_cycles_to_skip; /* How many polling cycles to skip.
 				   This forces a delay before reading media EEPROM */
     uint_t min_holding_time;    /* Minimum number of millisecond to allow media initialization to complete */
+    uint_t i2c_bus;             /* I2C bus of media EEPROMs; ports on different
+                                   buses can be read concurrently.
+                                   PAS_MEDIA_I2C_BUS_NONE => unknown */
+    uint_t i2c_mux_seg;         /* I2C mux segment (channel) of media EEPROMs
+                                   on that bus; ports on one segment are
+                                   polled together.
+                                   PAS_MEDIA_I2C_SEG_NONE => none or unknown */
 } pas_port_info_t;
 
+/* Format of media DOM events */
+
+enum {
+    PAS_MEDIA_DOM_FORMAT_ATTRS  = 0,  /* Individual CPS attributes */
+    PAS_MEDIA_DOM_FORMAT_PACKED = 1,  /* Packed binary attribute, see dn_pas_media_dom.h */
+    PAS_MEDIA_DOM_FORMAT_BOTH   = 2
+};
+
 /* Configuration information for media resources */
 
 struct pas_config_media {
@@ -128,6 +215,31 @@ struct pas_config_media {
     pas_media_type_config  *media_type_config; /* Media type config based on platform. */
     pas_port_info_t  **port_info_tbl   ; /* An array of pointers to info of port*/
     uint_t port_count;          /* Number of ports. */
+    uint_t dom_format;          /* Format of DOM events, PAS_MEDIA_DOM_FORMAT_xxx */
+    bool   dom_flag_first;      /* Read analog DOM values only when latched
+                                   alarm/warning flags change */
+    uint_t dom_refresh_interval; /* Analog DOM refresh interval in flag-first
+                                    mode, in ms */
+    bool   rtd_adaptive;        /* Adapt real time data poll interval per port */
+    uint_t rtd_min_interval;    /* Adaptive interval for ports near thresholds */
+    uint_t rtd_max_interval;    /* Adaptive interval cap for stable ports */
+    uint_t rtd_margin;          /* Threshold proximity margin, in % */
+    uint_t rtd_rate;            /* Rate of change deemed high, in % */
+    uint_t rtd_budget;          /* Max real time data polls per poll cycle;
+                                   0 => unlimited */
+    bool   admin_aware_polling; /* Poll only presence of ports with all
+                                   channels admin down or unconfigured */
+    uint_t sfp_t_link_interval; /* Copper SFP link check interval, in ms;
+                                   0 => check on each media poll */
+    uint_t insertion_workers;   /* Media insertion pipeline worker threads;
+                                   0 => identify inserted media inline */
+    uint_t discovery_workers;   /* Startup media discovery worker threads,
+                                   one I2C bus each; 0 => discover media in
+                                   monitor polls */
+    bool   warm_restart;        /* Checkpoint media identification, and
+                                   adopt it on restart */
+    uint_t fingerprint_interval; /* Media swap check interval, in media
+                                    polls; 0 => check on insertion only */
 };
 
 /* Default configuration information for media type */
@@ -152,12 +264,19 @@ typedef struct pas_config_media_phy_s {
 typedef enum _pas_extctrl_alg_type_t { // algorithm type to compute from the sensor list
     PAS_SLIST_TYPE_MAX = 0, /* use the max of all sensors */
     PAS_SLIST_TYPE_AVG = 1, /* use the average of all sensors, keyword "avg" */
+    PAS_SLIST_TYPE_WEIGHTED = 2, /* use the weighted average of all sensors,
+                                    keyword "weighted" */
+    PAS_SLIST_TYPE_PERCENTILE = 3, /* use the given percentile of all sensors,
+                                      keyword "percentile" */
 
     PAS_SLIST_TYPE_END,
 } pas_extctrl_alg_type;
 
+#define PAS_EXTCTRL_PERCENTILE_DFLT    (50)
+
 typedef struct _pas_extctrl_sensor_config_t {
     char name[NAME_MAX];
+    uint_t weight; /* weight in weighted average, default 1 */
 } pas_extctrl_sensor_config;
 
 typedef struct _pas_extctrl_slist_config_t {
@@ -167,6 +286,7 @@ typedef struct _pas_extctrl_slist_config_t {
     pas_extctrl_alg_type type; /* driving algorithm */
     uint_t idx;
     uint_t test_force_val;
+    uint_t percentile; /* percentile for PAS_SLIST_TYPE_PERCENTILE, 0..100 */
     uint_t count; /* how many sensors are in this list */
 } pas_extctrl_slist_config;
 
@@ -195,6 +315,15 @@ struct pas_config_temperature *dn_pas_config_temperature_get(void);
 /* Get comm dev configuration */
 struct pas_config_comm_dev *dn_pas_config_comm_dev_get (void);
 
+/* Get actuator configuration */
+struct pas_config_actuator *dn_pas_config_actuator_get(void);
+
+/* Get remote sensor poller configuration */
+struct pas_config_remote_poller *dn_pas_config_remote_poller_get(void);
+
+/* Get publish policy for an analog metric class */
+struct pas_config_publish_policy *dn_pas_config_publish_policy_get(uint_t metric);
+
 /* Get external control configuration */
 pas_config_extctrl* dn_pas_config_extctrl_get(void);
 
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_event_seq.h
+ *
+ * Per-class event sequence numbers and per-instance generations; see
+ * dn_pas_event_seq.h.
+ */
+
+#ifndef __PAS_EVENT_SEQ_H
+#define __PAS_EVENT_SEQ_H
+
+#include "std_type_defs.h"
+#include "cps_api_object.h"
+#include "cps_api_operation.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Compose a printable identifier of the object instance, from the object's
+   sub-category and instance key attributes
+*/
+
+bool dn_pas_event_inst_key(cps_api_object_t obj, char *buf, size_t size);
+
+/* Test if given attribute is an instance key attribute of the object */
+
+bool dn_pas_event_key_attr_is(cps_api_object_t obj, cps_api_attr_id_t attr);
+
+/* Assign the next sequence number of its class to an event object,
+   record it as the generation of the instance, and add it to the object
+*/
+
+uint64_t dn_pas_event_seq_stamp(cps_api_object_t obj);
+
+/* Post-process the response objects a get handler appended to the given
+   get params, from index list_start on. If the filter object requested
+   changes since a sequence number, remove the objects not changed since;
+   add the generation to the remaining objects.
+*/
+
+void dn_pas_event_seq_filter(cps_api_get_params_t *param,
+                             size_t               key_ix,
+                             size_t               list_start
+                             );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__PAS_EVENT_SEQ_H) */
@@ -43,6 +43,13 @@ void dn_cache_init_extctrl_db (pas_entity_t *cd_rec);
 
 void dn_cache_init_extctrl (sdi_resource_hdl_t sdi_resource_hdl, void *data);
 
+/*
+ * Resolve the sensor lists of all extctrls of given entity; to be called
+ * once all temperature sensors of the entity are in the cache
+ */
+
+void dn_cache_bind_extctrl (pas_entity_t *cd_rec);
+
 /* Delete all extctrl record in cache for given entity */
 
 bool dn_cache_del_extctrl (pas_entity_t *cd_rec);
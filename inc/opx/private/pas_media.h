@@ -33,13 +33,17 @@
 #include "cps_api_events.h"
 #include "private/pas_config.h"
 #include "private/pas_job_queue.h"
+#include "private/pas_media_read_plan.h"
+#include "dn_pas_media_vendor.h"
 
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#define PAS_MEDIA_VENDOR_FUNC(nm)  ((typeof(& nm)) pas_media_vendor_func(# nm))
+/* Vendor media plug-in supplies given function, DN_PAS_MEDIA_VENDOR_FEAT_xxx */
+#define PAS_MEDIA_VENDOR_HAS(feat) \
+    ((pas_media_vendor_features() & DN_PAS_MEDIA_VENDOR_FEAT_ ## feat) != 0)
 
 #define PAS_MEDIA_NO_QSA_STR             "\0"
 #define PAS_MEDIA_UNKNOWN_MEDIA          "UNKNOWN MEDIA"
@@ -201,6 +205,47 @@ typedef struct {
 } pas_media_mon_count_t;
 
 
+/* media insertion pipeline stages */
+typedef enum {
+    PAS_MEDIA_INSERT_IDLE = 0,      /* No insertion processing pending */
+    PAS_MEDIA_INSERT_CATEGORY,      /* Category and supported features */
+    PAS_MEDIA_INSERT_IDENT,         /* DQ, wavelength, vendor OUI and type */
+    PAS_MEDIA_INSERT_CAPABILITY,    /* Capabilities, vendor name and properties */
+    PAS_MEDIA_INSERT_DATA,          /* Data, thresholds, vendor info and publish */
+    PAS_MEDIA_INSERT_STAGE_MAX
+} pas_media_insert_stage_t;
+
+/* Media fingerprint, read from the ID EEPROM in one transaction: SFF
+   identifier, transceiver compliance codes, base checksum and vendor
+   serial number. Field offsets are relative to the fingerprint window,
+   which starts at the identifier (lower page for SFP, upper page 00h for
+   QSFP), and are the same for both.
+*/
+
+#define PAS_MEDIA_FP_ID_OFS           0
+#define PAS_MEDIA_FP_COMPLIANCE_OFS   3
+#define PAS_MEDIA_FP_COMPLIANCE_LEN   8
+#define PAS_MEDIA_FP_CC_BASE_OFS      63
+#define PAS_MEDIA_FP_SERIAL_OFS       68
+#define PAS_MEDIA_FP_SERIAL_LEN       16
+#define PAS_MEDIA_FP_WINDOW_LEN       (PAS_MEDIA_FP_SERIAL_OFS \
+                                       + PAS_MEDIA_FP_SERIAL_LEN)
+
+typedef struct {
+    uint8_t identifier;
+    uint8_t compliance[PAS_MEDIA_FP_COMPLIANCE_LEN];
+    uint8_t cc_base;
+    uint8_t serial[PAS_MEDIA_FP_SERIAL_LEN];
+} pas_media_fp_t;
+
+/* Identity of the media a fingerprint was taken from */
+
+typedef struct {
+    pas_media_t               res_data;
+    dn_pas_basic_media_info_t media_info;
+} pas_media_fp_ident_t;
+
+
 /*
  * phy_media_tbl_t is to hold sdi handle, resource data address
  * and chaneel info per port and will used for faster access.
@@ -220,6 +265,40 @@ typedef struct _phy_media_tbl_t {
     uint_t                 poll_cycles_to_skip;
     uint_t                 mod_holding_so_far;
     pas_media_mon_count_t  count[MAX_CATEGORY];
+    uint_t                 dom_mon_status;    /* Last latched module monitor flags */
+    bool                   dom_flags_read;    /* Monitor flags read this RTD cycle */
+    bool                   dom_analog_skip;   /* Skip analog DOM reads this RTD cycle */
+    bool                   dom_demand;        /* Analog DOM read requested */
+    bool                   dom_analog_read;   /* Analog DOM read by read plan
+                                                 this RTD cycle */
+    bool                   dom_analog_valid;  /* Analog DOM values read since insertion */
+    uint64_t               dom_analog_time;   /* Time of last analog DOM read, in ms */
+    bool                   rtd_adapted;       /* Adaptive RTD interval evaluated */
+    uint_t                 rtd_interval;      /* Adaptive real time data poll interval */
+    uint_t                 rtd_zone;          /* Alarm zones at last adaptation */
+    double                 rtd_prev_temperature;
+    double                 rtd_prev_voltage;
+    uint_t                 insert_stage;      /* Next insertion pipeline stage,
+                                                 PAS_MEDIA_INSERT_xxx */
+    uint_t                 insert_gen;        /* Presence change generation */
+    bool                   eeprom_img_valid;  /* ID EEPROM image read, since
+                                                 presence change */
+    uint8_t                eeprom_img[DN_PAS_MEDIA_VENDOR_EEPROM_LEN];
+    bool                   fp_valid;          /* Fingerprint of last media
+                                                 identified is valid */
+    bool                   fp_reseated;       /* Identity restored on
+                                                 insertion, by fingerprint */
+    uint_t                 fp_poll_count;     /* Polls since fingerprint check */
+    pas_media_fp_t         fp;                /* Fingerprint of last media
+                                                 identified */
+    pas_media_fp_ident_t   *fp_ident;         /* Identity of last media
+                                                 identified */
+    bool                   cmis_info_valid;   /* CMIS memory map info read,
+                                                 since presence change */
+    bool                   cmis_paged;        /* CMIS memory is paged */
+    uint_t                 cmis_bias_mult;    /* CMIS Tx bias monitor scale */
+    pas_media_read_plan_stats_t read_stats;   /* DOM and threshold read plan
+                                                 counters */
 } phy_media_tbl_t;
 
 /*
@@ -253,17 +332,6 @@ typedef enum {
     PHY_CTRL_AQ_SUPP,
 } pas_media_phy_ctrl_sup_t;
 
-/*
- * SFP Media type map by vendor PN name
- */
-
-typedef struct _sfp_vpn_to_type_map_t {
-    char                    vendor_pn[SDI_MEDIA_MAX_VENDOR_PART_NUMBER_LEN];
-    uint_t                  wavelength;
-    PLATFORM_MEDIA_TYPE_t   type;
-} sfp_vpn_to_type_map_t;
-
-
 /*
  * SFP Media type map by gige type
  */
@@ -296,8 +364,30 @@ t_std_error dn_pas_media_phy_arb_speed_set(uint_t port, BASE_IF_SPEED_t speed);
 
 t_std_error dn_pas_media_speed_set_job_handler(void* arg);
 
-/* Look up a function in the vendor media plug-in */
-void *pas_media_vendor_func(const char *name);
+/* Load the vendor media plug-in, and resolve its function table */
+void pas_media_vendor_load(void);
+
+/* Vendor media plug-in features, DN_PAS_MEDIA_VENDOR_FEAT_xxx; none if no
+   plug-in
+*/
+uint_t pas_media_vendor_features(void);
+
+/* Vendor media plug-in calls, serialized, as plug-ins need not be thread
+   safe; only to be called if the feature is supplied, see
+   PAS_MEDIA_VENDOR_HAS
+*/
+bool pas_media_vendor_proprietary_info_get(PLATFORM_MEDIA_TYPE_t type,
+        dn_pas_media_vendor_basic_media_info_t *prop_info,
+        bool *is_fake_enum, int *prop_len);
+
+PLATFORM_MEDIA_TYPE_t pas_media_vendor_media_type_get(sdi_resource_hdl_t hdl,
+        bool *qualified);
+
+t_std_error pas_media_vendor_product_info_get(sdi_resource_hdl_t hdl,
+        uint8_t *buf);
+
+PLATFORM_MEDIA_TYPE_t pas_media_vendor_identify(sdi_resource_hdl_t hdl,
+        const uint8_t *eeprom, size_t eeprom_len, bool *qualified);
 
 /* Callback function type for getting media info from transceiver types*/
 typedef bool (*pas_media_disc_cb_t)(phy_media_tbl_t *, dn_pas_basic_media_info_t*);
@@ -306,7 +396,7 @@ typedef bool (*pas_media_disc_cb_t)(phy_media_tbl_t *, dn_pas_basic_media_info_t
 pas_media_disc_cb_t pas_media_get_disc_cb_from_trans_type (uint_t trans_type);
 
 /* Functions which resolve appropriate sfp info from map */
-bool pas_media_get_sfp_info_from_part_no (char* part_no, uint_t* wavelength, PLATFORM_MEDIA_INTERFACE_t* media_if);
+bool pas_media_get_sfp_info_from_part_no (char* part_no, char* rev, uint_t* wavelength, PLATFORM_MEDIA_INTERFACE_t* media_if);
 PLATFORM_MEDIA_INTERFACE_t pas_media_get_sfp_media_if_from_id (uint_t id);
 
 /* Funcitons to get connector, cable and string info from map, based on media interface and qualifier */
@@ -405,8 +495,47 @@ uint_t dn_pas_media_convert_speed_to_num (BASE_IF_SPEED_t speed);
 
 void dn_pas_phy_media_poll (uint_t port, bool publish);
 
+/* Start a cycle of polling all ports; renews real time data poll budget */
+
+void dn_pas_phy_media_poll_cycle_start (void);
+
+/* Request analog DOM values be read on next poll of given port */
+
+void dn_pas_phy_media_dom_demand (uint_t port);
+
 void dn_pas_phy_media_poll_all (void *arg);
 
+/*
+ * Run the next insertion pipeline stage for given port; returns true if
+ * more stages remain for the given presence change generation.
+ */
+
+bool dn_pas_phy_media_insert_stage_run (uint_t port, uint_t gen);
+
+/*
+ * Detect and identify media in given port at startup; returns true if
+ * media is present.
+ */
+
+bool dn_pas_phy_media_discover (uint_t port);
+
+/*
+ * Take saved identification for media present in given port at startup;
+ * see pas_media_ckpt.h.
+ */
+
+bool dn_pas_phy_media_adopt (uint_t port, const pas_media_t *saved,
+        const dn_pas_basic_media_info_t *info);
+
+/*
+ * Read the fingerprint of the media in given port, taken as media of given
+ * category; returns false if the category has no fingerprint, or the read
+ * fails.
+ */
+
+bool dn_pas_phy_media_fp_get (uint_t port, uint_t category,
+        pas_media_fp_t *fp);
+
 uint_t dn_phy_media_count_get (void);
 
 phy_media_tbl_t * dn_phy_media_entry_get(uint_t port);
@@ -502,6 +631,10 @@ bool dn_pas_media_phy_interface_mode_set (uint_t port, uint_t channel);
  */
 bool dn_pas_media_channel_serdes_control (uint_t port, uint_t channel);
 
+/* Check link status of all present copper SFPs, and update their serdes */
+
+void dn_pas_media_sfp_t_link_poll_all (void);
+
 /*
  * dn_pas_media_wavelength_set is to write the target wavelength in eeprom.
  */
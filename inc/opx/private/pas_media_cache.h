@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_media_cache.h
+ *
+ * Media identification cache
+ */
+
+#ifndef __PAS_MEDIA_CACHE_H
+#define __PAS_MEDIA_CACHE_H
+
+#include "std_type_defs.h"
+#include "private/pas_media.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Maximum entries per cache; a full cache is emptied */
+
+#define PAS_MEDIA_CACHE_MAX_ENTRIES  512
+
+/* Derived media info key: everything media properties derivation depends
+   on, other than fields fixed for a vendor part number and revision
+*/
+
+typedef struct {
+    char                vendor_id[SDI_MEDIA_MAX_VENDOR_OUI_LEN];
+    uint8_t             vendor_pn[SDI_MEDIA_MAX_VENDOR_PART_NUMBER_LEN];
+    char                vendor_rev[SDI_MEDIA_MAX_VENDOR_REVISION_LEN];
+    uint_t              category;
+    uint_t              port_type;
+    uint_t              type;
+    uint_t              qsa_adapter_type;
+    bool                qualified;
+    media_capability_t  capability;
+} pas_media_info_key_t;
+
+typedef struct {
+    uint64_t qual_hits;
+    uint64_t qual_misses;
+    uint_t   qual_entries;
+    uint64_t info_hits;
+    uint64_t info_misses;
+    uint_t   info_entries;
+} pas_media_cache_stats_t;
+
+/* Look up vendor plug-in type and qualification of given media, by vendor
+   OUI, PN, revision and serial number; returns true if found
+*/
+
+bool dn_pas_media_cache_qual_get(const pas_media_t *res_data,
+                                 PLATFORM_MEDIA_TYPE_t *type,
+                                 bool *qualified
+                                 );
+
+/* Save vendor plug-in type and qualification of given media */
+
+void dn_pas_media_cache_qual_put(const pas_media_t *res_data,
+                                 PLATFORM_MEDIA_TYPE_t type,
+                                 bool qualified
+                                 );
+
+/* Fill in derived media info key for given media; returns false if the
+   media cannot be cached (no vendor part number)
+*/
+
+bool dn_pas_media_cache_info_key(const phy_media_tbl_t *mtbl,
+                                 pas_media_info_key_t *key
+                                 );
+
+/* Look up derived media info for given key, and apply it to given media;
+   returns true if found
+*/
+
+bool dn_pas_media_cache_info_get(const pas_media_info_key_t *key,
+                                 phy_media_tbl_t *mtbl
+                                 );
+
+/* Save derived media info of given media, for given key */
+
+void dn_pas_media_cache_info_put(const pas_media_info_key_t *key,
+                                 const phy_media_tbl_t *mtbl
+                                 );
+
+void dn_pas_media_cache_stats_get(pas_media_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__PAS_MEDIA_CACHE_H) */
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_media_ckpt.h
+ *
+ * Media identification checkpoint, for warm restart
+ */
+
+#ifndef __PAS_MEDIA_CKPT_H
+#define __PAS_MEDIA_CKPT_H
+
+#include "std_type_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PAS_MEDIA_CKPT_FILENAME  "/run/opx-pas-media.ckpt"
+
+/* Adopt saved identification of media still present in the same ports,
+   and publish it; returns number of ports adopted
+*/
+
+uint_t dn_pas_media_ckpt_restore(void);
+
+/* Note that media identification changed => Checkpoint out of date */
+
+void dn_pas_media_ckpt_mark(void);
+
+/* Save checkpoint, if out of date */
+
+void dn_pas_media_ckpt_sync(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__PAS_MEDIA_CKPT_H) */
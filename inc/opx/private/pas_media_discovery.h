@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_media_discovery.h
+ *
+ * Startup media discovery
+ */
+
+#ifndef __PAS_MEDIA_DISCOVERY_H
+#define __PAS_MEDIA_DISCOVERY_H
+
+#include "std_type_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Detect and identify media in all pluggable ports, reading ports on
+   different I2C buses concurrently. Returns the number of ports with
+   media present.
+*/
+
+uint_t dn_pas_media_discovery_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__PAS_MEDIA_DISCOVERY_H) */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_media_insert.h
+ *
+ * Staged media insertion pipeline
+ */
+
+#ifndef __PAS_MEDIA_INSERT_H
+#define __PAS_MEDIA_INSERT_H
+
+#include "std_type_defs.h"
+#include "std_error_codes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returns true if insertion pipeline workers are running, i.e. media
+   insertions are to be queued rather than identified inline
+*/
+
+bool dn_pas_media_insert_async(void);
+
+/* Queue given port for insertion processing, for given presence change
+   generation
+*/
+
+void dn_pas_media_insert_enqueue(uint_t port, uint_t gen);
+
+/* Insertion pipeline thread; starts the configured number of workers */
+
+t_std_error dn_pas_media_insert_thread(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__PAS_MEDIA_INSERT_H) */
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_media_read_plan.h
+ *
+ * Page-aware media EEPROM read planner
+ */
+
+#ifndef __PAS_MEDIA_READ_PLAN_H
+#define __PAS_MEDIA_READ_PLAN_H
+
+#include "std_type_defs.h"
+#include "std_error_codes.h"
+#include "sdi_entity.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PAS_MEDIA_READ_PLAN_MAX_REQS   32   /* Reads per plan */
+#define PAS_MEDIA_READ_PLAN_MAX_XFER   128  /* Bytes per transaction, i.e.
+                                               one page */
+#define PAS_MEDIA_READ_PLAN_MERGE_GAP  16   /* Max bytes read, but not
+                                               requested, to merge two
+                                               reads into one transaction */
+#define PAS_MEDIA_READ_PLAN_LOWER_PAGE 0x100 /* Page of a lower memory read,
+                                                offsets 0 - 127; not a real
+                                                page number */
+
+/* One pending read; offsets of upper page reads are 128 - 255 */
+
+typedef struct {
+    uint8_t  bank;
+    uint16_t page;      /* Page, or PAS_MEDIA_READ_PLAN_LOWER_PAGE */
+    uint8_t  offset;
+    uint8_t  len;
+    uint8_t  *buf;
+    uint_t   seq;       /* Order of submission */
+} pas_media_read_req_t;
+
+typedef struct {
+    uint_t               count;
+    pas_media_read_req_t reqs[PAS_MEDIA_READ_PLAN_MAX_REQS];
+} pas_media_read_plan_t;
+
+/* Read plan counters. An upper page transaction needs a page select
+   write if the page differs from that of the last upper page transaction;
+   "saved" counts are relative to issuing each read in submission order,
+   as its own transaction, each upper page read with its own page select.
+*/
+
+typedef struct {
+    uint64_t runs;
+    uint64_t reqs;                  /* Reads requested */
+    uint64_t xfers;                 /* Transactions issued */
+    uint64_t xfers_saved;
+    uint64_t page_selects;          /* Page select writes issued */
+    uint64_t page_selects_saved;
+    uint_t   last_xfers;            /* As above, for last run */
+    uint_t   last_page_selects;
+    uint_t   last_page_selects_saved;
+} pas_media_read_plan_stats_t;
+
+void dn_pas_media_read_plan_init(pas_media_read_plan_t *plan);
+
+/* Add a read of given length, at given bank, page and offset, into given
+   buffer; returns false if the read is invalid or the plan is full
+*/
+
+bool dn_pas_media_read_plan_add(pas_media_read_plan_t *plan, uint_t bank,
+                                uint_t page, uint_t offset, uint_t len,
+                                uint8_t *buf
+                                );
+
+/* Issue all reads of given plan, to given media, sorted by bank, page and
+   offset, with adjacent reads merged; updates given counters
+*/
+
+t_std_error dn_pas_media_read_plan_run(pas_media_read_plan_t *plan,
+                                       sdi_resource_hdl_t res_hdl,
+                                       pas_media_read_plan_stats_t *stats
+                                       );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__PAS_MEDIA_READ_PLAN_H) */
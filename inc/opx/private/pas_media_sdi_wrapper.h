@@ -239,3 +239,14 @@ static inline t_std_error pas_sdi_media_feature_support_status_get (
 
     return ret;
 }
+
+static inline t_std_error pas_sdi_media_read_generic (
+        sdi_resource_hdl_t resource_hdl, sdi_media_eeprom_addr_t *addr,
+        uint8_t *data, size_t data_len)
+{
+    t_std_error   ret;
+
+    ret = sdi_media_read_generic(resource_hdl, addr, data, data_len);
+
+    return ret;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_media_seg.h
+ *
+ * Media I2C mux segments
+ */
+
+#ifndef __PAS_MEDIA_SEG_H
+#define __PAS_MEDIA_SEG_H
+
+#include "std_type_defs.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Media port polling counters of an I2C mux segment, i.e. of all ports
+   with the same I2C bus and mux segment, see pas_port_info_t
+*/
+
+typedef struct {
+    uint_t   i2c_bus;
+    uint_t   i2c_mux_seg;
+    uint_t   port_count;
+    uint64_t polls;             /* Port polls */
+    uint64_t mux_switches;      /* Port polls following a poll of another
+                                   segment on the same bus */
+    uint64_t poll_time_us;      /* Total port poll time, in us */
+    uint_t   max_poll_time_us;  /* Longest port poll time, in us */
+} pas_media_seg_stats_t;
+
+/* Group pluggable media ports by I2C mux segment, from configuration */
+
+bool dn_pas_media_seg_init(void);
+
+void dn_pas_media_seg_free(void);
+
+/* Sort given ports by I2C bus and mux segment, keeping the given order
+   of ports on the same segment
+*/
+
+void dn_pas_media_seg_order(uint_t *ports, uint_t count);
+
+/* Account a poll of given port; begin returns the start time, to be
+   passed to end
+*/
+
+uint64_t dn_pas_media_seg_poll_begin(uint_t port);
+
+void dn_pas_media_seg_poll_end(uint_t port, uint64_t start);
+
+/* Called at the end of each media poll cycle; publishes the counters of
+   each segment in the telemetry region, see dn_pas_telemetry.h
+*/
+
+void dn_pas_media_seg_cycle_end(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__PAS_MEDIA_SEG_H) */
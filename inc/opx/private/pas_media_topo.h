@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_media_topo.h
+ *
+ * Media port table topology: sub-port ids and SDI media resource handles
+ */
+
+#ifndef __PAS_MEDIA_TOPO_H
+#define __PAS_MEDIA_TOPO_H
+
+#include "std_type_defs.h"
+#include "private/pas_config.h"
+#include "private/pas_media.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Assign logical (sub) port ids of all ports of given media port table,
+   from configuration, in one pass
+*/
+
+void dn_pas_media_topo_sub_ports_assign(phy_media_tbl_t *tbl,
+                                        const struct pas_config_media *cfg
+                                        );
+
+/* Assign given SDI media resource handle to the first pluggable port of
+   given media port table without one, at or after *next_port, and advance
+   *next_port past it; SDI resources are enumerated in port order, so the
+   table is filled in one pass. Returns the port, or PAS_MEDIA_INVALID_PORT
+   if all pluggable ports have a handle.
+*/
+
+uint_t dn_pas_media_topo_hdl_assign(phy_media_tbl_t *tbl,
+                                    const struct pas_config_media *cfg,
+                                    sdi_resource_hdl_t hdl,
+                                    uint_t *next_port
+                                    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__PAS_MEDIA_TOPO_H) */
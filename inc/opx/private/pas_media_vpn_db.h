@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_media_vpn_db.h
+ *
+ * Media vendor part number database
+ */
+
+#ifndef __PAS_MEDIA_VPN_DB_H
+#define __PAS_MEDIA_VPN_DB_H
+
+#include "std_type_defs.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PAS_MEDIA_VPN_DB_FILENAME  "/etc/opx/pas/media-vpn.db"
+
+/* Database file layout, as written by opx_pas_vpn_db_compile.py; all
+   integers are little-endian
+*/
+
+#define PAS_MEDIA_VPN_DB_MAGIC     0x4244504e  /* "NPDB" */
+#define PAS_MEDIA_VPN_DB_VERSION   1
+
+/* Key field lengths, as in the SFF ID EEPROM */
+
+#define PAS_MEDIA_VPN_DB_PN_LEN    16
+#define PAS_MEDIA_VPN_DB_REV_LEN   4
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t rec_size;    /* sizeof(pas_media_vpn_rec_t) */
+    uint32_t count;       /* Number of records following */
+} pas_media_vpn_db_hdr_t;
+
+/* Record, sorted by vendor PN then revision, compared bytewise. Key fields
+   have trailing blanks removed and are NUL padded, not NUL terminated. An
+   empty revision matches media of any revision.
+*/
+
+typedef struct {
+    char     vendor_pn[PAS_MEDIA_VPN_DB_PN_LEN];
+    char     vendor_rev[PAS_MEDIA_VPN_DB_REV_LEN];
+    uint32_t wavelength;
+    uint32_t media_if;      /* PLATFORM_MEDIA_INTERFACE_t */
+    uint32_t media_type;    /* PLATFORM_MEDIA_TYPE_t */
+} pas_media_vpn_rec_t;
+
+/* Map given database file; if absent or invalid, only the built-in
+   entries are used
+*/
+
+void dn_pas_media_vpn_db_open(const char *filename);
+
+/* Look up given vendor PN and revision (revision may be NULL). A record
+   matches if its vendor PN is a prefix of the given one; the longest such
+   vendor PN wins, and for it, the given revision before any revision.
+   Entries in the database file take precedence over built-in ones.
+   Returns NULL if not found.
+*/
+
+const pas_media_vpn_rec_t *dn_pas_media_vpn_db_find(const char *vendor_pn,
+                                                    const char *vendor_rev
+                                                    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__PAS_MEDIA_VPN_DB_H) */
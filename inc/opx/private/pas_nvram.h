@@ -29,8 +29,15 @@
 #include "pas_res_structs.h"
 #include "std_llist.h"
 
+/* Number of buckets in the NVRAM tag hash index */
+#define PAS_NVRAM_TAG_HASH_SIZE     (64)
+
+/* Window over which NVRAM updates are coalesced before being written, in ms */
+#define PAS_NVRAM_FLUSH_WINDOW_MS   (500)
+
 typedef struct _pas_nvram_entry_t {
     std_dll     list_pointers;
+    struct _pas_nvram_entry_t *hash_next; /* Next entry in same tag hash bucket */
 
     uint64_t    tag;
     uint64_t    length;
@@ -54,9 +61,24 @@ pas_nvram_t *dn_pas_nvram_rec_get(void);
 /* Parse NVRAM data */
 void dn_nvram_parse(void);
 
-/* Write NVRAM to disk */
+/* Find the cached entry for the given tag, NULL if none */
+pas_nvram_entry_t *dn_nvram_entry_find(uint64_t tag);
+
+/* Add a new cached entry for the given tag */
+pas_nvram_entry_t *dn_nvram_entry_add(uint64_t tag, uint64_t length, uint8_t *data);
+
+/* Remove and free a cached entry */
+void dn_nvram_entry_del(pas_nvram_entry_t *entry);
+
+/* Mark the NVRAM cache as modified; the write is deferred to dn_nvram_flush() */
 void dn_nvram_write(void);
 
+/* Write pending NVRAM changes, if the coalescing window has elapsed or force is set */
+void dn_nvram_flush(bool force);
+
+/* Forget the last known NVRAM image, e.g. after a raw write bypassing the cache */
+void dn_nvram_shadow_invalidate(void);
+
 /* Initialize the NVRAM structure */
 void dn_nvram_init(void);
 
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_publish_policy.h
+ *
+ * Deadband and rate-limit policy for analog values in published events
+ */
+
+#ifndef __PAS_PUBLISH_POLICY_H
+#define __PAS_PUBLISH_POLICY_H
+
+#include "std_type_defs.h"
+#include "cps_api_object.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Apply the configured publish policy to an event object about to be
+   published. Analog attributes whose change is not significant, or which
+   were published too recently, are removed from the object. Returns
+   false if nothing significant remains, i.e. the event should not be
+   published.
+*/
+
+bool dn_pas_publish_policy_apply(cps_api_object_t obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined(__PAS_PUBLISH_POLICY_H) */
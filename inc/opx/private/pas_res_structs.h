@@ -131,6 +131,19 @@ typedef struct _pas_host_system_t {
 } pas_host_system_t;
 
 
+/*
+ * pas_actuator_t structure is to remember the last value successfully
+ * written to a hardware actuator (fan speed, LED state, external control),
+ * so that redundant writes can be suppressed.
+ */
+
+typedef struct _pas_actuator_t {
+    bool                   valid;       /* true <=> last_val is in hardware */
+    int                    last_val;    /* Last value written */
+    uint64_t               last_write;  /* Time of last write, in ms */
+    uint_t                 epoch;       /* Actuator epoch at time of write */
+} pas_actuator_t;
+
 /*
  * pas_extctrl_t structure is to hold ext_ctrl attributes and it
  * will be used to cache the data in data store for further access.
@@ -142,6 +155,12 @@ typedef struct _pas_extctrl_t {
     uint_t                 slot;
     uint_t                 entity_type;
     char                   name[PAS_NAME_LEN_MAX];
+    pas_actuator_t         act[1];      /* Last value written */
+    bool                   bound;       /* true <=> sensors[] resolved */
+    uint_t                 num_sensors; /* Number of sensors bound */
+    struct _pas_temperature_sensor_t
+                           *sensors[PAS_EXTCTRL_MAX_SSOR_IN_LIST];
+    uint_t                 weights[PAS_EXTCTRL_MAX_SSOR_IN_LIST];
 } pas_extctrl_t;
 
 typedef struct _pas_extctrl_group_t {
@@ -213,6 +232,7 @@ typedef struct _pas_entity_t {
     uint_t                       num_power_monitors;
     uint8_t                      reboot_type;    /* 1 for Cold reboot, 2 for Warm reboot */
     uint64_t                     polltime_from_epoch;
+    uint_t                       tlm_idx;  /* Telemetry record index + 1; 0 => none */
 } pas_entity_t;
 
 /*
@@ -299,6 +319,7 @@ typedef struct _pas_fan_t {
     pas_oper_fault_state_t oper_fault_state[1];
     uint_t                 fault_cnt;
     uint_t                 targ_speed, obs_speed;
+    pas_actuator_t         speed_act[1];     /* Last speed written */
     bool                   speed_control_en; /* Enable speed control */
     uint_t                 speed_err_margin; /* In % */
     struct {
@@ -307,6 +328,7 @@ typedef struct _pas_fan_t {
     bool                   speed_err;
     uint_t                 max_speed;
     uint64_t               polltime_from_epoch;
+    uint_t                 tlm_idx;  /* Telemetry record index + 1; 0 => none */
 } pas_fan_t;
 
 static inline const char *dn_pas_res_key_fan(
@@ -335,6 +357,7 @@ typedef struct _pas_power_monitor_t {
     float                  obs_pm_voltage_volt;
     float                  obs_pm_current_amp;
     float                  obs_pm_power_watt;
+    uint_t                 tlm_idx;          /* Telemetry record index + 1; 0 => none */
 } pas_power_monitor_t;
 
 /*
@@ -364,6 +387,7 @@ typedef struct _pas_led_t {
     char                   name[PAS_NAME_LEN_MAX];
     pas_oper_fault_state_t oper_fault_state[1];
     bool                   req_on, sdi_on_valid, sdi_on;
+    pas_actuator_t         act[1];           /* Last state written */
 } pas_led_t;
 
 static inline const char *dn_pas_res_key_led_idx(
@@ -467,6 +491,7 @@ typedef struct _pas_temperature_sensor_t {
         int  temperature;
     } last_thresh_crossed[1];
     uint64_t               polltime_from_epoch;
+    uint_t                 tlm_idx;  /* Telemetry record index + 1; 0 => none */
 } pas_temperature_sensor_t;
 
 static inline const char *dn_pas_res_key_temp_sensor_idx(
@@ -634,6 +659,7 @@ typedef struct _pas_media_t {
 
     float                        target_wavelength; /* user configured wavelength */
     uint64_t                     polltime_from_epoch;
+    uint_t                       tlm_idx;  /* Telemetry record index + 1; 0 => none */
 } pas_media_t;
 
 static inline const char *dn_pas_res_key_media(char   *buf,
@@ -669,6 +695,10 @@ typedef struct _pas_media_channel_t {
     bool                         tx_loss;
     bool                         tx_fault;
     bool                         tx_disable;
+    uint_t                       mon_status;  /* Last latched monitor flags */
+    double                       rtd_prev_rx_power;  /* Values at last adaptive */
+    double                       rtd_prev_tx_power;  /* RTD interval evaluation */
+    double                       rtd_prev_tx_bias_current;
     PLATFORM_MEDIA_STATUS_t      rx_power_state;
     PLATFORM_MEDIA_STATUS_t      tx_power_state;
     PLATFORM_MEDIA_STATUS_t      tx_bias_state;
@@ -682,6 +712,7 @@ typedef struct _pas_media_channel_t {
     uint_t                       supported_speed_count;
     BASE_IF_SPEED_t              supported_speed [MAX_SUPPORTED_SPEEDS];
     uint64_t                     polltime_from_epoch;
+    uint_t                       tlm_idx;  /* Telemetry record index + 1; 0 => none */
 } pas_media_channel_t;
 
 static inline const char *dn_pas_res_key_media_chan(char   *buf,
@@ -709,6 +740,14 @@ typedef struct _pas_nvram_t {
     uint_t                 nvram_size;       /* Maximum capacity of NVRAM */
     std_dll_head           nvram_data;       /* Linked list of NVRAM TLVs */
     uint_t                 tlv_size;         /* Maximum size of TLV data */
+
+    struct _pas_nvram_entry_t **tag_hash;    /* Tag hash index into nvram_data */
+
+    bool                   dirty;            /* Cache differs from NVRAM contents */
+    uint64_t               dirty_since;      /* Time of first unflushed change, in ms */
+    bool                   shadow_valid;     /* Shadow holds last image on NVRAM */
+    uint8_t                *shadow;          /* Last image written to/read from NVRAM */
+    uint_t                 shadow_len;       /* Valid bytes in shadow, incl. checksum */
 } pas_nvram_t;
 
 #endif  //__PAS_RES_STRUCTS_H
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_telemetry.h
+ *
+ * Writer side of the shared-memory telemetry region; see dn_pas_telemetry.h
+ * for the layout. All update functions must be called with pas_lock held.
+ */
+
+#ifndef __PAS_TELEMETRY_H
+#define __PAS_TELEMETRY_H
+
+#include "std_type_defs.h"
+#include "private/pas_res_structs.h"
+#include "private/pas_media_seg.h"
+#include "private/pas_media_read_plan.h"
+
+/* Create, or re-initialize, the shared-memory telemetry region */
+
+bool dn_pas_telemetry_init(void);
+
+/* Publish current readings of an entity */
+
+void dn_pas_telemetry_entity_update(pas_entity_t *rec);
+
+/* Publish current readings of a fan */
+
+void dn_pas_telemetry_fan_update(pas_fan_t *rec);
+
+/* Publish current readings of a temperature sensor */
+
+void dn_pas_telemetry_temp_sensor_update(pas_temperature_sensor_t *rec);
+
+/* Publish current readings of a power monitor */
+
+void dn_pas_telemetry_power_monitor_update(pas_power_monitor_t *rec);
+
+/* Publish current readings, and given EEPROM read plan counters, of a
+   media port
+*/
+
+void dn_pas_telemetry_media_update(uint_t port, pas_media_t *rec,
+                                   const pas_media_read_plan_stats_t *read_stats
+                                   );
+
+/* Publish current readings of a media channel */
+
+void dn_pas_telemetry_media_channel_update(uint_t port,
+                                           uint_t channel,
+                                           pas_media_channel_t *rec
+                                           );
+
+/* Publish polling counters of a media I2C mux segment; *tlm_idx caches
+   the record index, as in a resource's cache record
+*/
+
+void dn_pas_telemetry_media_seg_update(uint_t *tlm_idx,
+                                       const pas_media_seg_stats_t *stats
+                                       );
+
+#endif /* !defined(__PAS_TELEMETRY_H) */
@@ -50,8 +50,10 @@ void dn_cache_init_temp_sensor(
     void               *data
                        );
 
-/* Initialize remote (NPU) temp_sensor record in cache */
-void dn_cache_init_remote_temp_sensor(void);
+/* Initialize records in cache for configured remote temp_sensors of
+   given card
+*/
+void dn_cache_init_remote_temp_sensor(pas_entity_t *parent);
 
 /* Allocate a temperature sensor cache record */
 
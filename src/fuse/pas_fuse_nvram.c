@@ -23,6 +23,7 @@
 
 
 #include "private/pas_fuse_handlers.h"
+#include "private/pas_nvram.h"
 #define min(x,y) (((x)<=(y)) ? (x):(y))
 
 /*
@@ -128,6 +129,9 @@ int dn_pas_fuse_nvram_write(
                     return res;
                 }
 
+                /* Raw write bypasses the TLV cache; next flush must rewrite fully */
+                dn_nvram_shadow_invalidate();
+
                 res = write_size;
                 break;
             }
@@ -33,8 +33,11 @@
 #include "private/pas_data_store.h"
 #include "private/pas_comm_dev.h"
 #include "private/pas_job_queue.h"
+#include "private/pas_media_insert.h"
+#include "private/pas_actuator.h"
 
 #include "std_thread_tools.h"
+#include "private/pas_telemetry.h"
 #include "private/dn_pas.h"
 #include "std_mutex_lock.h"
 #include "dell-base-platform-common.h"
@@ -72,7 +75,10 @@ static t_pald_thread_list thread_main_functions [] = {
     { "pas_fuse_handler_thread", NULL, dn_pas_fuse_handler_thread },
 
     //pas job queue thread 
-    {"pas_queue_job_thread", pas_job_q_thread, NULL}
+    {"pas_queue_job_thread", pas_job_q_thread, NULL},
+
+    //pas media insertion pipeline thread
+    { "pas_media_insert_thread", dn_pas_media_insert_thread, NULL }
 };
 
 
@@ -352,6 +358,12 @@ bool dn_pald_diag_mode_get(void)
 
 void dn_pald_diag_mode_set(bool state)
 {
+    if (diag_mode && !state) {
+        /* Actuators may have been written in diag mode; re-sync hardware */
+
+        dn_pas_actuator_invalidate_all();
+    }
+
     diag_mode = state;
 }
 
@@ -437,6 +449,11 @@ static t_std_error dn_pald_init(int argc, char *argv[])
           break;
        }
 
+       /* Initialize shared-memory telemetry; local readers can still use CPS */
+
+       if (!dn_pas_telemetry_init()) {
+          PAS_ERR("Failed to initialize telemetry region");
+       }
 
        // read pas config file and put read data into internal data structure
        ret = dn_pas_config_file_handle();
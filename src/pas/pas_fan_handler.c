@@ -27,6 +27,7 @@
 #include "private/pas_fan.h"
 #include "private/pas_utils.h"
 #include "private/pas_config.h"
+#include "private/pas_actuator.h"
 #include "private/dn_pas.h"
 
 #include "std_error_codes.h"
@@ -319,7 +320,13 @@ static t_std_error dn_pas_fan_set1(
 
     if (speed_valid)  targ_speed = speed;
 
-    if (targ_speed == rec->targ_speed) return rc;
+    if (targ_speed == rec->targ_speed
+        && !dn_pas_actuator_write_needed(rec->speed_act, targ_speed)
+        ) {
+        /* Speed already in hardware */
+
+        return rc;
+    }
 
     if (dn_pas_timedlock() != STD_ERR_OK) {
         PAS_ERR("Not able to acquire the mutex (timeout)");
@@ -329,6 +336,7 @@ static t_std_error dn_pas_fan_set1(
     if(!dn_pald_diag_mode_get()) {
 
         rc = sdi_fan_speed_set(rec->sdi_resource_hdl, targ_speed);
+        dn_pas_actuator_write_done(rec->speed_act, targ_speed, !STD_IS_ERR(rc));
     }
 
     dn_pas_unlock();
@@ -27,6 +27,7 @@
 #include "private/pas_led.h"
 #include "private/pas_utils.h"
 #include "private/pas_config.h"
+#include "private/pas_actuator.h"
 #include "private/dn_pas.h"
 
 #include "cps_api_errors.h"
@@ -210,7 +211,8 @@ static t_std_error dn_pas_led_set1(
          ) {
         pas_led_t *grec;
         char      *gname;
-        bool      sdi_on;
+        bool      sdi_on, write_needed;
+        t_std_error rc;
 
         gname = dn_pas_config_led_group_iter_name(iter);
 
@@ -224,9 +226,14 @@ static t_std_error dn_pas_led_set1(
 
         sdi_on = on_foundf ? false : grec->req_on;
 
-        if (!grec->sdi_on_valid || grec->sdi_on != sdi_on) {
+        /* Only LEDs with no higher pri LED on are written to SDI */
 
-            /* New SDI state != current SDI state */
+        write_needed = !on_foundf
+            && dn_pas_actuator_write_needed(grec->act, sdi_on);
+
+        if (!grec->sdi_on_valid || grec->sdi_on != sdi_on || write_needed) {
+
+            /* New SDI state != current SDI state, or re-assert due */
             if (dn_pas_timedlock() != STD_ERR_OK) {
                 PAS_ERR("Not able to acquire the mutex (timeout)");
                 return (STD_ERR(PAS, FAIL, 0));
@@ -237,10 +244,11 @@ static t_std_error dn_pas_led_set1(
                 grec->sdi_on       = sdi_on; /* Update SDI state */
                 grec->sdi_on_valid = true;
 
-                if (!on_foundf) {
+                if (write_needed) {
                 /* Haven't higher pri LED on => Set state in SDI */
 
-                    (*(grec->sdi_on ? sdi_led_on : sdi_led_off))(grec->sdi_resource_hdl);
+                    rc = (*(grec->sdi_on ? sdi_led_on : sdi_led_off))(grec->sdi_resource_hdl);
+                    dn_pas_actuator_write_done(grec->act, grec->sdi_on, !STD_IS_ERR(rc));
                 }
             }
 
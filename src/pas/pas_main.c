@@ -26,6 +26,7 @@
 #include "private/pas_main.h"
 #include "private/pas_log.h"
 #include "private/pald.h"
+#include "private/pas_event_seq.h"
 
 
 /************************************************************************
@@ -51,6 +52,7 @@ cps_api_return_code_t dn_pas_read_function (void *context,
     uint_t           cat      = cps_api_key_get_cat(the_key);
     uint_t           sub_cat  = cps_api_key_get_subcat(the_key);
     t_std_error      ret = STD_ERR_OK;
+    size_t           list_start = cps_api_object_list_size(param->list);
 
     if (cat == cps_api_obj_CAT_BASE_PAS) {
       switch (sub_cat) {
@@ -147,6 +149,13 @@ cps_api_return_code_t dn_pas_read_function (void *context,
     else {
         PAS_WARN("Invalid category");
     }
+
+    if (ret == STD_ERR_OK) {
+        /* Apply "changes since" filter, and add sequence numbers */
+
+        dn_pas_event_seq_filter(param, key_ix, list_start);
+    }
+
     return ((ret == STD_ERR_OK) ? cps_api_ret_code_OK : cps_api_ret_code_ERR);
 }
 
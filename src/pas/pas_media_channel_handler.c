@@ -225,6 +225,11 @@ t_std_error dn_pas_media_channel_set(cps_api_transaction_params_t * param,
 
                             mtbl->channel_data[ch_start].tgt_state = status;
 
+                            if (status == true) {
+                                /* Resume full monitoring on next poll */
+                                dn_pas_phy_media_dom_demand(start);
+                            }
+
                             struct pas_config_media *cfg = dn_pas_config_media_get();
 
                             if ((cfg->lockdown == true)
@@ -82,6 +82,9 @@ t_std_error dn_pas_media_get(cps_api_get_params_t * param,
                    || (!mtbl->res_data->valid))
                 && !dn_pald_diag_mode_get()) {
             //featch from hard ware
+            if (qualifier == cps_api_qualifier_REALTIME) {
+                dn_pas_phy_media_dom_demand(start);
+            }
             dn_pas_phy_media_poll(start, true);
 
             if (!mtbl->res_data->valid) mtbl->res_data->valid = true;
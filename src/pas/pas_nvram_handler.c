@@ -112,20 +112,25 @@ t_std_error dn_pas_nvram_get(cps_api_get_params_t * param, size_t key_idx)
         return cps_api_ret_code_ERR;
     }
 
-    for (dll_entry = std_dll_getfirst(&nvram_rec->nvram_data); dll_entry;
-         dll_entry = std_dll_getnext(&nvram_rec->nvram_data, dll_entry)) {
-
-        entry = (pas_nvram_entry_t *)dll_entry;
-        if (tag_valid) {
-            if (tag == entry->tag) {
-                dn_pas_nvram_get1(param, qual, entry);
-                break;
-            }
-        } else {
+    if (dn_pas_timedlock() != STD_ERR_OK) {
+        PAS_ERR("Not able to acquire the mutex (timeout)");
+        return (STD_ERR(PAS, FAIL, 0));
+    }
+
+    if (tag_valid) {
+        if ((entry = dn_nvram_entry_find(tag)) != 0) {
             dn_pas_nvram_get1(param, qual, entry);
         }
+    } else {
+        for (dll_entry = std_dll_getfirst(&nvram_rec->nvram_data); dll_entry;
+             dll_entry = std_dll_getnext(&nvram_rec->nvram_data, dll_entry)) {
+
+            dn_pas_nvram_get1(param, qual, (pas_nvram_entry_t *)dll_entry);
+        }
     }
 
+    dn_pas_unlock();
+
     return (STD_ERR_OK);
 }
 
@@ -171,7 +176,7 @@ static t_std_error dn_pas_nvram_set1(
     if (!tag_valid)  return (STD_ERR(PAS, FAIL, 0));
 
     if (!data_valid) {
-        std_dll_remove(&rec->nvram_data, (std_dll *)entry);
+        dn_nvram_entry_del(entry);
     } else {
         /* Size limit the data to the maximum capacity for each entry */
         if (length > sizeof(entry->data)) {
@@ -192,7 +197,6 @@ t_std_error dn_pas_nvram_set(cps_api_transaction_params_t *param, cps_api_object
     cps_api_object_attr_t   a;
     pas_nvram_t             *nvram_rec;
     pas_nvram_entry_t       *entry;
-    std_dll                 *dll_entry;
     bool                    notif = false;
 
     if (cps_api_object_type_operation(cps_api_object_key(obj)) != cps_api_oper_SET) {
@@ -212,6 +216,10 @@ t_std_error dn_pas_nvram_set(cps_api_transaction_params_t *param, cps_api_object
     if ((data_valid = (a != CPS_API_ATTR_NULL))) {
         data = cps_api_object_attr_data_bin(a);
         length = cps_api_object_attr_len(a);
+        /* Size limit the data to the maximum capacity for each entry */
+        if (length > sizeof(((pas_nvram_entry_t *) 0)->data)) {
+            length = sizeof(((pas_nvram_entry_t *) 0)->data);
+        }
     } else {
         data = NULL;
         length = 0;
@@ -223,33 +231,21 @@ t_std_error dn_pas_nvram_set(cps_api_transaction_params_t *param, cps_api_object
         return cps_api_ret_code_ERR;
     }
 
-    entry = NULL;
-    for (dll_entry = std_dll_getfirst(&nvram_rec->nvram_data); dll_entry;
-         dll_entry = std_dll_getnext(&nvram_rec->nvram_data, dll_entry)) {
-
-        if (((pas_nvram_entry_t *)dll_entry)->tag == tag) {
-            entry = (pas_nvram_entry_t *)dll_entry;
-            break;
-        }
+    if (dn_pas_timedlock() != STD_ERR_OK) {
+        PAS_ERR("Not able to acquire the mutex (timeout)");
+        return (STD_ERR(PAS, FAIL, 0));
     }
 
+    entry = dn_nvram_entry_find(tag);
+
     if (!entry) {
         if (data_valid) {
             /* Allocate a new entry */
-            entry = calloc(1, sizeof(*entry));
-            if (!entry) {
+            if (dn_nvram_entry_add(tag, length, data) == 0) {
+                dn_pas_unlock();
                 return cps_api_ret_code_ERR;
             }
 
-            entry->tag = tag;
-            if (length > sizeof(entry->data)) {
-                length = sizeof(entry->data);
-            }
-            entry->length = length;
-            memcpy(entry->data, data, length);
-
-            std_dll_insertatback(&nvram_rec->nvram_data, (std_dll *)entry);
-
             notif = true;
         }
     } else {
@@ -258,8 +254,12 @@ t_std_error dn_pas_nvram_set(cps_api_transaction_params_t *param, cps_api_object
                       tag_valid, tag, length, data_valid, data) == STD_ERR_OK);
     }
 
-    /* Write NVRAM */
-    dn_nvram_write();
+    /* Schedule NVRAM write; sets arriving within the flush window
+       are written together
+    */
+    if (notif)  dn_nvram_write();
+
+    dn_pas_unlock();
 
     /* Send a notification */
     if (notif) {
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_actuator.c
+ *
+ * Write suppression for hardware actuators
+ */
+
+#include "private/pas_actuator.h"
+#include "private/pas_config.h"
+
+#include <time.h>
+
+/* Bumped to invalidate the last value written to every actuator */
+
+static uint_t actuator_epoch;
+
+/* Return monotonic time, in ms */
+
+static uint64_t dn_pas_actuator_now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+bool dn_pas_actuator_write_needed(pas_actuator_t *act, int val)
+{
+    uint_t reassert_interval = dn_pas_config_actuator_get()->reassert_interval;
+
+    if (!act->valid || act->epoch != actuator_epoch || act->last_val != val) {
+        return (true);
+    }
+
+    /* Same value as in hardware; re-assert it periodically, if so configured */
+
+    return (reassert_interval != 0
+            && dn_pas_actuator_now_ms() - act->last_write >= reassert_interval
+            );
+}
+
+void dn_pas_actuator_write_done(pas_actuator_t *act, int val, bool ok)
+{
+    if (!ok) {
+        act->valid = false;
+
+        return;
+    }
+
+    act->valid      = true;
+    act->last_val   = val;
+    act->last_write = dn_pas_actuator_now_ms();
+    act->epoch      = actuator_epoch;
+}
+
+void dn_pas_actuator_invalidate(pas_actuator_t *act)
+{
+    act->valid = false;
+}
+
+void dn_pas_actuator_invalidate_all(void)
+{
+    ++actuator_epoch;
+}
@@ -23,6 +23,7 @@
 #include "std_config_node.h"
 #include "dell-base-platform-common.h"
 #include "dell-base-pas.h"
+#include "dell-base-switch-element.h"
 #include "cps_class_map.h"
 
 #include <stdlib.h>
@@ -467,6 +468,241 @@ static void dn_pas_config_comm_dev (std_config_node_t nd)
     }
 }
 
+/*
+ * Default config for actuators
+ */
+static struct pas_config_actuator cfg_actuator[1] = {
+    { reassert_interval: PAS_ACTUATOR_REASSERT_INTERVAL_DFLT }
+};
+
+/* dn_pas_config_actuator_get to get actuator config information */
+
+struct pas_config_actuator *dn_pas_config_actuator_get(void)
+{
+    return (cfg_actuator);
+}
+
+/* dn_pas_config_actuator is to read and update actuator config from
+ * pas config file.
+ */
+
+static void dn_pas_config_actuator(std_config_node_t nd)
+{
+    char *a;
+
+    a = std_config_attr_get(nd, "reassert-interval");
+    if (a != 0) {
+        sscanf(a, "%u", &cfg_actuator->reassert_interval);
+    }
+}
+
+/*
+ * Default config for remote sensor poller
+ */
+static struct pas_config_remote_poller cfg_remote_poller[1] = {
+    { poll_interval: PAS_REMOTE_POLL_INTERVAL_DFLT,
+      timeout: PAS_REMOTE_POLL_TIMEOUT_DFLT,
+      subscribe: true
+    }
+};
+
+/* dn_pas_config_remote_poller_get to get remote poller config information */
+
+struct pas_config_remote_poller *dn_pas_config_remote_poller_get(void)
+{
+    return (cfg_remote_poller);
+}
+
+/* dn_pas_config_remote_poller is to read and update remote poller config
+ * from pas config file.
+ */
+
+static void dn_pas_config_remote_sensor(std_config_node_t nd)
+{
+    pas_config_remote_sensor *sensor;
+    char *a;
+
+    if (cfg_remote_poller->num_sensors >= PAS_REMOTE_SENSOR_MAX) {
+        PAS_ERR("Too many remote sensors configured");
+        return;
+    }
+
+    sensor = &cfg_remote_poller->sensors[cfg_remote_poller->num_sensors];
+    memset(sensor, 0, sizeof(*sensor));
+
+    sensor->slot          = 1;
+    sensor->poll_interval = cfg_remote_poller->poll_interval;
+
+    a = std_config_attr_get(nd, "name");
+    if (a == 0)  return;
+    STRLCPY(sensor->name, a);
+
+    a = std_config_attr_get(nd, "key");
+    if (a == 0)  return;
+    STRLCPY(sensor->key, a);
+
+    a = std_config_attr_get(nd, "attr");
+    if (a == 0)  return;
+    STRLCPY(sensor->attr, a);
+
+    a = std_config_attr_get(nd, "key-attr");
+    if (a != 0) {
+        STRLCPY(sensor->key_attr, a);
+    }
+
+    a = std_config_attr_get(nd, "key-val");
+    if (a != 0) {
+        sscanf(a, "%u", &sensor->key_val);
+    }
+
+    a = std_config_attr_get(nd, "slot");
+    if (a != 0) {
+        sscanf(a, "%u", &sensor->slot);
+    }
+
+    a = std_config_attr_get(nd, "poll-interval");
+    if (a != 0) {
+        sscanf(a, "%u", &sensor->poll_interval);
+    }
+
+    ++cfg_remote_poller->num_sensors;
+}
+
+/* Configure the NPU temperature sensor, read from NAS, as the only remote
+ * sensor; used when no remote sensors are configured
+ */
+
+static void dn_pas_config_remote_sensor_dflt(void)
+{
+    pas_config_remote_sensor *sensor = &cfg_remote_poller->sensors[0];
+
+    memset(sensor, 0, sizeof(*sensor));
+
+    STRLCPY(sensor->name, PAS_REMOTE_NPU_SENSOR_NAME);
+    sensor->slot          = 1;
+    sensor->poll_interval = cfg_remote_poller->poll_interval;
+    snprintf(sensor->key, sizeof(sensor->key), "%llu",
+             (unsigned long long) BASE_SWITCH_SWITCHING_ENTITIES_SWITCHING_ENTITY
+             );
+    snprintf(sensor->attr, sizeof(sensor->attr), "%llu",
+             (unsigned long long) BASE_SWITCH_SWITCHING_ENTITIES_SWITCHING_ENTITY_TEMPERATURE
+             );
+    snprintf(sensor->key_attr, sizeof(sensor->key_attr), "%llu",
+             (unsigned long long) BASE_SWITCH_SWITCHING_ENTITIES_SWITCHING_ENTITY_SWITCH_ID
+             );
+
+    cfg_remote_poller->num_sensors = 1;
+}
+
+static void dn_pas_config_remote_poller(std_config_node_t nd)
+{
+    std_config_node_t sd;
+    char *a;
+
+    a = std_config_attr_get(nd, "poll-interval");
+    if (a != 0) {
+        sscanf(a, "%u", &cfg_remote_poller->poll_interval);
+    }
+
+    a = std_config_attr_get(nd, "timeout");
+    if (a != 0) {
+        sscanf(a, "%u", &cfg_remote_poller->timeout);
+    }
+
+    a = std_config_attr_get(nd, "subscribe");
+    if (a != 0) {
+        cfg_remote_poller->subscribe = (strcmp(a, "enable") == 0);
+    }
+
+    cfg_remote_poller->num_sensors = 0;
+    for (sd = std_config_get_child(nd); sd != 0; sd = std_config_next_node(sd)) {
+        if (strcmp(std_config_name_get(sd), "remote-sensor") == 0) {
+            dn_pas_config_remote_sensor(sd);
+        }
+    }
+}
+
+/* Publish policy, per analog metric class; none configured by default */
+
+static struct pas_config_publish_policy cfg_publish_policy[PAS_METRIC_MAX];
+
+static const struct {
+    const char *name;
+    uint_t     metric;
+} publish_policy_metric_tbl[] = {
+    { "temperature",       PAS_METRIC_TEMPERATURE },
+    { "media-temperature", PAS_METRIC_MEDIA_TEMPERATURE },
+    { "media-voltage",     PAS_METRIC_MEDIA_VOLTAGE },
+    { "media-rx-power",    PAS_METRIC_MEDIA_RX_POWER },
+    { "media-tx-power",    PAS_METRIC_MEDIA_TX_POWER },
+    { "media-tx-bias",     PAS_METRIC_MEDIA_TX_BIAS }
+};
+
+struct pas_config_publish_policy *dn_pas_config_publish_policy_get(uint_t metric)
+{
+    return (metric < PAS_METRIC_MAX ? &cfg_publish_policy[metric] : 0);
+}
+
+/* Read publish policy for one metric class */
+
+static void dn_pas_config_publish_metric(std_config_node_t nd)
+{
+    struct pas_config_publish_policy *p = 0;
+    char *a;
+    uint_t i;
+
+    a = std_config_attr_get(nd, "class");
+    if (a == 0)  return;
+
+    for (i = 0; i < ARRAY_SIZE(publish_policy_metric_tbl); ++i) {
+        if (strcmp(a, publish_policy_metric_tbl[i].name) == 0) {
+            p = &cfg_publish_policy[publish_policy_metric_tbl[i].metric];
+
+            break;
+        }
+    }
+    if (p == 0) {
+        PAS_ERR("Unknown publish policy metric class %s", a);
+
+        return;
+    }
+
+    memset(p, 0, sizeof(*p));
+
+    a = std_config_attr_get(nd, "abs-deadband");
+    if (a != 0) {
+        sscanf(a, "%lf", &p->abs_deadband);
+    }
+
+    a = std_config_attr_get(nd, "rel-deadband");
+    if (a != 0) {
+        sscanf(a, "%lf", &p->rel_deadband);
+    }
+
+    a = std_config_attr_get(nd, "min-interval");
+    if (a != 0) {
+        sscanf(a, "%u", &p->min_interval);
+    }
+
+    a = std_config_attr_get(nd, "refresh-interval");
+    if (a != 0) {
+        sscanf(a, "%u", &p->refresh_interval);
+    }
+
+    p->valid = true;
+}
+
+static void dn_pas_config_publish_policy(std_config_node_t nd)
+{
+    std_config_node_t sd;
+
+    for (sd = std_config_get_child(nd); sd != 0; sd = std_config_next_node(sd)) {
+        if (strcmp(std_config_name_get(sd), "metric") == 0) {
+            dn_pas_config_publish_metric(sd);
+        }
+    }
+}
+
 static pas_config_extctrl cfg_extctrl;
 
 pas_config_extctrl* dn_pas_config_extctrl_get(void)
@@ -486,6 +722,13 @@ static inline bool dn_pas_extctrl_find_sensor (std_config_node_t sd, const char
                return false;
 
            STRLCPY(slist->sensor[slist->count].name, val_str);
+
+           slist->sensor[slist->count].weight = 1;
+           val_str = std_config_attr_get(sd, "weight");
+           if (val_str != 0) {
+               sscanf(val_str, "%u", &slist->sensor[slist->count].weight);
+           }
+
            slist->count++;
         }
     }
@@ -535,9 +778,20 @@ static void dn_pas_config_extctrl (std_config_node_t extctrl_cfg)
             if (val_str != 0) {
               if (strcmp(val_str, "avg") == 0) {
                 slist->type = PAS_SLIST_TYPE_AVG;
+              } else if (strcmp(val_str, "weighted") == 0) {
+                slist->type = PAS_SLIST_TYPE_WEIGHTED;
+              } else if (strcmp(val_str, "percentile") == 0) {
+                slist->type = PAS_SLIST_TYPE_PERCENTILE;
               }
             }
 
+            slist->percentile = PAS_EXTCTRL_PERCENTILE_DFLT;
+            val_str = std_config_attr_get(nd, "percentile");
+            if (val_str != 0) {
+              sscanf(val_str, "%u", &slist->percentile);
+              if (slist->percentile > 100)  slist->percentile = 100;
+            }
+
             sensor_cnt = 0;
             for (sd = std_config_get_child(nd); sd != 0; sd = std_config_next_node(sd)) {
                 cnm = std_config_name_get(sd);
@@ -571,7 +825,14 @@ static config_entry_t media_app_cfg_tbl [] = {{"media", dn_pas_media_read_app_co
 static struct pas_config_media cfg_media[1] = {
     { poll_interval: PAS_MEDIA_PORT_POLLING_DEFAULT, rtd_interval: 5, lockdown: false, led_control: false,
       identification_led_control: false, pluggable_media_count: 0, lr_restriction: false, media_count: 0,
-      media_type_config: NULL, port_info_tbl: NULL, port_count: 0}
+      media_type_config: NULL, port_info_tbl: NULL, port_count: 0,
+      dom_format: PAS_MEDIA_DOM_FORMAT_ATTRS, dom_flag_first: false,
+      dom_refresh_interval: PAS_MEDIA_DOM_REFRESH_DFLT, rtd_adaptive: false,
+      rtd_min_interval: 0, rtd_max_interval: PAS_MEDIA_RTD_MAX_INTERVAL_DFLT,
+      rtd_margin: PAS_MEDIA_RTD_MARGIN_DFLT, rtd_rate: PAS_MEDIA_RTD_RATE_DFLT,
+      rtd_budget: 0, admin_aware_polling: false, sfp_t_link_interval: 0,
+      insertion_workers: 0, discovery_workers: 0, warm_restart: false,
+      fingerprint_interval: 0}
 };
 
 /* Searches for the appropriate string to enum map*/
@@ -772,6 +1033,20 @@ static void dn_pas_config_ports_handler(std_config_node_t nd, void *var)
         current_node->node.poll_cycles_to_skip = ceilf(quotient);
         current_node->node.min_holding_time = holding_time;
 
+        a = std_config_attr_get(nd, "i2c-bus");
+        if (a != NULL) {
+            sscanf(a, "%u", &(current_node->node.i2c_bus));
+        } else {
+            current_node->node.i2c_bus = PAS_MEDIA_I2C_BUS_NONE;
+        }
+
+        a = std_config_attr_get(nd, "i2c-mux-segment");
+        if (a != NULL) {
+            sscanf(a, "%u", &(current_node->node.i2c_mux_seg));
+        } else {
+            current_node->node.i2c_mux_seg = PAS_MEDIA_I2C_SEG_NONE;
+        }
+
         /* This is an essential field. Code will not proceed if not present*/
         /* This section needs to run last */
         a = std_config_attr_get(nd, "port-range");
@@ -808,7 +1083,9 @@ void dn_pas_port_config(std_config_node_t nd)
             media_type:    PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN,
             speed:         BASE_IF_SPEED_0MBPS,
             present:       false,
-            port_density:  PAS_MEDIA_PORT_DENSITY_DEFAULT
+            port_density:  PAS_MEDIA_PORT_DENSITY_DEFAULT,
+            i2c_bus:       PAS_MEDIA_I2C_BUS_NONE,
+            i2c_mux_seg:   PAS_MEDIA_I2C_SEG_NONE
         },
         next: NULL
      };
@@ -882,6 +1159,91 @@ static void dn_pas_config_media(std_config_node_t nd)
         }
     }
 
+    a = std_config_attr_get(nd, "dom-format");
+    if (a != NULL) {
+        if (strcmp(a, "packed") == 0) {
+            cfg_media->dom_format = PAS_MEDIA_DOM_FORMAT_PACKED;
+        } else if (strcmp(a, "both") == 0) {
+            cfg_media->dom_format = PAS_MEDIA_DOM_FORMAT_BOTH;
+        }
+    }
+
+    a = std_config_attr_get(nd, "dom-mode");
+    if (a != NULL) {
+        cfg_media->dom_flag_first = (strcmp(a, "flag-first") == 0);
+    }
+
+    a = std_config_attr_get(nd, "dom-refresh-interval");
+    if (a != NULL) {
+        sscanf(a, "%u", &cfg_media->dom_refresh_interval);
+    }
+
+    a = std_config_attr_get(nd, "rtd-adaptive");
+    if (a != NULL) {
+        cfg_media->rtd_adaptive = (strcmp(a, "enable") == 0);
+    }
+
+    a = std_config_attr_get(nd, "rtd-min-interval");
+    if (a != NULL) {
+        sscanf(a, "%u", &cfg_media->rtd_min_interval);
+    }
+
+    a = std_config_attr_get(nd, "rtd-max-interval");
+    if (a != NULL) {
+        sscanf(a, "%u", &cfg_media->rtd_max_interval);
+    }
+
+    a = std_config_attr_get(nd, "rtd-margin");
+    if (a != NULL) {
+        sscanf(a, "%u", &cfg_media->rtd_margin);
+    }
+
+    a = std_config_attr_get(nd, "rtd-rate");
+    if (a != NULL) {
+        sscanf(a, "%u", &cfg_media->rtd_rate);
+    }
+
+    a = std_config_attr_get(nd, "rtd-budget");
+    if (a != NULL) {
+        sscanf(a, "%u", &cfg_media->rtd_budget);
+    }
+
+    a = std_config_attr_get(nd, "admin-aware-polling");
+    if (a != NULL) {
+        cfg_media->admin_aware_polling = (strcmp(a, "enable") == 0);
+    }
+
+    a = std_config_attr_get(nd, "sfp-t-link-interval");
+    if (a != NULL) {
+        sscanf(a, "%u", &cfg_media->sfp_t_link_interval);
+    }
+
+    a = std_config_attr_get(nd, "insertion-workers");
+    if (a != NULL) {
+        sscanf(a, "%u", &cfg_media->insertion_workers);
+        if (cfg_media->insertion_workers > PAS_MEDIA_INSERTION_WORKERS_MAX) {
+            cfg_media->insertion_workers = PAS_MEDIA_INSERTION_WORKERS_MAX;
+        }
+    }
+
+    a = std_config_attr_get(nd, "discovery-workers");
+    if (a != NULL) {
+        sscanf(a, "%u", &cfg_media->discovery_workers);
+        if (cfg_media->discovery_workers > PAS_MEDIA_DISCOVERY_WORKERS_MAX) {
+            cfg_media->discovery_workers = PAS_MEDIA_DISCOVERY_WORKERS_MAX;
+        }
+    }
+
+    a = std_config_attr_get(nd, "warm-restart");
+    if (a != NULL) {
+        cfg_media->warm_restart = (strcmp(a, "enable") == 0);
+    }
+
+    a = std_config_attr_get(nd, "fingerprint-interval");
+    if (a != NULL) {
+        sscanf(a, "%u", &cfg_media->fingerprint_interval);
+    }
+
     if (access(pas_media_app_cfg_filename, F_OK) == 0) {
         dn_pas_config_parse(pas_media_app_cfg_filename, NULL, media_app_cfg_tbl,
                 ARRAY_SIZE(media_app_cfg_tbl));
@@ -1372,6 +1734,9 @@ static config_entry_t element_tbl[] = {
     { "comm-dev", dn_pas_config_comm_dev},
     { "port-config",        dn_pas_port_config},
     { "extctrl-config", dn_pas_config_extctrl },
+    { "actuator",    dn_pas_config_actuator },
+    { "remote-poller", dn_pas_config_remote_poller },
+    { "publish-policy", dn_pas_config_publish_policy },
 };
 
 
@@ -1443,5 +1808,11 @@ bool dn_pas_config_init(
         /* Raise a warning that card type is not defined */
     }
 
+    if (cfg_remote_poller->num_sensors == 0) {
+        /* No remote sensors configured => Use NPU temperature sensor */
+
+        dn_pas_config_remote_sensor_dflt();
+    }
+
     return (result);
 }
@@ -20,6 +20,7 @@
  * @brief This file contains the API's for accessing the Data store
  **************************************************************************/
 #include <map>
+#include <mutex>
 #include <string>
 
 #include "private/pas_data_store.h"
@@ -35,6 +36,12 @@ typedef std::pair<pas_res_map_t::iterator,bool> pas_res_return_t;
 
 static pas_res_map_t res_map;
 
+/* Guards res_map; media resources are inserted by concurrent startup
+   discovery workers
+*/
+
+static std::mutex    res_map_mtx;
+
 enum {
     /* Offset to ignore qualifier (single digit plus period)
        in the printable-string of an OID.
@@ -53,6 +60,7 @@ enum {
 
 bool dn_pas_res_insertc (const char *key, void *p_res_obj)
 {
+    std::lock_guard<std::mutex> lck(res_map_mtx);
     pas_res_map_t::iterator it;
 
     it = res_map.find(key);
@@ -88,6 +96,7 @@ bool dn_pas_res_insertc (const char *key, void *p_res_obj)
 
 void *dn_pas_res_removec (const char *key)
 {
+    std::lock_guard<std::mutex> lck(res_map_mtx);
     pas_res_map_t::iterator it;
     void                    *p_res_obj;
 
@@ -115,6 +124,7 @@ void *dn_pas_res_removec (const char *key)
 
 void *dn_pas_res_getc (const char *key)
 {
+    std::lock_guard<std::mutex> lck(res_map_mtx);
     pas_res_map_t::iterator it = res_map.find(key);
     
     return (it == res_map.end() ? 0 : it->second);
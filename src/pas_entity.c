@@ -30,6 +30,7 @@
 #include "private/pas_data_store.h"
 #include "private/pas_event.h"
 #include "private/pas_utils.h"
+#include "private/pas_telemetry.h"
 #include "private/dn_pas.h"
 
 #include "std_type_defs.h"
@@ -264,7 +265,10 @@ static void dn_cache_init_entity_res(pas_entity_t *rec)
 
     if(rec->entity_type == PLATFORM_ENTITY_TYPE_CARD){
         /* Initialize NPU temperature sensor in the cache DB */
-        dn_cache_init_remote_temp_sensor();
+        dn_cache_init_remote_temp_sensor(rec);
+
+        /* All temperature sensors known => Bind extctrl sensor lists */
+        dn_cache_bind_extctrl(rec);
     }
 }
 
@@ -701,6 +705,8 @@ bool dn_entity_poll(pas_entity_t *rec, bool update_allf)
 
     rec->polltime_from_epoch = std_time_get_current_from_epoch_in_nanoseconds();
 
+    dn_pas_telemetry_entity_update(rec);
+
     return (true);
 }
 
@@ -16,6 +16,8 @@
 
 #include "private/pas_log.h"
 #include "private/pas_event.h"
+#include "private/pas_event_seq.h"
+#include "private/pas_publish_policy.h"
 
 #include "cps_api_key.h"
 #include "cps_api_operation.h"
@@ -57,6 +59,16 @@ bool dn_pas_cps_notify(cps_api_object_t obj)
 
     if (handle == 0) return (result);
 
+    if (!dn_pas_publish_policy_apply(obj)) {
+        /* Suppressed by publish policy */
+
+        cps_api_object_delete(obj);
+
+        return (true);
+    }
+
+    dn_pas_event_seq_stamp(obj);
+
     result = (cps_api_event_publish(handle, obj) == cps_api_ret_code_OK);
 
     cps_api_object_delete(obj);
@@ -78,6 +90,8 @@ bool dn_pas_cps_notify_qual(cps_api_object_t obj,cps_api_qualifier_t qual)
 
     if (handle == 0) return (result);
 
+    dn_pas_event_seq_stamp(obj);
+
     result = (cps_api_event_publish(handle, obj) == cps_api_ret_code_OK);
 
     cps_api_object_delete(obj);
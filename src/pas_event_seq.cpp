@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**************************************************************************
+ * @file pas_event_seq.cpp
+ *
+ * @brief Per-class event sequence numbers, and per-instance generations
+ *        for answering "changes since" queries
+ **************************************************************************/
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "private/pas_event_seq.h"
+#include "private/pas_log.h"
+#include "dn_pas_event_seq.h"
+
+#include "cps_api_key.h"
+#include "cps_api_object_key.h"
+#include "cps_class_map.h"
+#include "std_time_tools.h"
+#include "dell-base-pas.h"
+
+#include <stdio.h>
+#include <string.h>
+
+enum {
+    MAX_KEY_ATTRS = 4
+};
+
+/* Sequence numbers are reserved in blocks; the end of the reserved block
+   is saved, so that sequence numbers keep increasing across a PAS restart,
+   even if the clock is stepped back
+*/
+
+#define PAS_EVENT_SEQ_FILENAME  "/run/opx-pas-event-seq"
+
+static const uint64_t event_seq_reserve = 1 << 20;
+
+/* Instance key attributes of each PAS object class which publishes events.
+   Objects of other classes are tracked per class, i.e. a change to any
+   instance reports all instances as changed.
+*/
+
+static const struct event_seq_class {
+    uint_t            subcat;
+    cps_api_attr_id_t key_attrs[MAX_KEY_ATTRS];
+    size_t            num_key_attrs;
+} event_seq_class_tbl[] = {
+    { BASE_PAS_ENTITY_OBJ,
+      { BASE_PAS_ENTITY_ENTITY_TYPE, BASE_PAS_ENTITY_SLOT }, 2 },
+    { BASE_PAS_FAN_OBJ,
+      { BASE_PAS_FAN_ENTITY_TYPE, BASE_PAS_FAN_SLOT, BASE_PAS_FAN_FAN_INDEX }, 3 },
+    { BASE_PAS_TEMPERATURE_OBJ,
+      { BASE_PAS_TEMPERATURE_ENTITY_TYPE, BASE_PAS_TEMPERATURE_SLOT,
+        BASE_PAS_TEMPERATURE_NAME
+      }, 3 },
+    { BASE_PAS_MEDIA_OBJ,
+      { BASE_PAS_MEDIA_SLOT, BASE_PAS_MEDIA_PORT }, 2 },
+    { BASE_PAS_MEDIA_CHANNEL_OBJ,
+      { BASE_PAS_MEDIA_CHANNEL_SLOT, BASE_PAS_MEDIA_CHANNEL_PORT,
+        BASE_PAS_MEDIA_CHANNEL_CHANNEL
+      }, 3 },
+    { BASE_PAS_READY_OBJ,
+      { BASE_PAS_READY_SLOT }, 1 },
+};
+
+struct event_seq_cls {
+    uint64_t                        base;  /* Sequence number at startup */
+    uint64_t                        seq;   /* Last sequence number assigned */
+    std::map<std::string, uint64_t> gens;  /* Generation of each instance */
+};
+
+static std::mutex                           seq_lock;
+static std::map<uint_t, event_seq_cls>      seq_classes;
+static bool                                 seq_reserved_loaded;
+static uint64_t                             seq_reserved;  /* End of block */
+
+/* Read the saved end of the reserved block; 0 if none */
+
+static uint64_t dn_pas_event_seq_reserved_load(void)
+{
+    unsigned long long v = 0;
+    FILE               *fp;
+
+    if ((fp = fopen(PAS_EVENT_SEQ_FILENAME, "r")) == NULL)  return (0);
+
+    if (fscanf(fp, "%llu", &v) != 1)  v = 0;
+
+    fclose(fp);
+
+    return ((uint64_t) v);
+}
+
+/* Reserve a new block of sequence numbers, following given one, and save
+   the end of it
+*/
+
+static void dn_pas_event_seq_reserve(uint64_t seq)
+{
+    static const char tmp_filename[] = PAS_EVENT_SEQ_FILENAME ".tmp";
+    FILE              *fp;
+    bool              ok;
+
+    seq_reserved = seq + event_seq_reserve;
+
+    if ((fp = fopen(tmp_filename, "w")) == NULL) {
+        PAS_ERR("Failed to create event sequence file %s", tmp_filename);
+
+        return;
+    }
+
+    ok = (fprintf(fp, "%llu\n", (unsigned long long) seq_reserved) > 0);
+
+    if (fclose(fp) != 0)  ok = false;
+
+    if (!ok || rename(tmp_filename, PAS_EVENT_SEQ_FILENAME) != 0) {
+        PAS_ERR("Failed to write event sequence file %s",
+                PAS_EVENT_SEQ_FILENAME
+                );
+
+        remove(tmp_filename);
+    }
+}
+
+/* Return class data for given sub-category, creating it if necessary */
+
+static event_seq_cls &dn_pas_event_seq_cls(uint_t subcat)
+{
+    auto it = seq_classes.find(subcat);
+    if (it != seq_classes.end())  return (it->second);
+
+    if (!seq_reserved_loaded) {
+        seq_reserved        = dn_pas_event_seq_reserved_load();
+        seq_reserved_loaded = true;
+    }
+
+    /* Start from the time (in us), or past every sequence number reserved
+       before a restart, whichever is greater
+    */
+
+    event_seq_cls &c = seq_classes[subcat];
+
+    c.base = c.seq = std::max<uint64_t>(std_time_get_current_from_epoch_in_nanoseconds() / 1000,
+                                        seq_reserved
+                                        );
+
+    return (c);
+}
+
+/* Look up instance key attributes of given sub-category */
+
+static const struct event_seq_class *dn_pas_event_seq_class_find(uint_t subcat)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(event_seq_class_tbl) / sizeof(event_seq_class_tbl[0]); ++i) {
+        if (event_seq_class_tbl[i].subcat == subcat)  return (&event_seq_class_tbl[i]);
+    }
+
+    return (0);
+}
+
+/* Compose the instance identifier of an object, from its key attributes */
+
+static std::string dn_pas_event_seq_inst(cps_api_object_t obj, uint_t subcat)
+{
+    const struct event_seq_class *ec = dn_pas_event_seq_class_find(subcat);
+    std::string                  inst;
+    cps_api_object_attr_t        a;
+    const uint8_t                *p;
+    char                         buf[4];
+    size_t                       i, k, n;
+
+    if (ec == 0)  return (inst);
+
+    for (i = 0; i < ec->num_key_attrs; ++i) {
+        a = cps_api_get_key_data(obj, ec->key_attrs[i]);
+        if (a == CPS_API_ATTR_NULL)  a = cps_api_object_attr_get(obj, ec->key_attrs[i]);
+
+        inst += '/';
+        if (a == CPS_API_ATTR_NULL)  continue;
+
+        p = (const uint8_t *) cps_api_object_attr_data_bin(a);
+        n = cps_api_object_attr_len(a);
+        for (k = 0; k < n; ++k) {
+            snprintf(buf, sizeof(buf), "%02x", p[k]);
+            inst += buf;
+        }
+    }
+
+    return (inst);
+}
+
+bool dn_pas_event_inst_key(cps_api_object_t obj, char *buf, size_t size)
+{
+    uint_t      subcat = cps_api_key_get_subcat(cps_api_object_key(obj));
+    std::string inst   = std::to_string(subcat) + dn_pas_event_seq_inst(obj, subcat);
+
+    if (inst.size() >= size)  return (false);
+
+    memcpy(buf, inst.c_str(), inst.size() + 1);
+
+    return (true);
+}
+
+bool dn_pas_event_key_attr_is(cps_api_object_t obj, cps_api_attr_id_t attr)
+{
+    const struct event_seq_class *ec;
+    size_t                       i;
+
+    ec = dn_pas_event_seq_class_find(cps_api_key_get_subcat(cps_api_object_key(obj)));
+    if (ec == 0)  return (false);
+
+    for (i = 0; i < ec->num_key_attrs; ++i) {
+        if (ec->key_attrs[i] == attr)  return (true);
+    }
+
+    return (false);
+}
+
+uint64_t dn_pas_event_seq_stamp(cps_api_object_t obj)
+{
+    uint_t   subcat = cps_api_key_get_subcat(cps_api_object_key(obj));
+    uint64_t seq;
+
+    {
+        std::lock_guard<std::mutex> lg(seq_lock);
+
+        event_seq_cls &c = dn_pas_event_seq_cls(subcat);
+
+        seq = ++c.seq;
+        c.gens[dn_pas_event_seq_inst(obj, subcat)] = seq;
+
+        if (seq >= seq_reserved)  dn_pas_event_seq_reserve(seq);
+    }
+
+    cps_api_object_attr_delete(obj, DN_PAS_ATTR_EVENT_SEQ);
+    cps_api_object_attr_add_u64(obj, DN_PAS_ATTR_EVENT_SEQ, seq);
+
+    return (seq);
+}
+
+void dn_pas_event_seq_filter(cps_api_get_params_t *param,
+                             size_t               key_ix,
+                             size_t               list_start
+                             )
+{
+    cps_api_object_t      req_obj = cps_api_object_list_get(param->filters, key_ix);
+    cps_api_object_attr_t a;
+    cps_api_object_t      obj;
+    bool                  since_valid = false;
+    uint64_t              since = 0, gen;
+    size_t                i;
+
+    a = cps_api_object_attr_get(req_obj, DN_PAS_ATTR_CHANGES_SINCE);
+    if (a != CPS_API_ATTR_NULL) {
+        since_valid = true;
+        since       = cps_api_object_attr_data_u64(a);
+    }
+
+    std::lock_guard<std::mutex> lg(seq_lock);
+
+    for (i = list_start; i < cps_api_object_list_size(param->list); ) {
+        obj = cps_api_object_list_get(param->list, i);
+
+        uint_t        subcat = cps_api_key_get_subcat(cps_api_object_key(obj));
+        event_seq_cls &c     = dn_pas_event_seq_cls(subcat);
+
+        /* Instances not published since startup count as changed at startup */
+
+        auto it = c.gens.find(dn_pas_event_seq_inst(obj, subcat));
+        gen = (it == c.gens.end()) ? c.base : it->second;
+
+        if (since_valid && gen <= since) {
+            cps_api_object_list_remove(param->list, i);
+            cps_api_object_delete(obj);
+
+            continue;
+        }
+
+        cps_api_object_attr_add_u64(obj, DN_PAS_ATTR_EVENT_SEQ, gen);
+
+        ++i;
+    }
+}
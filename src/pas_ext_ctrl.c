@@ -17,6 +17,7 @@
 #include "private/pas_config.h"
 #include "private/pas_comm_dev.h"
 #include "private/pas_ext_ctrl.h"
+#include "private/pas_actuator.h"
 #include "private/pas_host_system.h"
 #include "private/pas_temp_sensor.h"
 #include "private/pas_entity.h"
@@ -201,79 +202,161 @@ bool dn_cache_del_extctrl(pas_entity_t *parent)
     return true;
 }
 
+/* Caller must hold pas_lock, and not be in diag mode */
+
 static bool dn_pas_extctrl_set_value (pas_extctrl_t *rec, char *ctrl_name, int temp)
 {
     int tmp_sz = 1;
-    bool rc = true;
 
     if (NULL == rec->sdi_extctrl_hdl) {
         return false;
     }
 
-    dn_pas_lock();
-    do {
-        if (dn_pald_diag_mode_get()) {
-            break;
-        }
+    /* Skip write if value already in hardware */
+    if (!dn_pas_actuator_write_needed(rec->act, temp)) {
+        return true;
+    }
 
-        if (STD_IS_ERR(sdi_ext_ctrl_set(rec->sdi_extctrl_hdl, &temp, tmp_sz))) {
-            PAS_ERR("ext control not set to %d for %s", temp, ctrl_name);
-            rc = false;
-            break;
-        }   
-    } while (0);
-    dn_pas_unlock();
+    if (STD_IS_ERR(sdi_ext_ctrl_set(rec->sdi_extctrl_hdl, &temp, tmp_sz))) {
+        PAS_ERR("ext control not set to %d for %s", temp, ctrl_name);
+        dn_pas_actuator_write_done(rec->act, temp, false);
 
-    return rc;
-}
+        return false;
+    }
 
+    dn_pas_actuator_write_done(rec->act, temp, true);
 
-bool dn_entity_extctrl_poll (pas_entity_t *card_rec, bool update_allf, bool *notif)
+    return true;
+}
+
+void dn_cache_bind_extctrl (pas_entity_t *parent)
 {
-    int ctrl_idx;
+    uint_t ctrl_idx, i;
     pas_extctrl_t *rec;
     pas_temperature_sensor_t *tmp_rec;
-    char *ctrl_name;
-    int temp, aggreg_temp, aggreg_cnt = 0;
     pas_config_extctrl *cfg_ctrl = dn_pas_config_extctrl_get();
-    uint_t type;
-  
-    for (ctrl_idx = 0; ctrl_idx < db_extctrl.num_ctrls; ctrl_idx++) {
-        rec = &db_extctrl.extctrls[ctrl_idx];
-        aggreg_temp = 0;
 
-        int i;
+    if (db_extctrl.extctrls == NULL) {
+        return;
+    }
+
+    for (ctrl_idx = 0; ctrl_idx < cfg_ctrl->slist_cnt; ctrl_idx++) {
         pas_extctrl_slist_config *slist = &cfg_ctrl->slist_config[ctrl_idx];
-        
-        type = slist->type;
-        aggreg_cnt = 0;
+
+        rec = &db_extctrl.extctrls[ctrl_idx];
+        rec->bound       = false;
+        rec->num_sensors = 0;
+
         for (i = 0; i < slist->count; i++) {
-            tmp_rec = dn_pas_temperature_rec_get_name(rec->entity_type,
-                                                      rec->slot,
-                                                      slist->sensor[i].name);      
-            if (tmp_rec) {
-                temp = tmp_rec->cur;
-                if (PAS_SLIST_TYPE_MAX == type) {
-                    aggreg_temp = ((aggreg_temp > temp)? aggreg_temp: temp);
-                } else { /* PAS_SLIST_TYPE_AVG */
-                    aggreg_temp += temp;
-                }
-                aggreg_cnt++;
-            } else {
+            tmp_rec = dn_pas_temperature_rec_get_name(parent->entity_type,
+                                                      parent->slot,
+                                                      slist->sensor[i].name);
+            if (tmp_rec == NULL) {
                 PAS_ERR("slist sensor %s not found", slist->sensor[i].name);
-                return false;
+                break;
             }
+
+            rec->sensors[rec->num_sensors] = tmp_rec;
+            rec->weights[rec->num_sensors] = slist->sensor[i].weight;
+            rec->num_sensors++;
         }
-      
-        if (aggreg_cnt && (PAS_SLIST_TYPE_AVG == type)) {
-            aggreg_temp /= aggreg_cnt;
+
+        rec->bound = (i == slist->count);
+    }
+}
+
+/* Return the given percentile (nearest rank) of n temperatures; sorts temps */
+
+static int dn_pas_extctrl_percentile (int *temps, uint_t n, uint_t percentile)
+{
+    uint_t i, j, rank;
+    int    t;
+
+    for (i = 1; i < n; i++) {
+        t = temps[i];
+        for (j = i; j > 0 && temps[j - 1] > t; j--) {
+            temps[j] = temps[j - 1];
         }
+        temps[j] = t;
+    }
+
+    rank = (percentile * n + 99) / 100;
 
-        ctrl_name = slist->extctrl;
-        if (false == dn_pas_extctrl_set_value(rec, ctrl_name, aggreg_temp)) {
-            return false;
+    return (temps[rank == 0 ? 0 : rank - 1]);
+}
+
+/* Compute the driving value of a sensor list, by the list's algorithm */
+
+static int dn_pas_extctrl_aggregate (pas_extctrl_slist_config *slist,
+                                     int *temps, uint_t *weights, uint_t n)
+{
+    int    aggreg_temp = 0;
+    uint_t i, weight_sum = 0;
+
+    if (n == 0)  return (0);
+
+    switch (slist->type) {
+    case PAS_SLIST_TYPE_AVG:
+        for (i = 0; i < n; i++)  aggreg_temp += temps[i];
+        return (aggreg_temp / (int) n);
+
+    case PAS_SLIST_TYPE_WEIGHTED:
+        for (i = 0; i < n; i++) {
+            aggreg_temp += temps[i] * (int) weights[i];
+            weight_sum  += weights[i];
+        }
+        return (weight_sum == 0 ? 0 : aggreg_temp / (int) weight_sum);
+
+    case PAS_SLIST_TYPE_PERCENTILE:
+        return (dn_pas_extctrl_percentile(temps, n, slist->percentile));
+
+    default: /* PAS_SLIST_TYPE_MAX */
+        aggreg_temp = temps[0];
+        for (i = 1; i < n; i++) {
+            if (temps[i] > aggreg_temp)  aggreg_temp = temps[i];
         }
+        return (aggreg_temp);
     }
+}
 
-    return true;
+/* Caller must hold pas_lock */
+
+bool dn_entity_extctrl_poll (pas_entity_t *card_rec, bool update_allf, bool *notif)
+{
+    uint_t ctrl_idx, i;
+    pas_extctrl_t *rec;
+    int temps[PAS_EXTCTRL_MAX_SSOR_IN_LIST];
+    pas_config_extctrl *cfg_ctrl = dn_pas_config_extctrl_get();
+    bool rc = true;
+
+    if (dn_pald_diag_mode_get()) {
+        return true;
+    }
+
+    for (ctrl_idx = 0; ctrl_idx < db_extctrl.num_ctrls; ctrl_idx++) {
+        pas_extctrl_slist_config *slist = &cfg_ctrl->slist_config[ctrl_idx];
+
+        rec = &db_extctrl.extctrls[ctrl_idx];
+        if (!rec->bound) {
+            rc = false;
+            continue;
+        }
+
+        for (i = 0; i < rec->num_sensors; i++) {
+            temps[i] = rec->sensors[i]->cur;
+        }
+
+        if (false == dn_pas_extctrl_set_value(rec, slist->extctrl,
+                                              dn_pas_extctrl_aggregate(slist,
+                                                                       temps,
+                                                                       rec->weights,
+                                                                       rec->num_sensors
+                                                                       )
+                                              )
+            ) {
+            rc = false;
+        }
+    }
+
+    return rc;
 }
@@ -20,7 +20,9 @@
 #include "private/pas_data_store.h"
 #include "private/pas_event.h"
 #include "private/pas_config.h"
+#include "private/pas_actuator.h"
 #include "private/pas_utils.h"
+#include "private/pas_telemetry.h"
 #include "private/dn_pas.h"
 
 #include "std_type_defs.h"
@@ -251,13 +253,17 @@ bool dn_fan_poll(
 
             /* Try to set proper speed */
 
-            if (rec->targ_speed != targ_speed) {
+            if (rec->targ_speed != targ_speed
+                || dn_pas_actuator_write_needed(rec->speed_act, targ_speed)
+                ) {
 
                 if (STD_IS_ERR(sdi_fan_speed_set(rec->sdi_resource_hdl,
                                                  targ_speed))) {
+                    dn_pas_actuator_write_done(rec->speed_act, targ_speed, false);
                     dn_pas_oper_fault_state_update(rec->oper_fault_state,
                                                    PLATFORM_FAULT_TYPE_ECOMM);
                 } else {
+                    dn_pas_actuator_write_done(rec->speed_act, targ_speed, true);
                     rec->targ_speed = targ_speed;
                 }
 
@@ -305,5 +311,7 @@ bool dn_fan_poll(
 
     rec->polltime_from_epoch = std_time_get_current_from_epoch_in_nanoseconds();
 
+    dn_pas_telemetry_fan_update(rec);
+
     return (true);
 }
@@ -21,6 +21,7 @@
 #include "private/pas_utils.h"
 #include "private/pas_data_store.h"
 #include "private/pas_config.h"
+#include "private/pas_actuator.h"
 #include "private/dn_pas.h"
 
 #include "std_type_defs.h"
@@ -98,7 +99,10 @@ void dn_cache_init_led(
     /* Set LED to default */
 
     struct pas_config_led *cfg = dn_pas_config_led_get(parent->entity_type, rec->name);
-    (*(cfg != 0 && cfg->deflt ? sdi_led_on : sdi_led_off))(sdi_resource_hdl);
+    bool on = (cfg != 0 && cfg->deflt);
+    t_std_error rc = (*(on ? sdi_led_on : sdi_led_off))(sdi_resource_hdl);
+
+    dn_pas_actuator_write_done(rec->act, on, !STD_IS_ERR(rc));
 }
 
 pas_led_t *dn_pas_led_rec_get_name(
@@ -28,13 +28,25 @@
 #include "private/dn_pas.h"
 #include "private/pas_event.h"
 #include "private/pas_utils.h"
+#include "private/pas_telemetry.h"
+#include "private/pas_media_insert.h"
+#include "private/pas_media_discovery.h"
+#include "private/pas_media_ckpt.h"
+#include "private/pas_media_vpn_db.h"
+#include "private/pas_media_cache.h"
+#include "private/pas_media_seg.h"
+#include "private/pas_media_topo.h"
 #include "dn_pas_media_vendor.h"
+#include "dn_pas_media_dom.h"
 #include "cps_api_operation.h"
 #include "cps_api_events.h"
 #include <stdlib.h>
 #include <unistd.h>
 #include <dlfcn.h>
 #include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdint.h>
 #include "std_time_tools.h"
 #include "std_time_tools.h"
 
@@ -60,6 +72,9 @@
 static phy_media_tbl_t *phy_media_tbl = NULL;
 static uint_t phy_media_count = 0;
 
+/* Serializes vendor media plug-in calls from concurrent discovery workers */
+static pthread_mutex_t media_vendor_lock = PTHREAD_MUTEX_INITIALIZER;
+
 
 /* Mapping of media Attribute and corresponding member of _pas_media_t struct
  * and struct member info
@@ -623,9 +638,10 @@ static bool dn_media_obj_publish (cps_api_object_t obj)
 static void dn_pas_media_resource_cb (sdi_resource_hdl_t hdl, void *user_data)
 {
     static uint_t count_pluggable_from_sdi = 0;
+    static uint_t next_port = PAS_MEDIA_START_PORT; /* Ports before are assigned */
     uint_t count_pluggable_from_config =
         dn_pas_config_media_get()->pluggable_media_count;
-    uint_t counter = PAS_MEDIA_START_PORT;
+    uint_t port = PAS_MEDIA_INVALID_PORT;
 
     STD_ASSERT(hdl != NULL);
 
@@ -633,17 +649,15 @@ static void dn_pas_media_resource_cb (sdi_resource_hdl_t hdl, void *user_data)
 
         STD_ASSERT(phy_media_tbl != NULL);
 
-        for (; counter <= phy_media_count; counter++)
-            if (dn_pas_is_port_pluggable(counter)
-                && (phy_media_tbl[counter].res_hdl == NULL)) {
-                    phy_media_tbl[counter].res_hdl = hdl;
-                count_pluggable_from_sdi++;
-                    break;
-            }
+        port = dn_pas_media_topo_hdl_assign(phy_media_tbl,
+                    dn_pas_config_media_get(), hdl, &next_port);
+        if (port != PAS_MEDIA_INVALID_PORT) {
+            count_pluggable_from_sdi++;
+        }
     }
 
     if ((count_pluggable_from_sdi != count_pluggable_from_config)
-       && (counter == phy_media_count) ) {
+       && (port == phy_media_count) ) {
         PAS_ERR("Disparity between pluggable media count from SDI: %u and config: %u",
             count_pluggable_from_sdi, count_pluggable_from_config);
     }
@@ -666,6 +680,9 @@ bool dn_pas_phy_media_init (void)
     }
     phy_media_count = cfg->port_count;
 
+    dn_pas_media_vpn_db_open(PAS_MEDIA_VPN_DB_FILENAME);
+    pas_media_vendor_load();
+
     /* Alloc +1 for easier indexing*/
     phy_media_tbl = calloc(phy_media_count + 1, sizeof(phy_media_tbl_t));
 
@@ -680,23 +697,18 @@ bool dn_pas_phy_media_init (void)
 
     ret = dn_media_data_store_init(phy_media_count);
 
-    return ret;
-}
-
-static void dn_pas_media_generate_sub_ports(struct pas_config_media* cfg_media)
-{
-    uint_t next_logical_port = PAS_MEDIA_START_PORT;
-    uint_t count             = PAS_MEDIA_START_PORT;
+    if (ret) {
+        dn_pas_media_seg_init();
+        dn_pas_media_ckpt_restore();
+    }
 
-    while (count <= cfg_media->port_count){
+    if (ret && (cfg->discovery_workers != 0)) {
+        dn_pas_media_discovery_run();
+    }
 
-        uint_t density = 0;
-        while (density < cfg_media->port_info_tbl[count]->port_density) {
+    dn_pas_media_ckpt_sync();
 
-            phy_media_tbl[count].sub_port_ids[density++] = next_logical_port++;
-        }
-        count++;
-    }
+    return ret;
 }
 
 /*
@@ -723,6 +735,8 @@ static bool dn_media_data_store_init (uint_t count)
 
     struct pas_config_media *cfg = dn_pas_config_media_get();
 
+    dn_pas_media_topo_sub_ports_assign(phy_media_tbl, cfg);
+
     for (cnt = PAS_MEDIA_START_PORT; cnt <= count; cnt++) {
 
         phy_media_tbl[cnt].res_data = ptr++;
@@ -747,8 +761,6 @@ static bool dn_media_data_store_init (uint_t count)
             continue;
         }
 
-        dn_pas_media_generate_sub_ports(cfg);
-
         if (dn_pas_media_generate_port_str(&phy_media_tbl[cnt]) ==  NULL) {
             PAS_ERR("Unable to generate port string");
         }
@@ -1105,6 +1117,23 @@ static void dn_pas_media_channel_res_free (uint_t slot, uint_t port)
     phy_media_tbl[port].channel_data = NULL;
 }
 
+/*
+ * dn_pas_media_absent_reset is to forget the media in the given port, as
+ * on removal.
+ */
+
+static void dn_pas_media_absent_reset (uint_t port, phy_media_tbl_t *mtbl)
+{
+    uint_t                   slot = PAS_MEDIA_MY_SLOT;
+
+    dn_pas_media_channel_res_free(slot, port);
+    memset(mtbl->res_data, 0, sizeof(*(mtbl->res_data)));
+    memset(&(mtbl->media_info), 0, sizeof(mtbl->media_info));
+    mtbl->res_data->type = PLATFORM_MEDIA_TYPE_AR_POPTICS_NOTPRESENT;
+    dn_pas_media_capability_poll(port, NULL);
+    mtbl->res_data->port_type = PLATFORM_PORT_TYPE_PLUGGABLE;
+}
+
 /* To poll the media presence flag, If there is any change in presence state
  * it populates the object with new value, so that caller can publish the
  * object
@@ -1114,7 +1143,6 @@ static bool dn_pas_media_presence_poll (uint_t port, cps_api_object_t obj)
 {
 
     phy_media_tbl_t          *mtbl = NULL;
-    uint_t                   slot = PAS_MEDIA_MY_SLOT;
     bool                     presence = false;
     bool                     new_presence = false;
 
@@ -1142,12 +1170,7 @@ static bool dn_pas_media_presence_poll (uint_t port, cps_api_object_t obj)
 
     if (mtbl->res_data->present != presence) {
         if (presence == false) {
-            dn_pas_media_channel_res_free(slot, port);
-            memset(mtbl->res_data, 0, sizeof(*(mtbl->res_data)));
-            memset(&(mtbl->media_info), 0, sizeof(mtbl->media_info));
-            mtbl->res_data->type = PLATFORM_MEDIA_TYPE_AR_POPTICS_NOTPRESENT;
-            dn_pas_media_capability_poll(port, NULL);
-            mtbl->res_data->port_type = PLATFORM_PORT_TYPE_PLUGGABLE;
+            dn_pas_media_absent_reset(port, mtbl);
         }
 
         sdi_media_module_init(mtbl->res_hdl, presence);
@@ -1254,6 +1277,68 @@ static bool dn_pas_media_transceiver_code_poll (uint_t port,
 }
 
 
+/*
+ * dn_pas_media_insert_hw_setup is to set up the media of the given type,
+ * present in the given port, on insertion: tunable wavelength, support
+ * in the port, TX forced low, high power mode and serdes.
+ */
+
+static void dn_pas_media_insert_hw_setup (uint_t port, phy_media_tbl_t *mtbl,
+        PLATFORM_MEDIA_TYPE_t type)
+{
+    bool                     supported = true, disable = false;
+    bool                     high_power_mode = true;
+
+    if ((type == PLATFORM_MEDIA_TYPE_SFPPLUS_10GBASE_ZR_TUNABLE)
+            && (mtbl->res_data->target_wavelength != 0)) {
+        dn_pas_media_wavelength_set(port);
+    }
+
+    /*
+     * LR media is supported in top row only. Need to disable LR media its
+     * plugged in bottom row.
+     */
+    if (dn_pas_is_media_type_supported_in_fp(port, type,
+                &disable, &high_power_mode, &supported) == false) {
+
+        if (supported == false) {
+            mtbl->res_data->support_status = PLATFORM_MEDIA_SUPPORT_STATUS_NOT_SUPPORTED_DISABLED;
+            dn_pas_media_transceiver_state_set(port, true);
+            PAS_NOTICE("Optics type (%u) is not supported in this paltform(port %u), Disabling media transceiver.", type, port);
+        } else if (disable == true) {
+            mtbl->res_data->support_status = PLATFORM_MEDIA_SUPPORT_STATUS_NOT_SUPPORTED_DISABLED;
+            dn_pas_media_transceiver_state_set(port, true);
+            PAS_NOTICE("High power optics (type:%u) is not supported in this port(%u), Disabling media transceiver.",
+                   type, port);
+        } else {
+            mtbl->res_data->support_status = PLATFORM_MEDIA_SUPPORT_STATUS_NOT_SUPPORTED;
+            PAS_NOTICE("High power optics (type:%u) is not supported in this port(%u), Media transceiver not disabled.",
+                   type, port);
+        }
+    }
+
+    /* Bring down all channels whenever media is seen. The xceiver state function argument is inverted */
+    if (!dn_pas_media_transceiver_state_set(port, true)) {
+        PAS_ERR("Unable to force tx state low for media on port %u", port);
+    }
+
+    dn_pas_media_high_power_mode_set(port,
+                (high_power_mode == false) ? false : true);
+
+    /* Bring down all channels whenever media is seen. The xceiver state function argument is inverted */
+    if (!dn_pas_media_transceiver_state_set(port, true)){
+        PAS_ERR("Unable to force tx state low for media on port %u", port);
+    }
+
+    /* Bring sfp t serdes down also */
+
+    if (mtbl->res_data->type == PLATFORM_MEDIA_TYPE_SFP_T) {
+        if (sdi_media_phy_serdes_control(mtbl->res_hdl, PAS_MEDIA_CH_START, SDI_MEDIA_DEFAULT, false) != STD_ERR_OK) {
+            PAS_ERR("Serdes control failed, port(%u), channel(%u), state(false)", port, PAS_MEDIA_CH_START);
+        }
+    }
+}
+
 /*
  * dn_pas_media_type_poll is to poll and get the mediatype.
  */
@@ -1262,8 +1347,6 @@ static bool dn_pas_media_type_poll (uint_t port, cps_api_object_t obj)
 {
     phy_media_tbl_t          *mtbl = NULL;
     PLATFORM_MEDIA_TYPE_t    type;
-    bool                     supported = true, disable = false;
-    bool                     high_power_mode = true;
     bool                     ret = true;
 
     mtbl = dn_phy_media_entry_get(port);
@@ -1329,54 +1412,7 @@ static bool dn_pas_media_type_poll (uint_t port, cps_api_object_t obj)
 
     mtbl->res_data->qsa_adapter_type = pas_media_get_qsa_adapter_type (mtbl);
 
-    if ((type == PLATFORM_MEDIA_TYPE_SFPPLUS_10GBASE_ZR_TUNABLE)
-            && (mtbl->res_data->target_wavelength != 0)) {
-        dn_pas_media_wavelength_set(port);
-    }
-
-    /*
-     * LR media is supported in top row only. Need to disable LR media its
-     * plugged in bottom row.
-     */
-    if (dn_pas_is_media_type_supported_in_fp(port, type,
-                &disable, &high_power_mode, &supported) == false) {
-
-        if (supported == false) {
-            mtbl->res_data->support_status = PLATFORM_MEDIA_SUPPORT_STATUS_NOT_SUPPORTED_DISABLED;
-            dn_pas_media_transceiver_state_set(port, true);
-            PAS_NOTICE("Optics type (%u) is not supported in this paltform(port %u), Disabling media transceiver.", type, port);
-        } else if (disable == true) {
-            mtbl->res_data->support_status = PLATFORM_MEDIA_SUPPORT_STATUS_NOT_SUPPORTED_DISABLED;
-            dn_pas_media_transceiver_state_set(port, true);
-            PAS_NOTICE("High power optics (type:%u) is not supported in this port(%u), Disabling media transceiver.",
-                   type, port);
-        } else {
-            mtbl->res_data->support_status = PLATFORM_MEDIA_SUPPORT_STATUS_NOT_SUPPORTED;
-            PAS_NOTICE("High power optics (type:%u) is not supported in this port(%u), Media transceiver not disabled.",
-                   type, port);
-        }
-    }
-
-    /* Bring down all channels whenever media is seen. The xceiver state function argument is inverted */
-    if (!dn_pas_media_transceiver_state_set(port, true)) {
-        PAS_ERR("Unable to force tx state low for media on port %u", port);
-    }
-
-    dn_pas_media_high_power_mode_set(port,
-                (high_power_mode == false) ? false : true);
-
-    /* Bring down all channels whenever media is seen. The xceiver state function argument is inverted */
-    if (!dn_pas_media_transceiver_state_set(port, true)){
-        PAS_ERR("Unable to force tx state low for media on port %u", port);
-    }
-
-    /* Bring sfp t serdes down also */
-
-    if (mtbl->res_data->type == PLATFORM_MEDIA_TYPE_SFP_T) {
-        if (sdi_media_phy_serdes_control(mtbl->res_hdl, PAS_MEDIA_CH_START, SDI_MEDIA_DEFAULT, false) != STD_ERR_OK) {
-            PAS_ERR("Serdes control failed, port(%u), channel(%u), state(false)", port, PAS_MEDIA_CH_START);
-        }
-    }
+    dn_pas_media_insert_hw_setup(port, mtbl, type);
 
     if (mtbl->res_data->type != type) {
         mtbl->res_data->type = type;
@@ -1506,18 +1542,267 @@ static bool dn_pas_media_wavelength_poll (uint_t port, cps_api_object_t obj)
     return true;
 }
 
-/* Look up a function in the vendor media plug-in */
+/* Vendor media plug-in function table; resolved once, at init */
+
+static dn_pas_media_vendor_ops_t media_vendor_ops = {
+    version: DN_PAS_MEDIA_VENDOR_OPS_VERSION, features: 0
+};
+
+uint_t pas_media_vendor_features(void)
+{
+    return (media_vendor_ops.features);
+}
+
+#define MEDIA_VENDOR_RESOLVE(_hdl, _fld, _nm) \
+    (media_vendor_ops._fld = (typeof(media_vendor_ops._fld)) dlsym((_hdl), # _nm))
 
-void *pas_media_vendor_func(const char *name)
+/* Load the vendor media plug-in, and resolve its function table */
+
+void pas_media_vendor_load(void)
 {
     static const char filename[] = "/usr/lib/libopx_pas_media_vendor.so";
-    static void       *dlhdl;
+    void              *dlhdl;
+    const dn_pas_media_vendor_ops_t *ops = 0;
+
+    if (access(filename, R_OK) != 0)  return;
+
+    dlhdl = dlopen(filename, RTLD_NOW);
+    if (dlhdl == 0) {
+        PAS_ERR("Failed to load media vendor plug-in, %s", dlerror());
+
+        return;
+    }
+
+    typeof(&dn_pas_media_vendor_ops_get) ops_get =
+        (typeof(ops_get)) dlsym(dlhdl, "dn_pas_media_vendor_ops_get");
+    if (ops_get != 0)  ops = (*ops_get)();
+
+    if (ops != 0) {
+        if (ops->version != DN_PAS_MEDIA_VENDOR_OPS_VERSION) {
+            PAS_ERR("Media vendor plug-in version %u not supported",
+                    ops->version
+                    );
+
+            return;
+        }
+
+        media_vendor_ops = *ops;
+    } else {
+        /* No function table => Look up individual functions */
+
+        media_vendor_ops.features = DN_PAS_MEDIA_VENDOR_FEAT_PROPRIETARY_INFO
+            | DN_PAS_MEDIA_VENDOR_FEAT_MEDIA_TYPE
+            | DN_PAS_MEDIA_VENDOR_FEAT_QUALIFIED
+            | DN_PAS_MEDIA_VENDOR_FEAT_PRODUCT_INFO
+            | DN_PAS_MEDIA_VENDOR_FEAT_IDENTIFY;
+
+        MEDIA_VENDOR_RESOLVE(dlhdl, get_info_from_proprietary_type,
+                             dn_pas_media_vendor_get_info_from_proprietary_type);
+        MEDIA_VENDOR_RESOLVE(dlhdl, get_media_type,
+                             dn_pas_media_vendor_get_media_type);
+        MEDIA_VENDOR_RESOLVE(dlhdl, is_qualified,
+                             dn_pas_media_vendor_is_qualified);
+        MEDIA_VENDOR_RESOLVE(dlhdl, product_info_get,
+                             dn_pas_media_vendor_product_info_get);
+        MEDIA_VENDOR_RESOLVE(dlhdl, identify,
+                             dn_pas_media_vendor_identify);
+    }
+
+    /* Feature only usable if function supplied */
+
+    if (media_vendor_ops.get_info_from_proprietary_type == 0) {
+        media_vendor_ops.features &= ~DN_PAS_MEDIA_VENDOR_FEAT_PROPRIETARY_INFO;
+    }
+    if (media_vendor_ops.get_media_type == 0) {
+        media_vendor_ops.features &= ~DN_PAS_MEDIA_VENDOR_FEAT_MEDIA_TYPE;
+    }
+    if (media_vendor_ops.is_qualified == 0) {
+        media_vendor_ops.features &= ~DN_PAS_MEDIA_VENDOR_FEAT_QUALIFIED;
+    }
+    if (media_vendor_ops.product_info_get == 0) {
+        media_vendor_ops.features &= ~DN_PAS_MEDIA_VENDOR_FEAT_PRODUCT_INFO;
+    }
+    if (media_vendor_ops.identify == 0) {
+        media_vendor_ops.features &= ~DN_PAS_MEDIA_VENDOR_FEAT_IDENTIFY;
+    }
+
+    PAS_NOTICE("Media vendor plug-in loaded, features 0x%x",
+               media_vendor_ops.features
+               );
+}
+
+/* Vendor media plug-in calls, each under media_vendor_lock */
+
+bool pas_media_vendor_proprietary_info_get(PLATFORM_MEDIA_TYPE_t type,
+        dn_pas_media_vendor_basic_media_info_t *prop_info,
+        bool *is_fake_enum, int *prop_len)
+{
+    bool ret;
+
+    pthread_mutex_lock(&media_vendor_lock);
+    ret = (*media_vendor_ops.get_info_from_proprietary_type)(type, prop_info,
+                                                             is_fake_enum,
+                                                             prop_len);
+    pthread_mutex_unlock(&media_vendor_lock);
+
+    return ret;
+}
+
+PLATFORM_MEDIA_TYPE_t pas_media_vendor_media_type_get(sdi_resource_hdl_t hdl,
+        bool *qualified)
+{
+    PLATFORM_MEDIA_TYPE_t type;
+
+    pthread_mutex_lock(&media_vendor_lock);
+    type = (*media_vendor_ops.get_media_type)(hdl, qualified);
+    pthread_mutex_unlock(&media_vendor_lock);
+
+    return type;
+}
+
+t_std_error pas_media_vendor_product_info_get(sdi_resource_hdl_t hdl,
+        uint8_t *buf)
+{
+    t_std_error ret;
+
+    pthread_mutex_lock(&media_vendor_lock);
+    ret = (*media_vendor_ops.product_info_get)(hdl, buf);
+    pthread_mutex_unlock(&media_vendor_lock);
+
+    return ret;
+}
+
+PLATFORM_MEDIA_TYPE_t pas_media_vendor_identify(sdi_resource_hdl_t hdl,
+        const uint8_t *eeprom, size_t eeprom_len, bool *qualified)
+{
+    PLATFORM_MEDIA_TYPE_t type;
+
+    pthread_mutex_lock(&media_vendor_lock);
+    type = (*media_vendor_ops.identify)(hdl, eeprom, eeprom_len, qualified);
+    pthread_mutex_unlock(&media_vendor_lock);
+
+    return type;
+}
+
+/*
+ * dn_pas_media_eeprom_img_get returns the ID EEPROM image of the media in
+ * the given port, read once per presence change.
+ */
+
+static const uint8_t *dn_pas_media_eeprom_img_get (phy_media_tbl_t *mtbl)
+{
+    sdi_media_eeprom_addr_t addr = {
+        device_addr: SDI_MEDIA_DEVICE_ADDR_AUTO,
+        page:        SDI_MEDIA_PAGE_SELECT_NOT_SUPPORTED,
+        offset:      0
+    };
+
+    if (!mtbl->eeprom_img_valid) {
+        if (pas_sdi_media_read_generic(mtbl->res_hdl, &addr, mtbl->eeprom_img,
+                                       sizeof(mtbl->eeprom_img)
+                                       ) != STD_ERR_OK) {
+            return (NULL);
+        }
+
+        mtbl->eeprom_img_valid = true;
+    }
+
+    return (mtbl->eeprom_img);
+}
+
+/*
+ * dn_pas_media_fp_read is to read the fingerprint of the media in the
+ * given port, of the given category, in one transaction (or from the ID
+ * EEPROM image, if already read). Returns false if the category has no
+ * fingerprint (e.g. CMIS media) or the read fails.
+ */
+
+static bool dn_pas_media_fp_read (phy_media_tbl_t *mtbl, uint_t category,
+        pas_media_fp_t *fp)
+{
+    uint8_t                 buf[PAS_MEDIA_FP_WINDOW_LEN];
+    const uint8_t           *win;
+    sdi_media_eeprom_addr_t addr = {
+        device_addr: SDI_MEDIA_DEVICE_ADDR_AUTO,
+        page:        SDI_MEDIA_PAGE_SELECT_NOT_SUPPORTED,
+        offset:      0
+    };
+
+    switch (category) {
+    case PLATFORM_MEDIA_CATEGORY_SFP:
+    case PLATFORM_MEDIA_CATEGORY_SFP_PLUS:
+    case PLATFORM_MEDIA_CATEGORY_SFP28:
+        break;
+
+    case PLATFORM_MEDIA_CATEGORY_QSFP:
+    case PLATFORM_MEDIA_CATEGORY_QSFP_PLUS:
+    case PLATFORM_MEDIA_CATEGORY_QSFP28:
+    case PLATFORM_MEDIA_CATEGORY_DEPOP_QSFP28:
+        addr.offset = 128;      /* Upper page 00h */
+        break;
+
+    default:
+        return (false);
+    }
+
+    if (mtbl->eeprom_img_valid) {
+        win = &mtbl->eeprom_img[addr.offset];
+    } else {
+        if (pas_sdi_media_read_generic(mtbl->res_hdl, &addr, buf, sizeof(buf))
+                != STD_ERR_OK) {
+            return (false);
+        }
+
+        win = buf;
+    }
 
-    if (dlhdl == 0 && access(filename, R_OK) == 0) {
-        dlhdl = dlopen(filename, RTLD_NOW);
-        if (dlhdl == 0)  PAS_ERR("Failed to load media vendor plug-in, %s", dlerror());
+    fp->identifier = win[PAS_MEDIA_FP_ID_OFS];
+    memcpy(fp->compliance, &win[PAS_MEDIA_FP_COMPLIANCE_OFS],
+           sizeof(fp->compliance)
+           );
+    fp->cc_base = win[PAS_MEDIA_FP_CC_BASE_OFS];
+    memcpy(fp->serial, &win[PAS_MEDIA_FP_SERIAL_OFS], sizeof(fp->serial));
+
+    return (true);
+}
+
+/*
+ * dn_pas_media_fp_save is to take the fingerprint and identity of the
+ * media just identified in the given port.
+ */
+
+static void dn_pas_media_fp_save (phy_media_tbl_t *mtbl)
+{
+    mtbl->fp_valid      = false;
+    mtbl->fp_poll_count = 0;
+
+    if (!dn_pas_media_fp_read(mtbl, mtbl->res_data->category, &mtbl->fp)) {
+        return;
+    }
+
+    if ((mtbl->fp_ident == NULL)
+            && ((mtbl->fp_ident = malloc(sizeof(*mtbl->fp_ident))) == NULL)) {
+        return;
     }
-    return (dlhdl == 0 ? 0 : dlsym(dlhdl, name));
+
+    mtbl->fp_ident->res_data   = *mtbl->res_data;
+    mtbl->fp_ident->media_info = mtbl->media_info;
+    mtbl->fp_valid             = true;
+}
+
+/*
+ * dn_pas_media_fp_match is to check whether the media in the given port
+ * is the one last identified, by fingerprint.
+ */
+
+static bool dn_pas_media_fp_match (phy_media_tbl_t *mtbl)
+{
+    pas_media_fp_t          fp;
+
+    return (mtbl->fp_valid
+            && dn_pas_media_fp_read(mtbl, mtbl->fp_ident->res_data.category,
+                                    &fp)
+            && (memcmp(&fp, &mtbl->fp, sizeof(fp)) == 0));
 }
 
 /*
@@ -1535,15 +1820,32 @@ static bool dn_pas_media_dq_poll (uint_t port, cps_api_object_t obj)
     mtbl = dn_phy_media_entry_get(port);
     STD_ASSERT(mtbl != NULL);
 
-    /* Call vendor media plug-in */
-    typeof(&dn_pas_media_vendor_get_media_type) func = PAS_MEDIA_VENDOR_FUNC(dn_pas_media_vendor_get_media_type);
-    if (func != 0 && (type = (*func)(mtbl->res_hdl, &qualified)) == PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN ) {
+    /* Call vendor media plug-in; identify from EEPROM image, if supported */
+    const uint8_t *img = NULL;
+    bool          called = true, cached = false;
+
+    if ((PAS_MEDIA_VENDOR_HAS(IDENTIFY) || PAS_MEDIA_VENDOR_HAS(MEDIA_TYPE))
+            && dn_pas_media_cache_qual_get(mtbl->res_data, &type, &qualified)) {
+        cached = true;
+    } else if (PAS_MEDIA_VENDOR_HAS(IDENTIFY)
+            && (img = dn_pas_media_eeprom_img_get(mtbl)) != NULL) {
+        type = pas_media_vendor_identify(mtbl->res_hdl, img,
+                                         sizeof(mtbl->eeprom_img),
+                                         &qualified);
+    } else if (PAS_MEDIA_VENDOR_HAS(MEDIA_TYPE)) {
+        type = pas_media_vendor_media_type_get(mtbl->res_hdl, &qualified);
+    } else {
+        called = false;
+    }
+    if (called && type == PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN ) {
         if (qualified){
             PAS_ERR("Failed to get media type of qualified media, port %u", port);
             return false;
         }
+        if (!cached)  dn_pas_media_cache_qual_put(mtbl->res_data, type, qualified);
         return true;
     }
+    if (called && !cached)  dn_pas_media_cache_qual_put(mtbl->res_data, type, qualified);
     mtbl->res_data->type = type;
 
     if(mtbl->res_data->qualified != qualified) {
@@ -1759,33 +2061,211 @@ static bool dn_pas_media_vendor_info_poll (uint_t port, cps_api_object_t obj)
 }
 
 /*
- * dn_pas_media_module_monitor_poll is to poll and get the real time
- * monitoring data of the media.
+ * dn_pas_media_vendor_key_poll is to read the vendor PN, revision and
+ * serial number of the media inserted in the specified port, ahead of
+ * identification; they are published with the rest of the vendor info.
  */
 
-static bool dn_pas_media_module_monitor_poll (uint_t port,
-        sdi_media_module_monitor_t type)
+static bool dn_pas_media_vendor_key_poll (uint_t port)
 {
     phy_media_tbl_t       *mtbl = NULL;
-    float                 value = 0;
-    bool                  ret = false;
+    bool                  ret = true;
 
     mtbl = dn_phy_media_entry_get(port);
     STD_ASSERT(mtbl != NULL);
 
-    if (((mtbl->res_data->category == PLATFORM_MEDIA_CATEGORY_SFP_PLUS)
-                || (mtbl->res_data->category ==  PLATFORM_MEDIA_CATEGORY_SFP))
-            && (mtbl->res_data->supported_feature.sfp_features.diag_mntr_support_status
-                == false)) return true;
+    dn_pas_media_vendor_info_get(mtbl->res_hdl, SDI_MEDIA_VENDOR_PN,
+            &mtbl->res_data->vendor_pn, SDI_MEDIA_MAX_VENDOR_PART_NUMBER_LEN,
+            NULL, BASE_PAS_MEDIA_VENDOR_PN, &ret);
 
-    if (pas_sdi_media_module_monitor_get(mtbl->res_hdl, type, &value)
-            != STD_ERR_OK) {
-        PAS_ERR("Failed to get media module monitor, port %u", port);
+    dn_pas_media_vendor_info_get(mtbl->res_hdl, SDI_MEDIA_VENDOR_REVISION,
+            &mtbl->res_data->vendor_rev, SDI_MEDIA_MAX_VENDOR_REVISION_LEN,
+            NULL, BASE_PAS_MEDIA_VENDOR_REV, &ret);
 
-        return false;
-    }
+    dn_pas_media_vendor_info_get(mtbl->res_hdl, SDI_MEDIA_VENDOR_SN,
+            &mtbl->res_data->serial_number,
+            SDI_MEDIA_MAX_VENDOR_SERIAL_NUMBER_LEN,
+            NULL, BASE_PAS_MEDIA_SERIAL_NUMBER, &ret);
 
-    if (type == SDI_MEDIA_TEMP) {
+    return ret;
+}
+
+/* CMIS memory map, for analog DOM: flat memory flag and module monitors
+   in lower memory, Tx bias scale in page 01h, module and lane thresholds
+   in page 02h, and lane monitors of lanes 1 - 8 in bank 0 page 11h;
+   monitor and threshold values are big-endian
+*/
+
+#define PAS_MEDIA_CMIS_FLAT_MEM_OFS     2
+#define PAS_MEDIA_CMIS_FLAT_MEM         0x80
+#define PAS_MEDIA_CMIS_MOD_MON_OFS      14      /* Temperature, then Vcc */
+#define PAS_MEDIA_CMIS_ADV_PAGE         0x01
+#define PAS_MEDIA_CMIS_BIAS_SCALE_OFS   160     /* Bits 4-3 */
+#define PAS_MEDIA_CMIS_LANE_MON_PAGE    0x11
+#define PAS_MEDIA_CMIS_TX_POWER_OFS     154
+#define PAS_MEDIA_CMIS_TX_BIAS_OFS      170
+#define PAS_MEDIA_CMIS_RX_POWER_OFS     186
+#define PAS_MEDIA_CMIS_MAX_LANES        8
+#define PAS_MEDIA_CMIS_THRESH_PAGE      0x02
+#define PAS_MEDIA_CMIS_THRESH_OFS       128     /* Temperature thresholds */
+#define PAS_MEDIA_CMIS_THRESH_LEN       72      /* Up to Rx power thresholds */
+
+#define PAS_MEDIA_CMIS_U16(_b)          ((uint16_t) (((_b)[0] << 8) | (_b)[1]))
+
+/* Convert CMIS optical power monitor value, in 0.1 uW, to dBm */
+
+static float dn_pas_media_cmis_power_dbm (uint16_t raw)
+{
+    if (raw == 0)  return SDI_SFP_ZERO_WATT_POWER_IN_DBM;
+
+    return (10 * log10(raw * 0.0001));
+}
+
+/*
+ * dn_pas_media_cmis_paged is to read the memory map info of CMIS media,
+ * once per insertion; returns true if the media memory is paged, i.e. has
+ * the threshold and lane monitor pages.
+ */
+
+static bool dn_pas_media_cmis_paged (phy_media_tbl_t *mtbl)
+{
+    pas_media_read_plan_t plan;
+    uint8_t               flat_mem = 0;
+
+    if (mtbl->res_data->category != PLATFORM_MEDIA_CATEGORY_QSFP_DD)  return false;
+
+    if (!mtbl->cmis_info_valid) {
+        dn_pas_media_read_plan_init(&plan);
+        dn_pas_media_read_plan_add(&plan, 0, PAS_MEDIA_READ_PLAN_LOWER_PAGE,
+                PAS_MEDIA_CMIS_FLAT_MEM_OFS, 1, &flat_mem);
+
+        if (dn_pas_media_read_plan_run(&plan, mtbl->res_hdl, &mtbl->read_stats)
+                != STD_ERR_OK) {
+            return false;
+        }
+
+        mtbl->cmis_paged      = ((flat_mem & PAS_MEDIA_CMIS_FLAT_MEM) == 0);
+        mtbl->cmis_bias_mult  = 0;
+        mtbl->cmis_info_valid = true;
+    }
+
+    return mtbl->cmis_paged;
+}
+
+/* Set CMIS Tx bias scale, from Tx bias scale byte read */
+
+static void dn_pas_media_cmis_bias_mult_set (phy_media_tbl_t *mtbl,
+        uint8_t bias_scale)
+{
+    /* 00b => x1, 01b => x2, 10b => x4 */
+
+    mtbl->cmis_bias_mult = 1 << ((bias_scale >> 3) & 0x3);
+    if (mtbl->cmis_bias_mult > 4)  mtbl->cmis_bias_mult = 1;
+}
+
+/*
+ * dn_pas_media_cmis_dom_read is to read the module and channel monitors
+ * of CMIS media in the given port, in one page-aware read plan, instead
+ * of a monitor read per value; returns false if they are to be read per
+ * value.
+ */
+
+static bool dn_pas_media_cmis_dom_read (uint_t port, phy_media_tbl_t *mtbl)
+{
+    pas_media_read_plan_t plan;
+    uint8_t               bias_scale = 0;
+    uint8_t               mod_mon[4];
+    uint8_t               rx_power[PAS_MEDIA_CMIS_MAX_LANES][2];
+    uint8_t               tx_power[PAS_MEDIA_CMIS_MAX_LANES][2];
+    uint8_t               tx_bias[PAS_MEDIA_CMIS_MAX_LANES][2];
+    pas_media_channel_t   *ch_data;
+    uint_t                channel, lanes;
+
+    /* Flat memory => No lane monitor page */
+
+    if (!dn_pas_media_cmis_paged(mtbl))  return false;
+
+    dn_pas_media_read_plan_init(&plan);
+
+    if (mtbl->cmis_bias_mult == 0) {
+        dn_pas_media_read_plan_add(&plan, 0, PAS_MEDIA_CMIS_ADV_PAGE,
+                PAS_MEDIA_CMIS_BIAS_SCALE_OFS, 1, &bias_scale);
+    }
+
+    /* Reads added in the order they used to be made, planned by page */
+
+    dn_pas_media_read_plan_add(&plan, 0, PAS_MEDIA_READ_PLAN_LOWER_PAGE,
+            PAS_MEDIA_CMIS_MOD_MON_OFS, sizeof(mod_mon), mod_mon);
+
+    lanes = (mtbl->channel_cnt < PAS_MEDIA_CMIS_MAX_LANES)
+        ? mtbl->channel_cnt : PAS_MEDIA_CMIS_MAX_LANES;
+
+    for (channel = PAS_MEDIA_CH_START; channel < lanes; channel++) {
+        dn_pas_media_read_plan_add(&plan, 0, PAS_MEDIA_CMIS_LANE_MON_PAGE,
+                PAS_MEDIA_CMIS_RX_POWER_OFS + 2 * channel, 2, rx_power[channel]);
+        dn_pas_media_read_plan_add(&plan, 0, PAS_MEDIA_CMIS_LANE_MON_PAGE,
+                PAS_MEDIA_CMIS_TX_POWER_OFS + 2 * channel, 2, tx_power[channel]);
+        dn_pas_media_read_plan_add(&plan, 0, PAS_MEDIA_CMIS_LANE_MON_PAGE,
+                PAS_MEDIA_CMIS_TX_BIAS_OFS + 2 * channel, 2, tx_bias[channel]);
+    }
+
+    if (dn_pas_media_read_plan_run(&plan, mtbl->res_hdl, &mtbl->read_stats)
+            != STD_ERR_OK) {
+        PAS_TRACE("Failed to read media DOM plan, port %u", port);
+
+        return false;
+    }
+
+    if (mtbl->cmis_bias_mult == 0) {
+        dn_pas_media_cmis_bias_mult_set(mtbl, bias_scale);
+    }
+
+    mtbl->res_data->current_temperature
+        = (int16_t) PAS_MEDIA_CMIS_U16(&mod_mon[0]) / 256.0;
+    mtbl->res_data->current_voltage = PAS_MEDIA_CMIS_U16(&mod_mon[2]) * 0.0001;
+
+    for (channel = PAS_MEDIA_CH_START; channel < lanes; channel++) {
+        ch_data = &mtbl->channel_data[channel];
+
+        ch_data->rx_power
+            = dn_pas_media_cmis_power_dbm(PAS_MEDIA_CMIS_U16(rx_power[channel]));
+        ch_data->tx_power
+            = dn_pas_media_cmis_power_dbm(PAS_MEDIA_CMIS_U16(tx_power[channel]));
+        ch_data->tx_bias_current
+            = PAS_MEDIA_CMIS_U16(tx_bias[channel]) * 0.002 * mtbl->cmis_bias_mult;
+    }
+
+    return true;
+}
+
+/*
+ * dn_pas_media_module_monitor_poll is to poll and get the real time
+ * monitoring data of the media.
+ */
+
+static bool dn_pas_media_module_monitor_poll (uint_t port,
+        sdi_media_module_monitor_t type)
+{
+    phy_media_tbl_t       *mtbl = NULL;
+    float                 value = 0;
+    bool                  ret = false;
+
+    mtbl = dn_phy_media_entry_get(port);
+    STD_ASSERT(mtbl != NULL);
+
+    if (((mtbl->res_data->category == PLATFORM_MEDIA_CATEGORY_SFP_PLUS)
+                || (mtbl->res_data->category ==  PLATFORM_MEDIA_CATEGORY_SFP))
+            && (mtbl->res_data->supported_feature.sfp_features.diag_mntr_support_status
+                == false)) return true;
+
+    if (pas_sdi_media_module_monitor_get(mtbl->res_hdl, type, &value)
+            != STD_ERR_OK) {
+        PAS_ERR("Failed to get media module monitor, port %u", port);
+
+        return false;
+    }
+
+    if (type == SDI_MEDIA_TEMP) {
 
         mtbl->res_data->current_temperature = value;
         ret = true;
@@ -2138,34 +2618,40 @@ static bool dn_pas_media_channel_rtd_poll(uint_t port, uint_t channel,
         ret = false;
     }
 
-    if (dn_pas_media_channel_monitor_poll(port, channel,
-                SDI_MEDIA_INTERNAL_RX_POWER_MONITOR) == false) {
-        PAS_ERR("Failed to poll media channel rx power, port %u channel %u",
-                port, channel
-                );
+    if (!mtbl->dom_analog_skip && !mtbl->dom_analog_read) {
+        if (dn_pas_media_channel_monitor_poll(port, channel,
+                    SDI_MEDIA_INTERNAL_RX_POWER_MONITOR) == false) {
+            PAS_ERR("Failed to poll media channel rx power, port %u channel %u",
+                    port, channel
+                    );
 
-        ret = false;
-    }
+            ret = false;
+        }
 
-    if (dn_pas_media_channel_monitor_poll(port, channel,
-                SDI_MEDIA_INTERNAL_TX_OUTPUT_POWER) == false) {
-        PAS_ERR("Failed to poll media channel tx power, port %u channel %u",
-                port, channel
-                );
+        if (dn_pas_media_channel_monitor_poll(port, channel,
+                    SDI_MEDIA_INTERNAL_TX_OUTPUT_POWER) == false) {
+            PAS_ERR("Failed to poll media channel tx power, port %u channel %u",
+                    port, channel
+                    );
 
-        ret = false;
-    }
+            ret = false;
+        }
 
-    if (dn_pas_media_channel_monitor_poll(port, channel,
-                SDI_MEDIA_INTERNAL_TX_POWER_BIAS) == false) {
-        PAS_ERR("Failed to poll media channel tx power bias, port %u channel %u",
-                port, channel
-                );
+        if (dn_pas_media_channel_monitor_poll(port, channel,
+                    SDI_MEDIA_INTERNAL_TX_POWER_BIAS) == false) {
+            PAS_ERR("Failed to poll media channel tx power bias, port %u channel %u",
+                    port, channel
+                    );
 
-        ret = false;
+            ret = false;
+        }
     }
 
-    if (dn_pas_media_channel_monitor_status_poll(port, channel, &mstatus)
+    if (mtbl->dom_flags_read) {
+        /* Already read this cycle, in flag-first mode */
+
+        mstatus = mtbl->channel_data[channel].mon_status;
+    } else if (dn_pas_media_channel_monitor_status_poll(port, channel, &mstatus)
             == false) {
         PAS_ERR("Failed to poll media channel monitor status, port %u channel %u",
                 port, channel
@@ -2303,23 +2789,35 @@ static bool dn_pas_media_rtd_poll(uint_t port, cps_api_object_t obj)
     mtbl = dn_phy_media_entry_get(port);
     STD_ASSERT(mtbl != NULL);
 
-    if (dn_pas_media_module_monitor_poll(port, SDI_MEDIA_TEMP) == false) {
-        PAS_ERR("Failed to poll media module temperature, port %u",
-                port
-                );
+    if (!mtbl->dom_analog_skip) {
+        /* CMIS => All monitors read at once, by read plan */
 
-        ret = false;
+        mtbl->dom_analog_read = dn_pas_media_cmis_dom_read(port, mtbl);
     }
 
-    if (dn_pas_media_module_monitor_poll(port, SDI_MEDIA_VOLT) == false) {
-        PAS_ERR("Failed to poll media module voltage, port %u",
-                port
-                );
+    if (!mtbl->dom_analog_skip && !mtbl->dom_analog_read) {
+        if (dn_pas_media_module_monitor_poll(port, SDI_MEDIA_TEMP) == false) {
+            PAS_ERR("Failed to poll media module temperature, port %u",
+                    port
+                    );
 
-        ret = false;
+            ret = false;
+        }
+
+        if (dn_pas_media_module_monitor_poll(port, SDI_MEDIA_VOLT) == false) {
+            PAS_ERR("Failed to poll media module voltage, port %u",
+                    port
+                    );
+
+            ret = false;
+        }
     }
 
-    if (dn_pas_media_module_monitor_status_poll(port, &status) == false) {
+    if (mtbl->dom_flags_read) {
+        /* Already read this cycle, in flag-first mode */
+
+        status = mtbl->dom_mon_status;
+    } else if (dn_pas_media_module_monitor_status_poll(port, &status) == false) {
         PAS_ERR("Failed to poll media module status, port %u",
                 port
                 );
@@ -2462,6 +2960,23 @@ static bool dn_pas_media_data_poll (uint_t port, cps_api_object_t obj)
  * dn_pas_media_threshold_attr_poll is to poll threshold attributes of media.
  */
 
+static void dn_pas_media_threshold_attr_set (double *memp, float value,
+        cps_api_object_t obj, BASE_PAS_MEDIA_t attr_id, bool *ret)
+{
+    if (*memp != value) {
+
+        *memp = value;
+
+        if (obj != NULL) {
+            if (cps_api_object_attr_add_u32(obj, attr_id, value) == false) {
+                PAS_ERR("Failed to add object attribute");
+
+                if (ret != NULL) *ret = false;
+            }
+        }
+    }
+}
+
 static void dn_pas_media_threshold_attr_poll (sdi_resource_hdl_t hdl,
         sdi_media_threshold_type_t type, double *memp, cps_api_object_t obj,
         BASE_PAS_MEDIA_t attr_id, bool *ret)
@@ -2481,18 +2996,133 @@ static void dn_pas_media_threshold_attr_poll (sdi_resource_hdl_t hdl,
         value = 0;
     }
 
-    if (*memp != value) {
+    dn_pas_media_threshold_attr_set(memp, value, obj, attr_id, ret);
+}
 
-        *memp = value;
+/* CMIS thresholds in page 02h, in the same units as the SDI thresholds;
+   each group is high alarm, low alarm, high warning, low warning
+*/
 
-        if (obj != NULL) {
-            if (cps_api_object_attr_add_u32(obj, attr_id, value) == false) {
-                PAS_ERR("Failed to add object attribute");
+typedef enum {
+    PAS_MEDIA_CMIS_THRESH_TEMP,         /* 1/256 deg C, signed */
+    PAS_MEDIA_CMIS_THRESH_VOLT,         /* 0.1 mV */
+    PAS_MEDIA_CMIS_THRESH_POWER,        /* 0.1 uW => dBm */
+    PAS_MEDIA_CMIS_THRESH_BIAS          /* 2 uA x Tx bias scale => mA */
+} pas_media_cmis_thresh_unit_t;
+
+static const struct {
+    uint_t                       ofs;
+    pas_media_cmis_thresh_unit_t unit;
+    size_t                       mem_ofs;   /* In pas_media_t */
+    BASE_PAS_MEDIA_t             attr_id;
+} media_cmis_thresh_tbl[] = {
+    {128, PAS_MEDIA_CMIS_THRESH_TEMP, offsetof(pas_media_t, temp_high_alarm),
+        BASE_PAS_MEDIA_TEMP_HIGH_ALARM_THRESHOLD},
+    {130, PAS_MEDIA_CMIS_THRESH_TEMP, offsetof(pas_media_t, temp_low_alarm),
+        BASE_PAS_MEDIA_TEMP_LOW_ALARM_THRESHOLD},
+    {132, PAS_MEDIA_CMIS_THRESH_TEMP, offsetof(pas_media_t, temp_high_warning),
+        BASE_PAS_MEDIA_TEMP_HIGH_WARNING_THRESHOLD},
+    {134, PAS_MEDIA_CMIS_THRESH_TEMP, offsetof(pas_media_t, temp_low_warning),
+        BASE_PAS_MEDIA_TEMP_LOW_WARNING_THRESHOLD},
+    {136, PAS_MEDIA_CMIS_THRESH_VOLT, offsetof(pas_media_t, voltage_high_alarm),
+        BASE_PAS_MEDIA_VOLTAGE_HIGH_ALARM_THRESHOLD},
+    {138, PAS_MEDIA_CMIS_THRESH_VOLT, offsetof(pas_media_t, voltage_low_alarm),
+        BASE_PAS_MEDIA_VOLTAGE_LOW_ALARM_THRESHOLD},
+    {140, PAS_MEDIA_CMIS_THRESH_VOLT, offsetof(pas_media_t, voltage_high_warning),
+        BASE_PAS_MEDIA_VOLTAGE_HIGH_WARNING_THRESHOLD},
+    {142, PAS_MEDIA_CMIS_THRESH_VOLT, offsetof(pas_media_t, voltage_low_warning),
+        BASE_PAS_MEDIA_VOLTAGE_LOW_WARNING_THRESHOLD},
+    {176, PAS_MEDIA_CMIS_THRESH_POWER, offsetof(pas_media_t, tx_power_high_alarm),
+        BASE_PAS_MEDIA_TX_POWER_HIGH_ALARM_THRESHOLD},
+    {178, PAS_MEDIA_CMIS_THRESH_POWER, offsetof(pas_media_t, tx_power_low_alarm),
+        BASE_PAS_MEDIA_TX_POWER_LOW_ALARM_THRESHOLD},
+    {180, PAS_MEDIA_CMIS_THRESH_POWER, offsetof(pas_media_t, tx_power_high_warning),
+        BASE_PAS_MEDIA_TX_POWER_HIGH_WARNING_THRESHOLD},
+    {182, PAS_MEDIA_CMIS_THRESH_POWER, offsetof(pas_media_t, tx_power_low_warning),
+        BASE_PAS_MEDIA_TX_POWER_LOW_WARNING_THRESHOLD},
+    {184, PAS_MEDIA_CMIS_THRESH_BIAS, offsetof(pas_media_t, bias_high_alarm),
+        BASE_PAS_MEDIA_BIAS_HIGH_ALARM_THRESHOLD},
+    {186, PAS_MEDIA_CMIS_THRESH_BIAS, offsetof(pas_media_t, bias_low_alarm),
+        BASE_PAS_MEDIA_BIAS_LOW_ALARM_THRESHOLD},
+    {188, PAS_MEDIA_CMIS_THRESH_BIAS, offsetof(pas_media_t, bias_high_warning),
+        BASE_PAS_MEDIA_BIAS_HIGH_WARNING_THRESHOLD},
+    {190, PAS_MEDIA_CMIS_THRESH_BIAS, offsetof(pas_media_t, bias_low_warning),
+        BASE_PAS_MEDIA_BIAS_LOW_WARNING_THRESHOLD},
+    {192, PAS_MEDIA_CMIS_THRESH_POWER, offsetof(pas_media_t, rx_power_high_alarm),
+        BASE_PAS_MEDIA_RX_POWER_HIGH_ALARM_THRESHOLD},
+    {194, PAS_MEDIA_CMIS_THRESH_POWER, offsetof(pas_media_t, rx_power_low_alarm),
+        BASE_PAS_MEDIA_RX_POWER_LOW_ALARM_THRESHOLD},
+    {196, PAS_MEDIA_CMIS_THRESH_POWER, offsetof(pas_media_t, rx_power_high_warning),
+        BASE_PAS_MEDIA_RX_POWER_HIGH_WARNING_THRESHOLD},
+    {198, PAS_MEDIA_CMIS_THRESH_POWER, offsetof(pas_media_t, rx_power_low_warning),
+        BASE_PAS_MEDIA_RX_POWER_LOW_WARNING_THRESHOLD}
+};
 
-                if (ret != NULL) *ret = false;
-            }
+/*
+ * dn_pas_media_cmis_threshold_read is to read the module and lane
+ * thresholds of paged CMIS media in the given port, in one page-aware
+ * read plan, instead of an SDI read per threshold; returns false if they
+ * are to be read per threshold.
+ */
+
+static bool dn_pas_media_cmis_threshold_read (uint_t port,
+        phy_media_tbl_t *mtbl, cps_api_object_t obj, bool *ret)
+{
+    pas_media_read_plan_t plan;
+    uint8_t               bias_scale = 0;
+    uint8_t               thresh[PAS_MEDIA_CMIS_THRESH_LEN];
+    const uint8_t         *raw;
+    float                 value;
+    uint_t                i;
+
+    if (!dn_pas_media_cmis_paged(mtbl))  return false;
+
+    dn_pas_media_read_plan_init(&plan);
+
+    if (mtbl->cmis_bias_mult == 0) {
+        dn_pas_media_read_plan_add(&plan, 0, PAS_MEDIA_CMIS_ADV_PAGE,
+                PAS_MEDIA_CMIS_BIAS_SCALE_OFS, 1, &bias_scale);
+    }
+
+    dn_pas_media_read_plan_add(&plan, 0, PAS_MEDIA_CMIS_THRESH_PAGE,
+            PAS_MEDIA_CMIS_THRESH_OFS, sizeof(thresh), thresh);
+
+    if (dn_pas_media_read_plan_run(&plan, mtbl->res_hdl, &mtbl->read_stats)
+            != STD_ERR_OK) {
+        PAS_TRACE("Failed to read media threshold plan, port %u", port);
+
+        return false;
+    }
+
+    if (mtbl->cmis_bias_mult == 0) {
+        dn_pas_media_cmis_bias_mult_set(mtbl, bias_scale);
+    }
+
+    for (i = 0; i < ARRAY_SIZE(media_cmis_thresh_tbl); i++) {
+        raw = &thresh[media_cmis_thresh_tbl[i].ofs - PAS_MEDIA_CMIS_THRESH_OFS];
+
+        switch (media_cmis_thresh_tbl[i].unit) {
+        case PAS_MEDIA_CMIS_THRESH_TEMP:
+            value = (int16_t) PAS_MEDIA_CMIS_U16(raw) / 256.0;
+            break;
+        case PAS_MEDIA_CMIS_THRESH_VOLT:
+            value = PAS_MEDIA_CMIS_U16(raw) * 0.0001;
+            break;
+        case PAS_MEDIA_CMIS_THRESH_POWER:
+            value = dn_pas_media_cmis_power_dbm(PAS_MEDIA_CMIS_U16(raw));
+            break;
+        default:
+            value = PAS_MEDIA_CMIS_U16(raw) * 0.002 * mtbl->cmis_bias_mult;
+            break;
         }
+
+        dn_pas_media_threshold_attr_set(
+                (double *) ((uint8_t *) mtbl->res_data
+                            + media_cmis_thresh_tbl[i].mem_ofs),
+                value, obj, media_cmis_thresh_tbl[i].attr_id, ret);
     }
+
+    return true;
 }
 
 /*
@@ -2520,6 +3150,8 @@ static bool dn_pas_media_threshold_poll (uint_t port, cps_api_object_t obj)
           && (mtbl->res_data->supported_feature.sfp_features.diag_mntr_support_status
             == false))) return true;
 
+    if (dn_pas_media_cmis_threshold_read(port, mtbl, obj, &ret))  return ret;
+
     dn_pas_media_threshold_attr_poll(mtbl->res_hdl,
             SDI_MEDIA_TEMP_HIGH_ALARM_THRESHOLD, &mtbl->res_data->temp_high_alarm,
             obj, BASE_PAS_MEDIA_TEMP_HIGH_ALARM_THRESHOLD, &ret);
@@ -2754,8 +3386,9 @@ static bool dn_pas_media_product_info_poll (uint_t port, cps_api_object_t obj)
 
     typeof(mtbl->res_data->vendor_specific) buf;
 
-    typeof(&dn_pas_media_vendor_product_info_get) func = PAS_MEDIA_VENDOR_FUNC(dn_pas_media_vendor_product_info_get);
-    if (func != 0 && (*func)(mtbl->res_hdl, buf) != STD_ERR_OK) {
+    if (PAS_MEDIA_VENDOR_HAS(PRODUCT_INFO)
+            && pas_media_vendor_product_info_get(mtbl->res_hdl, buf)
+                   != STD_ERR_OK) {
         PAS_ERR("Failed to get media vendor product info, port %u",
                 port
                 );
@@ -2980,149 +3613,362 @@ static bool dn_pas_media_add_capabilities_to_obj(media_capability_t *cap,
 
 
 /*
- * dn_pas_media_oir_poll is to poll the basic information of the media,
- * to publish on media presence detection.
+ * dn_pas_media_insert_stage is to run one stage of media identification
+ * on insertion; see pas_media_insert_stage_t.
  */
 
-static bool dn_pas_media_oir_poll (uint_t port, cps_api_object_t obj)
+static bool dn_pas_media_insert_stage (uint_t port, uint_t stage,
+        cps_api_object_t obj)
 {
     bool                 ret = true;
-    bool                 presence;
     phy_media_tbl_t      *mtbl = NULL;
 
 
     mtbl = dn_phy_media_entry_get(port);
     STD_ASSERT(mtbl != NULL);
 
-    presence = dn_pas_phy_media_is_present(port);
+    switch (stage) {
+    case PAS_MEDIA_INSERT_CATEGORY:
+        if (dn_pas_media_category_poll(port, obj) == false) {
+            PAS_ERR("Failed to poll media category, port %u",
+                    port
+                    );
 
-    if (dn_pas_media_presence_poll(port, obj) == false) {
-        PAS_ERR("Failed to get media module presence, port %u",
-                port
-                );
+            ret = false;
+        } else {
+            if (mtbl->res_data->supported_feature_valid == false) {
+                if (pas_sdi_media_feature_support_status_get(
+                            mtbl->res_hdl, &mtbl->res_data->supported_feature)
+                        != STD_ERR_OK) {
+                    ret = false;
+                } else {
 
-        return false;
-    }
-    bool cur_presence = dn_pas_phy_media_is_present(port);
+                    mtbl->res_data->supported_feature_valid = true;
 
-    if ((cur_presence == true)
-            && (mtbl->res_data->type == PLATFORM_MEDIA_TYPE_SFP_T)) {
+                    if ((mtbl->res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP)
+                            || (mtbl->res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP28)
+                            || (mtbl->res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP_DD)
+                            || (mtbl->res_data->category
+                                == PLATFORM_MEDIA_CATEGORY_QSFP_PLUS)) {
 
-        if (cur_presence != presence) {
-            mtbl->channel_data[PAS_MEDIA_CH_START].is_link_status_valid = false;
+                        mtbl->res_data->rate_select_state =
+                            mtbl->res_data->supported_feature.qsfp_features.rate_select_status;
+                    } else {
+
+                        mtbl->res_data->rate_select_state =
+                            mtbl->res_data->supported_feature.sfp_features.rate_select_status;
+                    }
+                }
+            }
         }
-        dn_pas_media_channel_serdes_control(port, PAS_MEDIA_CH_START);
-    }
+        break;
 
-    if (presence == cur_presence) {
-        return ret;
+    case PAS_MEDIA_INSERT_IDENT:
+        /* Vendor OUI, PN, revision and serial first => Media cache keys */
+
+        if (dn_pas_media_vendor_oui_poll(port, obj) == false) {
+            PAS_ERR("Failed to poll media vendor OUI, port %u",
+                    port
+                    );
+
+            ret = false;
+        }
+
+        if (dn_pas_media_vendor_key_poll(port) == false) {
+            PAS_ERR("Failed to poll media vendor PN, port %u",
+                    port
+                    );
+
+            ret = false;
+        }
+
+        if (dn_pas_media_dq_poll(port, obj) == false) {
+
+            ret = false;
+        }
+
+        if (dn_pas_media_wavelength_poll(port, obj) == false) {
+            PAS_ERR("Failed to poll media wavelength, port %u",
+                    port
+                    );
+
+            ret = false;
+        }
+
+        if (dn_pas_media_type_poll(port, obj) == false) {
+            PAS_ERR("Failed to poll media type, port %u",
+                    port
+                    );
+
+            ret = false;
+        }
+
+        PAS_NOTICE("Optic inserted in front panel port (%d), qualified: %s.",
+                port, (mtbl->res_data->qualified == true) ?
+                "Yes" : "No");
+        break;
+
+    case PAS_MEDIA_INSERT_CAPABILITY:
+        if (dn_pas_media_capability_poll(port, obj) == false) {
+            PAS_ERR("Failed to poll media capability, port %u",
+                    port
+                    );
+
+            ret = false;
+        }
+
+        if (dn_pas_media_vendor_name_poll(port, obj) == false) {
+            PAS_ERR("Failed to poll media vendor name, port %u",
+                    port
+                    );
+
+            ret = false;
+        }
+
+        if (dn_pas_media_default_capability_poll(port, obj) == false) {
+            PAS_ERR("Failed to poll media breakout info, port %u",
+                    port
+                    );
+
+            ret = false;
+        }
+        pas_media_get_media_properties(mtbl);
+
+
+        /* Bring sfp t serdes down also */
+
+        if (dn_pas_is_phy_ctrl_supported(mtbl) != PHY_CTRL_NO_SUPP) {
+            if (sdi_media_phy_serdes_control(mtbl->res_hdl, PAS_MEDIA_CH_START, SDI_MEDIA_DEFAULT, false) != STD_ERR_OK) {
+                PAS_ERR("Serdes control failed, port(%u), channel(%u), state(false)", port, PAS_MEDIA_CH_START);
+            }
+        }
+        break;
+
+    case PAS_MEDIA_INSERT_DATA:
+        if (dn_pas_media_data_poll(port, obj) == false) {
+            PAS_ERR("Failed to poll media data, port %u", port);
+        }
+
+        if (dn_pas_media_threshold_poll(port, obj) == false) {
+            PAS_ERR("Failed to poll media threshold, port %u", port);
+        }
+
+        if (dn_pas_media_vendor_info_poll(port, obj) == false) {
+            PAS_ERR("Failed to poll media vendor info, port %u", port);
+        }
+
+        dn_pas_media_fp_save(mtbl);
+        break;
+
+    default:
+        ret = false;
     }
 
-    if (dn_pas_phy_media_is_present(port) == false) {
+    return ret;
+}
 
-        dn_pas_media_high_power_mode_set(port, false);
-        PAS_NOTICE("Optic removed from front panel port (%d).", port);
+/*
+ * dn_pas_media_ident_restore is to take the given saved identification
+ * for the media present in the given port.
+ */
 
-        return ret;
+static bool dn_pas_media_ident_restore (uint_t port, phy_media_tbl_t *mtbl,
+        const pas_media_t *saved, const dn_pas_basic_media_info_t *info)
+{
+    pas_media_t          cur;
+    uint_t               slot = PAS_MEDIA_MY_SLOT;
+
+    cur = *mtbl->res_data;
+
+    if (!dn_pas_media_channel_res_alloc(slot, port, saved->category)) {
+        PAS_ERR("Failed to allocate channels, port %u", port);
+
+        return false;
     }
 
-    if (dn_pas_media_category_poll(port, obj) == false) {
-        PAS_ERR("Failed to poll media category, port %u",
-                port
-                );
+    *mtbl->res_data = *saved;
 
-        ret = false;
-    } else {
-        if (mtbl->res_data->supported_feature_valid == false) {
-            if (pas_sdi_media_feature_support_status_get(
-                        mtbl->res_hdl, &mtbl->res_data->supported_feature)
-                    != STD_ERR_OK) {
-                ret = false;
-            } else {
+    /* Keep run-time state of this instance */
 
-                mtbl->res_data->supported_feature_valid = true;
+    mtbl->res_data->sdi_resource_hdl    = mtbl->res_hdl;
+    mtbl->res_data->polling_count       = cur.polling_count;
+    mtbl->res_data->insertion_cnt       = cur.insertion_cnt;
+    mtbl->res_data->insertion_timestamp = cur.insertion_timestamp;
+    mtbl->res_data->lockdown_state      = cur.lockdown_state;
+    mtbl->res_data->target_wavelength   = cur.target_wavelength;
+    mtbl->res_data->polltime_from_epoch = cur.polltime_from_epoch;
+    mtbl->res_data->tlm_idx             = cur.tlm_idx;
+    mtbl->res_data->present             = true;
 
-                if ((mtbl->res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP)
-                        || (mtbl->res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP28)
-                        || (mtbl->res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP_DD)
-                        || (mtbl->res_data->category
-                            == PLATFORM_MEDIA_CATEGORY_QSFP_PLUS)) {
+    mtbl->media_info = *info;
 
-                    mtbl->res_data->rate_select_state =
-                        mtbl->res_data->supported_feature.qsfp_features.rate_select_status;
-                } else {
+    return true;
+}
 
-                    mtbl->res_data->rate_select_state =
-                        mtbl->res_data->supported_feature.sfp_features.rate_select_status;
-                }
-            }
+/*
+ * dn_pas_media_fp_reseat is to restore the identity of media inserted in
+ * the given port, if it is the media last identified there, i.e. it was
+ * re-seated; returns false if it must be identified.
+ */
+
+static bool dn_pas_media_fp_reseat (uint_t port, phy_media_tbl_t *mtbl)
+{
+    struct pas_config_media *cfg;
+
+    if (!dn_pas_media_fp_match(mtbl)) {
+        mtbl->fp_valid = false;
+
+        return false;
+    }
+
+    if (!dn_pas_media_ident_restore(port, mtbl, &mtbl->fp_ident->res_data,
+                                    &mtbl->fp_ident->media_info)) {
+        return false;
+    }
+
+    mtbl->fp_reseated   = true;
+    mtbl->fp_poll_count = 0;
+
+    /* Set up the media as on identification; only decoding is skipped */
+
+    dn_pas_media_insert_hw_setup(port, mtbl, mtbl->res_data->type);
+
+    cfg = dn_pas_config_media_get();
+    if (cfg->lockdown && (mtbl->res_data->qualified == false)) {
+        if (dn_pas_is_media_unsupported(mtbl, true)) {  /* log msg if unsupported */
+            dn_pas_media_transceiver_state_set(port, cfg->lockdown);
         }
     }
 
-    if (dn_pas_media_dq_poll(port, obj) == false) {
+    /* Bring sfp t serdes down also */
 
-        ret = false;
+    if (dn_pas_is_phy_ctrl_supported(mtbl) != PHY_CTRL_NO_SUPP) {
+        if (sdi_media_phy_serdes_control(mtbl->res_hdl, PAS_MEDIA_CH_START, SDI_MEDIA_DEFAULT, false) != STD_ERR_OK) {
+            PAS_ERR("Serdes control failed, port(%u), channel(%u), state(false)", port, PAS_MEDIA_CH_START);
+        }
     }
 
-    if (dn_pas_media_wavelength_poll(port, obj) == false) {
-        PAS_ERR("Failed to poll media wavelength, port %u",
-                port
-                );
+    PAS_NOTICE("Optic re-seated in front panel port (%d), qualified: %s.",
+            port, (mtbl->res_data->qualified == true) ? "Yes" : "No");
 
-        ret = false;
+    return true;
+}
+
+/*
+ * dn_pas_media_fp_check is to check, every configured number of polls,
+ * that the media in the given port is still the one identified; media
+ * swapped without a presence change being seen is forgotten, so that it
+ * is identified as inserted on this poll.
+ */
+
+static void dn_pas_media_fp_check (uint_t port, phy_media_tbl_t *mtbl)
+{
+    uint_t               interval = dn_pas_config_media_get()->fingerprint_interval;
+    pas_media_fp_t       fp;
+
+    if ((interval == 0) || !mtbl->fp_valid || !mtbl->res_data->present
+            || (mtbl->insert_stage != PAS_MEDIA_INSERT_IDLE)
+            || (++mtbl->fp_poll_count < interval)) {
+        return;
     }
 
-    if (dn_pas_media_vendor_oui_poll(port, obj) == false) {
-        PAS_ERR("Failed to poll media vendor OUI, port %u",
-                port
-                );
+    mtbl->fp_poll_count = 0;
 
-        ret = false;
+    /* Read failure => Leave it to presence detection */
+
+    if (!dn_pas_media_fp_read(mtbl, mtbl->res_data->category, &fp)
+            || (memcmp(&fp, &mtbl->fp, sizeof(fp)) == 0)) {
+        return;
     }
 
-    if (dn_pas_media_type_poll(port, obj) == false) {
-        PAS_ERR("Failed to poll media type, port %u",
+    PAS_NOTICE("Optic changed in front panel port (%d).", port);
+
+    mtbl->fp_valid = false;
+    dn_pas_media_absent_reset(port, mtbl);
+}
+
+/*
+ * dn_pas_media_oir_poll is to poll the basic information of the media,
+ * to publish on media presence detection.
+ */
+
+static bool dn_pas_media_oir_poll (uint_t port, cps_api_object_t obj)
+{
+    bool                 ret = true;
+    bool                 presence;
+    phy_media_tbl_t      *mtbl = NULL;
+
+
+    mtbl = dn_phy_media_entry_get(port);
+    STD_ASSERT(mtbl != NULL);
+
+    presence = dn_pas_phy_media_is_present(port);
+
+    if (dn_pas_media_presence_poll(port, obj) == false) {
+        PAS_ERR("Failed to get media module presence, port %u",
                 port
                 );
 
-        ret = false;
+        return false;
     }
+    bool cur_presence = dn_pas_phy_media_is_present(port);
+
+    if ((cur_presence == true)
+            && (mtbl->res_data->type == PLATFORM_MEDIA_TYPE_SFP_T)) {
 
-    PAS_NOTICE("Optic inserted in front panel port (%d), qualified: %s.",
-            port, (mtbl->res_data->qualified == true) ?
-            "Yes" : "No");
+        if (cur_presence != presence) {
+            mtbl->channel_data[PAS_MEDIA_CH_START].is_link_status_valid = false;
+        }
 
-    if (dn_pas_media_capability_poll(port, obj) == false) {
-        PAS_ERR("Failed to poll media capability, port %u",
-                port
-                );
+        /* With a dedicated link check cadence, only check on insertion here */
 
-        ret = false;
+        if ((dn_pas_config_media_get()->sfp_t_link_interval == 0)
+                || (cur_presence != presence)) {
+            dn_pas_media_channel_serdes_control(port, PAS_MEDIA_CH_START);
+        }
     }
 
-    if (dn_pas_media_vendor_name_poll(port, obj) == false) {
-        PAS_ERR("Failed to poll media vendor name, port %u",
-                port
-                );
+    if (presence == cur_presence) {
+        return ret;
+    }
 
-        ret = false;
+    /* Presence changed => Abandon any insertion processing in progress */
+
+    ++mtbl->insert_gen;
+    mtbl->insert_stage = PAS_MEDIA_INSERT_IDLE;
+    mtbl->eeprom_img_valid = false;
+    mtbl->cmis_info_valid  = false;
+    dn_pas_media_ckpt_mark();
+
+    if (dn_pas_phy_media_is_present(port) == false) {
+
+        dn_pas_media_high_power_mode_set(port, false);
+        PAS_NOTICE("Optic removed from front panel port (%d).", port);
+
+        return ret;
     }
 
-    if (dn_pas_media_default_capability_poll(port, obj) == false) {
-        PAS_ERR("Failed to poll media breakout info, port %u",
-                port
-                );
+    /* Same media re-seated => Identification not needed */
 
-        ret = false;
+    if (dn_pas_media_fp_reseat(port, mtbl)) {
+        return ret;
     }
-    pas_media_get_media_properties(mtbl);
 
+    if (dn_pas_media_insert_async()) {
+        /* Identify in insertion pipeline; media published when done */
 
-    /* Bring sfp t serdes down also */
+        mtbl->insert_stage = PAS_MEDIA_INSERT_CATEGORY;
+        dn_pas_media_insert_enqueue(port, mtbl->insert_gen);
 
-    if (dn_pas_is_phy_ctrl_supported(mtbl) != PHY_CTRL_NO_SUPP) {
-        if (sdi_media_phy_serdes_control(mtbl->res_hdl, PAS_MEDIA_CH_START, SDI_MEDIA_DEFAULT, false) != STD_ERR_OK) {
-            PAS_ERR("Serdes control failed, port(%u), channel(%u), state(false)", port, PAS_MEDIA_CH_START);
+        return ret;
+    }
+
+    uint_t stage;
+
+    for (stage = PAS_MEDIA_INSERT_CATEGORY; stage < PAS_MEDIA_INSERT_DATA;
+            ++stage) {
+        if (dn_pas_media_insert_stage(port, stage, obj) == false) {
+            ret = false;
         }
     }
 
@@ -3225,6 +4071,12 @@ void dn_pas_phy_media_channel_poll (uint_t port, uint_t channel, bool publish)
     uint_t                slot;
     pas_media_channel_t   *ch_data = NULL;
 
+    /* Packed DOM events carry channel state => No per-channel events */
+
+    if (dn_pas_config_media_get()->dom_format == PAS_MEDIA_DOM_FORMAT_PACKED) {
+        publish = false;
+    }
+
     obj = publish ? cps_api_object_create() : CPS_API_OBJECT_NULL;
 
     if (dn_pas_media_channel_rtd_poll(port, channel, obj) == false) {
@@ -3261,10 +4113,81 @@ void dn_pas_phy_media_channel_poll (uint_t port, uint_t channel, bool publish)
 
         if (ch_data != NULL) {
             ch_data->polltime_from_epoch = std_time_get_current_from_epoch_in_nanoseconds();
+
+            dn_pas_telemetry_media_channel_update(port, channel, ch_data);
         }
     }
 }
 
+/*
+ * dn_pas_phy_media_dom_publish publishes all DOM values of a port and its
+ * channels, in one packed attribute.
+ */
+
+static bool dn_pas_phy_media_dom_publish (uint_t port)
+{
+    phy_media_tbl_t      *mtbl = NULL;
+    pas_media_t          *res_data;
+    pas_media_channel_t  *ch_data;
+    cps_api_object_t     obj;
+    dn_pas_media_dom_t   dom[1];
+    uint8_t              buf[sizeof(dn_pas_media_dom_packed_hdr_t)
+                             + DN_PAS_MEDIA_DOM_MAX_CHANNELS
+                             * sizeof(dn_pas_media_dom_packed_chan_t)
+                             ];
+    size_t               len;
+    uint_t               slot, channel;
+
+    if ((mtbl = dn_phy_media_entry_get(port)) == NULL)  return false;
+
+    res_data = mtbl->res_data;
+
+    memset(dom, 0, sizeof(dom));
+    dom->port          = port;
+    dom->poll_time     = std_time_get_current_from_epoch_in_nanoseconds();
+    dom->temperature   = res_data->current_temperature;
+    dom->voltage       = res_data->current_voltage;
+    dom->temp_state    = res_data->temp_state;
+    dom->voltage_state = res_data->voltage_state;
+
+    for (channel = PAS_MEDIA_CH_START;
+         channel < mtbl->channel_cnt && dom->num_channels < DN_PAS_MEDIA_DOM_MAX_CHANNELS;
+         ++channel) {
+        ch_data = &mtbl->channel_data[channel];
+
+        dom->channels[dom->num_channels].rx_power        = ch_data->rx_power;
+        dom->channels[dom->num_channels].tx_power        = ch_data->tx_power;
+        dom->channels[dom->num_channels].tx_bias_current = ch_data->tx_bias_current;
+        dom->channels[dom->num_channels].rx_power_state  = ch_data->rx_power_state;
+        dom->channels[dom->num_channels].tx_power_state  = ch_data->tx_power_state;
+        dom->channels[dom->num_channels].tx_bias_state   = ch_data->tx_bias_state;
+        dom->channels[dom->num_channels].flags
+            = (ch_data->rx_loss ? DN_PAS_MEDIA_DOM_CH_RX_LOSS : 0)
+            | (ch_data->tx_loss ? DN_PAS_MEDIA_DOM_CH_TX_LOSS : 0)
+            | (ch_data->tx_fault ? DN_PAS_MEDIA_DOM_CH_TX_FAULT : 0)
+            | (ch_data->tx_disable ? DN_PAS_MEDIA_DOM_CH_TX_DISABLE : 0);
+
+        ++dom->num_channels;
+    }
+
+    len = dn_pas_media_dom_encode(dom, buf, sizeof(buf));
+    if (len == 0)  return false;
+
+    if ((obj = cps_api_object_create()) == CPS_API_OBJECT_NULL) {
+        PAS_ERR("Failed to create an obj for port (%u)", port);
+        return false;
+    }
+
+    dn_pas_myslot_get(&slot);
+
+    dn_pas_obj_key_media_set(obj, cps_api_qualifier_OBSERVED, true, slot,
+                             false, PAS_MEDIA_INVALID_PORT_MODULE, true, port);
+
+    cps_api_object_attr_add(obj, DN_PAS_ATTR_MEDIA_DOM_PACKED, buf, len);
+
+    return dn_media_obj_publish(obj);
+}
+
 void dn_pas_phy_media_channel_poll_all (uint_t port, bool publish)
 {
     uint_t               channel, channel_cnt;
@@ -3768,11 +4691,369 @@ static bool dn_pas_phy_media_mon(uint_t port)
 }
 
 
+/* Return monotonic time, in ms */
+
+static uint64_t dn_pas_media_now_ms (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
 /*
- * dn_pas_phy_media_poll is to poll media info for specified port.
+ * dn_pas_phy_media_dom_demand requests analog DOM values be read on
+ * the next poll of the port, e.g. for a realtime get.
  */
 
-void dn_pas_phy_media_poll (uint_t port, bool publish)
+void dn_pas_phy_media_dom_demand (uint_t port)
+{
+    phy_media_tbl_t      *mtbl = NULL;
+
+    if ((mtbl = dn_phy_media_entry_get(port)) == NULL) return;
+
+    mtbl->dom_demand = true;
+}
+
+/*
+ * dn_pas_phy_media_dom_plan decides, in flag-first DOM mode, whether the
+ * analog DOM values are to be read this RTD cycle. Only the latched
+ * module and channel monitor flags are read; the analog values are read
+ * when the flags changed, on demand, or when the refresh interval expired.
+ */
+
+static void dn_pas_phy_media_dom_plan (uint_t port, phy_media_tbl_t *mtbl)
+{
+    struct pas_config_media *cfg = dn_pas_config_media_get();
+    uint_t               status, channel;
+    bool                 changed = false;
+
+    mtbl->dom_flags_read  = false;
+    mtbl->dom_analog_skip = false;
+    mtbl->dom_analog_read = false;
+
+    if (!cfg->dom_flag_first) return;
+
+    /* Modules without latched flags are always read in full */
+
+    if (((mtbl->res_data->category == PLATFORM_MEDIA_CATEGORY_SFP_PLUS)
+                || (mtbl->res_data->category ==  PLATFORM_MEDIA_CATEGORY_SFP))
+            && (mtbl->res_data->supported_feature.sfp_features.alarm_support_status
+                == false)) return;
+
+    status = 0;
+    if (dn_pas_media_module_monitor_status_poll(port, &status) == false) return;
+
+    if (status != mtbl->dom_mon_status) changed = true;
+    mtbl->dom_mon_status = status;
+
+    for (channel = PAS_MEDIA_CH_START; channel < mtbl->channel_cnt; channel++) {
+        status = 0;
+        if (dn_pas_media_channel_monitor_status_poll(port, channel, &status)
+                == false) return;
+
+        if (status != mtbl->channel_data[channel].mon_status) changed = true;
+        mtbl->channel_data[channel].mon_status = status;
+    }
+
+    mtbl->dom_flags_read = true;
+
+    if (!changed && !mtbl->dom_demand && mtbl->dom_analog_valid
+            && (dn_pas_media_now_ms() - mtbl->dom_analog_time
+                < cfg->dom_refresh_interval)) {
+        mtbl->dom_analog_skip = true;
+    }
+}
+
+/*
+ * dn_pas_phy_media_is_admin_up returns true if any channel of the port
+ * has been set admin up.
+ */
+
+static bool dn_pas_phy_media_is_admin_up (phy_media_tbl_t *mtbl)
+{
+    uint_t               channel;
+
+    for (channel = PAS_MEDIA_CH_START; channel < mtbl->channel_cnt; channel++) {
+        if (mtbl->channel_data[channel].tgt_state) return true;
+    }
+
+    return false;
+}
+
+/* Number of real time data polls in current poll cycle, for RTD budget */
+
+static uint_t rtd_budget_used;
+
+/*
+ * dn_pas_phy_media_poll_cycle_start is called at the start of each cycle
+ * of polling all ports, to renew the real time data poll budget.
+ */
+
+void dn_pas_phy_media_poll_cycle_start (void)
+{
+    rtd_budget_used = 0;
+
+    dn_pas_media_seg_cycle_end();
+
+    dn_pas_media_ckpt_sync();
+}
+
+/*
+ * dn_pas_phy_media_rtd_interval returns the real time data poll interval
+ * of a port, adaptive or global.
+ */
+
+static uint_t dn_pas_phy_media_rtd_interval (phy_media_tbl_t *mtbl)
+{
+    struct pas_config_media *cfg = dn_pas_config_media_get();
+
+    if (!cfg->rtd_adaptive || !mtbl->rtd_adapted) return cfg->rtd_interval;
+
+    return mtbl->rtd_interval;
+}
+
+/*
+ * dn_pas_phy_media_rtd_hot returns true if a DOM value is within the
+ * configured margin of its warning thresholds, or changed fast since the
+ * last evaluation. Values without programmed thresholds are ignored.
+ */
+
+static bool dn_pas_phy_media_rtd_hot (double val, double prev, bool prev_valid,
+        double low_warning, double high_warning)
+{
+    struct pas_config_media *cfg = dn_pas_config_media_get();
+    double               span = high_warning - low_warning;
+
+    if (isnan(val) || span <= 0) return false;
+
+    if ((val >= high_warning - span * cfg->rtd_margin / 100)
+            || (val <= low_warning + span * cfg->rtd_margin / 100)) {
+        return true;
+    }
+
+    return (prev_valid && !isnan(prev)
+            && fabs(val - prev) > span * cfg->rtd_rate / 100);
+}
+
+/*
+ * dn_pas_phy_media_rtd_adapt re-evaluates the adaptive real time data
+ * poll interval of a port after its analog DOM values were read. Ports
+ * near thresholds, which changed alarm zone, or whose values change fast
+ * drop to the minimum interval; others back off, up to the cap.
+ */
+
+static void dn_pas_phy_media_rtd_adapt (phy_media_tbl_t *mtbl)
+{
+    struct pas_config_media *cfg = dn_pas_config_media_get();
+    pas_media_t          *res_data = mtbl->res_data;
+    pas_media_channel_t  *ch_data;
+    bool                 prev_valid = mtbl->rtd_adapted;
+    bool                 hot = false;
+    uint_t               zone, channel;
+
+    if (!cfg->rtd_adaptive) return;
+
+    zone = res_data->temp_state | (res_data->voltage_state << 4);
+
+    hot |= dn_pas_phy_media_rtd_hot(res_data->current_temperature,
+            mtbl->rtd_prev_temperature, prev_valid,
+            res_data->temp_low_warning, res_data->temp_high_warning);
+    hot |= dn_pas_phy_media_rtd_hot(res_data->current_voltage,
+            mtbl->rtd_prev_voltage, prev_valid,
+            res_data->voltage_low_warning, res_data->voltage_high_warning);
+
+    mtbl->rtd_prev_temperature = res_data->current_temperature;
+    mtbl->rtd_prev_voltage     = res_data->current_voltage;
+
+    for (channel = PAS_MEDIA_CH_START; channel < mtbl->channel_cnt; channel++) {
+        ch_data = &mtbl->channel_data[channel];
+
+        zone = zone * 31 + (ch_data->rx_power_state
+                | (ch_data->tx_power_state << 4) | (ch_data->tx_bias_state << 8));
+
+        hot |= dn_pas_phy_media_rtd_hot(ch_data->rx_power,
+                ch_data->rtd_prev_rx_power, prev_valid,
+                res_data->rx_power_low_warning, res_data->rx_power_high_warning);
+        hot |= dn_pas_phy_media_rtd_hot(ch_data->tx_power,
+                ch_data->rtd_prev_tx_power, prev_valid,
+                res_data->tx_power_low_warning, res_data->tx_power_high_warning);
+        hot |= dn_pas_phy_media_rtd_hot(ch_data->tx_bias_current,
+                ch_data->rtd_prev_tx_bias_current, prev_valid,
+                res_data->bias_low_warning, res_data->bias_high_warning);
+
+        ch_data->rtd_prev_rx_power        = ch_data->rx_power;
+        ch_data->rtd_prev_tx_power        = ch_data->tx_power;
+        ch_data->rtd_prev_tx_bias_current = ch_data->tx_bias_current;
+    }
+
+    if (prev_valid && zone != mtbl->rtd_zone) hot = true;
+    mtbl->rtd_zone = zone;
+
+    if (hot) {
+        mtbl->rtd_interval = cfg->rtd_min_interval;
+    } else if (!prev_valid) {
+        mtbl->rtd_interval = cfg->rtd_interval;
+    } else {
+        mtbl->rtd_interval = (mtbl->rtd_interval == 0) ? 1 : mtbl->rtd_interval * 2;
+        if (mtbl->rtd_interval > cfg->rtd_max_interval) {
+            mtbl->rtd_interval = cfg->rtd_max_interval;
+        }
+    }
+
+    mtbl->rtd_adapted = true;
+}
+
+/*
+ * dn_pas_phy_media_discover is to detect and identify media in given port
+ * at startup, without holding off identification, and publish it; called
+ * from concurrent discovery workers, at most one per port. Returns true if
+ * media is present.
+ */
+
+bool dn_pas_phy_media_discover (uint_t port)
+{
+    phy_media_tbl_t      *mtbl = NULL;
+    uint_t               stage;
+
+    if (((mtbl = dn_phy_media_entry_get(port)) == NULL)
+            || !dn_pas_is_port_pluggable(port)) {
+        return false;
+    }
+
+    /* Media present at startup has long been powered => No holding time */
+
+    mtbl->mod_holding_so_far = mtbl->poll_cycles_to_skip;
+
+    if (dn_pas_media_presence_poll(port, NULL) == false) {
+        PAS_ERR("Failed to get media module presence, port %u", port);
+
+        return false;
+    }
+
+    if (dn_pas_phy_media_is_present(port) == false)  return false;
+
+    if (mtbl->res_data->valid)  return true;  /* Adopted from checkpoint */
+
+    for (stage = PAS_MEDIA_INSERT_CATEGORY; stage < PAS_MEDIA_INSERT_STAGE_MAX;
+            ++stage) {
+        dn_pas_media_insert_stage(port, stage, CPS_API_OBJECT_NULL);
+    }
+
+    /* Presence is not seen to change in the first poll => Record and
+       publish the insertion here
+    */
+
+    mtbl->res_data->insertion_timestamp = (uint64_t) time(NULL);
+    ++mtbl->res_data->insertion_cnt;
+    mtbl->res_data->valid = true;
+    dn_pas_media_ckpt_mark();
+
+    dn_pas_media_data_publish(port, pp_list, ARRAY_SIZE(pp_list), false);
+
+    return true;
+}
+
+/*
+ * dn_pas_phy_media_adopt is to take the given saved identification for
+ * media found present in given port at startup, instead of identifying it,
+ * and publish it.
+ */
+
+bool dn_pas_phy_media_adopt (uint_t port, const pas_media_t *saved,
+        const dn_pas_basic_media_info_t *info)
+{
+    phy_media_tbl_t      *mtbl = NULL;
+
+    if (((mtbl = dn_phy_media_entry_get(port)) == NULL)
+            || !dn_pas_is_port_pluggable(port)
+            || mtbl->res_data->present) {
+        return false;
+    }
+
+    if (!dn_pas_media_ident_restore(port, mtbl, saved, info)) {
+        return false;
+    }
+
+    ++mtbl->res_data->insertion_cnt;
+    mtbl->res_data->valid    = true;
+    mtbl->mod_holding_so_far = mtbl->poll_cycles_to_skip + 1;
+
+    sdi_media_module_init(mtbl->res_hdl, true);
+
+    dn_pas_media_fp_save(mtbl);
+
+    dn_pas_media_data_publish(port, pp_list, ARRAY_SIZE(pp_list), false);
+
+    return true;
+}
+
+/*
+ * dn_pas_phy_media_fp_get is to read the fingerprint of the media in the
+ * given port, for the media identification checkpoint.
+ */
+
+bool dn_pas_phy_media_fp_get (uint_t port, uint_t category,
+        pas_media_fp_t *fp)
+{
+    phy_media_tbl_t      *mtbl = NULL;
+
+    if ((mtbl = dn_phy_media_entry_get(port)) == NULL)  return false;
+
+    return dn_pas_media_fp_read(mtbl, category, fp);
+}
+
+/*
+ * dn_pas_phy_media_insert_stage_run is to run the next insertion pipeline
+ * stage of the given port, under the PAS lock. Stale requests, i.e. for a
+ * presence change since superseded, are dropped. Media is published
+ * when the last stage completes.
+ */
+
+bool dn_pas_phy_media_insert_stage_run (uint_t port, uint_t gen)
+{
+    phy_media_tbl_t      *mtbl = NULL;
+    uint_t               stage;
+    bool                 more = false;
+
+    dn_pas_lock();
+
+    mtbl = dn_phy_media_entry_get(port);
+
+    if ((mtbl == NULL) || (mtbl->insert_gen != gen)
+            || (mtbl->insert_stage == PAS_MEDIA_INSERT_IDLE)
+            || !dn_pas_phy_media_is_present(port)) {
+        dn_pas_unlock();
+
+        return false;
+    }
+
+    stage = mtbl->insert_stage;
+
+    dn_pas_media_insert_stage(port, stage, CPS_API_OBJECT_NULL);
+
+    if (stage < PAS_MEDIA_INSERT_DATA) {
+        mtbl->insert_stage = stage + 1;
+        more = true;
+    } else {
+        mtbl->insert_stage = PAS_MEDIA_INSERT_IDLE;
+        mtbl->res_data->polling_count = 0;
+        dn_pas_media_ckpt_mark();
+
+        dn_pas_media_data_publish(port, pp_list, ARRAY_SIZE(pp_list), false);
+    }
+
+    dn_pas_unlock();
+
+    return more;
+}
+
+/*
+ * dn_pas_phy_media_port_poll is to poll media info for specified port.
+ */
+
+static void dn_pas_phy_media_port_poll (uint_t port, bool publish)
 {
 
     phy_media_tbl_t      *mtbl = NULL;
@@ -3792,6 +5073,8 @@ void dn_pas_phy_media_poll (uint_t port, bool publish)
         return;
     }
 
+    dn_pas_media_fp_check(port, mtbl);
+
     presence = mtbl->res_data->present;
 
     obj = publish ? cps_api_object_create() : CPS_API_OBJECT_NULL;
@@ -3800,6 +5083,7 @@ void dn_pas_phy_media_poll (uint_t port, bool publish)
         PAS_ERR("Failed to poll media OIR, port %u", port);
 
         mtbl->res_data->present = false;
+        mtbl->dom_analog_valid  = false;
 
         if (obj != CPS_API_OBJECT_NULL) {
             cps_api_object_delete(obj);
@@ -3812,15 +5096,34 @@ void dn_pas_phy_media_poll (uint_t port, bool publish)
 
         struct pas_config_media *cfg = dn_pas_config_media_get();
 
-        if ((mtbl->res_data->polling_count > 0)
-                && (mtbl->res_data->polling_count <= cfg->rtd_interval)) {
+        if (mtbl->insert_stage != PAS_MEDIA_INSERT_IDLE) {
+            /* Still being identified in insertion pipeline
+               => Real time data poll is due once published */
+
+            mtbl->res_data->polling_count = 0;
+        } else if (cfg->admin_aware_polling && !mtbl->dom_demand
+                && !dn_pas_phy_media_is_admin_up(mtbl)) {
+            /* Admin down or unconfigured => Presence only; real time
+               data poll is due as soon as the port comes up */
+
+            mtbl->res_data->polling_count = 0;
+        } else if ((mtbl->res_data->polling_count > 0)
+                && (mtbl->res_data->polling_count <= dn_pas_phy_media_rtd_interval(mtbl))
+                && !mtbl->dom_demand) {
             mtbl->res_data->polling_count += 1;
+        } else if ((cfg->rtd_budget != 0) && (rtd_budget_used >= cfg->rtd_budget)
+                && !mtbl->dom_demand) {
+            /* Real time data poll budget for this cycle used up
+               => Defer to next cycle */
         } else {
             mtbl->res_data->polling_count = 1;
             rtd_poll = true;
+            ++rtd_budget_used;
         }
 
         if (rtd_poll == true) {
+            dn_pas_phy_media_dom_plan(port, mtbl);
+
             if (dn_pas_media_rtd_poll(port, obj) == false) {
                 PAS_ERR("Failed to poll media real-time data, port %u", port);
             }
@@ -3831,6 +5134,11 @@ void dn_pas_phy_media_poll (uint_t port, bool publish)
         }
     }
 
+    if (dn_pas_phy_media_is_present(port) == false) {
+        mtbl->dom_analog_valid = false;
+        mtbl->rtd_adapted      = false;
+    }
+
     if ((dn_pas_phy_media_is_present(port) == true)
             &&(presence != dn_pas_phy_media_is_present(port))) {
 
@@ -3846,21 +5154,18 @@ void dn_pas_phy_media_poll (uint_t port, bool publish)
             obj = CPS_API_OBJECT_NULL;
         }
 
-        if (dn_pas_media_data_poll(port, obj) == false) {
-            PAS_ERR("Failed to poll media data, port %u", port);
-        }
-
-        if (dn_pas_media_threshold_poll(port, obj) == false) {
-            PAS_ERR("Failed to poll media threshold, port %u", port);
-        }
+        if (mtbl->insert_stage == PAS_MEDIA_INSERT_IDLE) {
+            /* Identity restored by fingerprint => Nothing more to read */
 
-        if (dn_pas_media_vendor_info_poll(port, obj) == false) {
-            PAS_ERR("Failed to poll media vendor info, port %u", port);
-        }
+            if (!mtbl->fp_reseated) {
+                dn_pas_media_insert_stage(port, PAS_MEDIA_INSERT_DATA, obj);
+            }
+            mtbl->fp_reseated = false;
 
-        if (publish == true) {
-            dn_pas_media_data_publish(port, pp_list,
-                    ARRAY_SIZE(pp_list), false);
+            if (publish == true) {
+                dn_pas_media_data_publish(port, pp_list,
+                        ARRAY_SIZE(pp_list), false);
+            }
         }
     }
 
@@ -3902,13 +5207,51 @@ void dn_pas_phy_media_poll (uint_t port, bool publish)
     if (rtd_poll == true) {
         dn_pas_phy_media_channel_poll_all(port, publish);
 
-        /* media monitoring */
-        if (dn_pas_phy_media_mon(port) == false) {
+        /* media monitoring; zones only change with the analog values */
+        if (!mtbl->dom_analog_skip && dn_pas_phy_media_mon(port) == false) {
             PAS_ERR("Failed to monitor media port %u", port);
         }
+
+        /* Nothing new to publish if analog values and flags unchanged */
+        if (publish
+            && !mtbl->dom_analog_skip
+            && dn_pas_phy_media_is_present(port)
+            && dn_pas_config_media_get()->dom_format != PAS_MEDIA_DOM_FORMAT_ATTRS
+            && dn_pas_phy_media_dom_publish(port) == false) {
+            PAS_ERR("Failed to publish packed DOM, port %u", port);
+        }
+
+        if (!mtbl->dom_analog_skip) {
+            mtbl->dom_analog_valid = true;
+            mtbl->dom_analog_time  = dn_pas_media_now_ms();
+
+            dn_pas_phy_media_rtd_adapt(mtbl);
+        }
+        mtbl->dom_demand      = false;
+        mtbl->dom_flags_read  = false;
+        mtbl->dom_analog_skip = false;
+        mtbl->dom_analog_read = false;
     }
 
     mtbl->res_data->polltime_from_epoch = std_time_get_current_from_epoch_in_nanoseconds();
+
+    dn_pas_telemetry_media_update(port, mtbl->res_data, &mtbl->read_stats);
+}
+
+/*
+ * dn_pas_phy_media_poll is to poll media info for specified port,
+ * accounted to its I2C mux segment.
+ */
+
+void dn_pas_phy_media_poll (uint_t port, bool publish)
+{
+    uint64_t             start;
+
+    start = dn_pas_media_seg_poll_begin(port);
+
+    dn_pas_phy_media_port_poll(port, publish);
+
+    dn_pas_media_seg_poll_end(port, start);
 }
 
 /*
@@ -4378,6 +5721,30 @@ bool dn_pas_media_channel_serdes_control (uint_t port, uint_t channel)
 }
 
 
+/*
+ * dn_pas_media_sfp_t_link_poll_all checks the PHY link status of all
+ * present copper SFPs, and updates their serdes on link changes; called
+ * at the configured link check cadence.
+ */
+
+void dn_pas_media_sfp_t_link_poll_all (void)
+{
+    phy_media_tbl_t      *mtbl;
+    uint_t               port;
+
+    for (port = PAS_MEDIA_START_PORT; port <= phy_media_count; port++) {
+        mtbl = dn_phy_media_entry_get(port);
+
+        if ((mtbl == NULL) || (mtbl->res_data == NULL)
+                || !mtbl->res_data->present
+                || (mtbl->res_data->type != PLATFORM_MEDIA_TYPE_SFP_T)) {
+            continue;
+        }
+
+        dn_pas_media_channel_serdes_control(port, PAS_MEDIA_CH_START);
+    }
+}
+
 /*
  * dn_pas_media_channel_led_set is to set the led per channel based on the speed.
  */
@@ -4911,6 +6278,10 @@ void dn_pas_phy_media_res_free(void)
             phy_media_tbl[port].channel_cnt = 0;
         }
 
+        free(phy_media_tbl[port].fp_ident);
+        phy_media_tbl[port].fp_ident = NULL;
+        phy_media_tbl[port].fp_valid = false;
+
         dn_pas_res_removec(dn_pas_res_key_media(res_key,
                                                 sizeof(res_key),
                                                 slot,
@@ -4924,6 +6295,8 @@ void dn_pas_phy_media_res_free(void)
     free(phy_media_tbl);
     phy_media_tbl = NULL;
     phy_media_count = 0;
+
+    dn_pas_media_seg_free();
 }
 /*
  * dn_pas_media_wavelength_config_set is to set the user configured wavelength
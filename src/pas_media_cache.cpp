@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**************************************************************************
+ * @file pas_media_cache.cpp
+ *
+ * @brief Media identification cache
+ *
+ * Identical optics share a vendor part number, so derive the same media
+ * properties; these are derived once per vendor OUI, PN and revision (and
+ * the port-dependent inputs, see pas_media_info_key_t). Vendor plug-in
+ * qualification may depend on the individual module, so it is cached by
+ * serial number, saving the plug-in call when a module is reinserted.
+ **************************************************************************/
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "private/pas_media_cache.h"
+#include "private/pas_log.h"
+
+#include <string.h>
+
+/* Qualification key */
+
+struct pas_media_qual_key {
+    char    vendor_id[SDI_MEDIA_MAX_VENDOR_OUI_LEN];
+    uint8_t vendor_pn[SDI_MEDIA_MAX_VENDOR_PART_NUMBER_LEN];
+    char    vendor_rev[SDI_MEDIA_MAX_VENDOR_REVISION_LEN];
+    char    serial_number[SDI_MEDIA_MAX_VENDOR_SERIAL_NUMBER_LEN];
+};
+
+struct pas_media_qual_val {
+    PLATFORM_MEDIA_TYPE_t type;
+    bool                  qualified;
+};
+
+/* Derived media info */
+
+struct pas_media_info_val {
+    dn_pas_basic_media_info_t media_info;
+    PLATFORM_MEDIA_TYPE_t     type;
+    media_capability_t        capability;
+};
+
+static std::mutex media_cache_mutex;
+
+static std::unordered_map<std::string, pas_media_qual_val> media_qual_cache;
+static std::unordered_map<std::string, pas_media_info_val> media_info_cache;
+
+static pas_media_cache_stats_t media_cache_stats;
+
+/* Keys are compared as raw bytes, so are always zero filled first */
+
+template <typename T>
+static std::string media_cache_key(const T &key)
+{
+    return (std::string((const char *) &key, sizeof(key)));
+}
+
+template <typename M>
+static void media_cache_insert(M &cache, const std::string &key,
+                               const typename M::mapped_type &val
+                               )
+{
+    if (cache.size() >= PAS_MEDIA_CACHE_MAX_ENTRIES
+        && cache.find(key) == cache.end()
+        ) {
+        cache.clear();
+    }
+
+    cache[key] = val;
+}
+
+static bool media_cache_qual_key(const pas_media_t *res_data,
+                                 pas_media_qual_key *key
+                                 )
+{
+    if (res_data->vendor_pn[0] == 0 || res_data->serial_number[0] == 0) {
+        return (false);
+    }
+
+    memset(key, 0, sizeof(*key));
+    memcpy(key->vendor_id, res_data->vendor_id, sizeof(key->vendor_id));
+    memcpy(key->vendor_pn, res_data->vendor_pn, sizeof(key->vendor_pn));
+    memcpy(key->vendor_rev, res_data->vendor_rev, sizeof(key->vendor_rev));
+    memcpy(key->serial_number, res_data->serial_number,
+           sizeof(key->serial_number)
+           );
+
+    return (true);
+}
+
+bool dn_pas_media_cache_qual_get(const pas_media_t *res_data,
+                                 PLATFORM_MEDIA_TYPE_t *type,
+                                 bool *qualified
+                                 )
+{
+    pas_media_qual_key key;
+
+    if (!media_cache_qual_key(res_data, &key))  return (false);
+
+    std::lock_guard<std::mutex> lock(media_cache_mutex);
+
+    auto it = media_qual_cache.find(media_cache_key(key));
+    if (it == media_qual_cache.end()) {
+        ++media_cache_stats.qual_misses;
+
+        return (false);
+    }
+
+    ++media_cache_stats.qual_hits;
+    *type      = it->second.type;
+    *qualified = it->second.qualified;
+
+    return (true);
+}
+
+void dn_pas_media_cache_qual_put(const pas_media_t *res_data,
+                                 PLATFORM_MEDIA_TYPE_t type,
+                                 bool qualified
+                                 )
+{
+    pas_media_qual_key key;
+
+    if (!media_cache_qual_key(res_data, &key))  return;
+
+    std::lock_guard<std::mutex> lock(media_cache_mutex);
+
+    media_cache_insert(media_qual_cache, media_cache_key(key),
+                       pas_media_qual_val { type, qualified }
+                       );
+}
+
+bool dn_pas_media_cache_info_key(const phy_media_tbl_t *mtbl,
+                                 pas_media_info_key_t *key
+                                 )
+{
+    const pas_media_t *res_data = mtbl->res_data;
+
+    if (res_data->vendor_pn[0] == 0)  return (false);
+
+    memset(key, 0, sizeof(*key));
+    memcpy(key->vendor_id, res_data->vendor_id, sizeof(key->vendor_id));
+    memcpy(key->vendor_pn, res_data->vendor_pn, sizeof(key->vendor_pn));
+    memcpy(key->vendor_rev, res_data->vendor_rev, sizeof(key->vendor_rev));
+    key->category         = res_data->category;
+    key->port_type        = res_data->port_type;
+    key->type             = res_data->type;
+    key->qsa_adapter_type = res_data->qsa_adapter_type;
+    key->qualified        = res_data->qualified;
+    memcpy(&key->capability, &res_data->media_capabilities[0],
+           sizeof(key->capability)
+           );
+
+    return (true);
+}
+
+bool dn_pas_media_cache_info_get(const pas_media_info_key_t *key,
+                                 phy_media_tbl_t *mtbl
+                                 )
+{
+    std::lock_guard<std::mutex> lock(media_cache_mutex);
+
+    auto it = media_info_cache.find(media_cache_key(*key));
+    if (it == media_info_cache.end()) {
+        ++media_cache_stats.info_misses;
+
+        return (false);
+    }
+
+    ++media_cache_stats.info_hits;
+
+    const pas_media_info_val &val = it->second;
+
+    mtbl->media_info     = val.media_info;
+    mtbl->res_data->type = val.type;
+    memcpy(&mtbl->res_data->media_capabilities[0], &val.capability,
+           sizeof(val.capability)
+           );
+    mtbl->res_data->capability = val.capability.media_speed;
+
+    PAS_TRACE("Media info cache hit, port %u", mtbl->fp_port);
+
+    return (true);
+}
+
+void dn_pas_media_cache_info_put(const pas_media_info_key_t *key,
+                                 const phy_media_tbl_t *mtbl
+                                 )
+{
+    pas_media_info_val val;
+
+    val.media_info = mtbl->media_info;
+    val.type       = mtbl->res_data->type;
+    memcpy(&val.capability, &mtbl->res_data->media_capabilities[0],
+           sizeof(val.capability)
+           );
+
+    std::lock_guard<std::mutex> lock(media_cache_mutex);
+
+    media_cache_insert(media_info_cache, media_cache_key(*key), val);
+}
+
+void dn_pas_media_cache_stats_get(pas_media_cache_stats_t *stats)
+{
+    std::lock_guard<std::mutex> lock(media_cache_mutex);
+
+    *stats              = media_cache_stats;
+    stats->qual_entries = media_qual_cache.size();
+    stats->info_entries = media_info_cache.size();
+}
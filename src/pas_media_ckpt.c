@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: pas_media_ckpt.c
+ *
+ * Media identification checkpoint, for warm restart. The identified media
+ * data of each port is saved to a file under /run, which survives a
+ * service restart but not a reboot. On restart, media still present is
+ * validated by reading its fingerprint only (or, for media without one,
+ * its serial number), and the saved identification adopted, instead of
+ * re-running the identification chain. Records are raw structures, so a
+ * checkpoint is only used by the same PAS build that saved it.
+ */
+
+#define _GNU_SOURCE     /* dl_iterate_phdr() */
+
+#include "private/pas_media_ckpt.h"
+#include "private/pas_media.h"
+#include "private/pas_media_sdi_wrapper.h"
+#include "private/pas_res_structs.h"
+#include "private/pas_config.h"
+#include "private/pas_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include <link.h>
+#include <elf.h>
+
+#define PAS_MEDIA_CKPT_MAGIC         0x504d4350  /* "PCMP" */
+#define PAS_MEDIA_CKPT_VERSION       2
+#define PAS_MEDIA_CKPT_BUILD_ID_LEN  32
+
+/* Checkpoint file header */
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t media_size;    /* sizeof(pas_media_t), at save */
+    uint32_t info_size;     /* sizeof(dn_pas_basic_media_info_t), at save */
+    uint32_t build_id_len;  /* GNU build ID of PAS, at save */
+    uint8_t  build_id[PAS_MEDIA_CKPT_BUILD_ID_LEN];
+    uint32_t count;         /* Number of records following */
+} pas_media_ckpt_hdr_t;
+
+/* Checkpoint record, per port with media identified */
+
+typedef struct {
+    uint32_t                  port;
+    uint32_t                  crc;    /* Of fingerprint, media and info */
+    uint32_t                  fp_valid;
+    pas_media_fp_t            fp;     /* Fingerprint of media, if valid */
+    pas_media_t               media;
+    dn_pas_basic_media_info_t info;
+} pas_media_ckpt_rec_t;
+
+static bool ckpt_dirty = false;
+
+static uint32_t dn_pas_media_ckpt_crc(const pas_media_ckpt_rec_t *rec)
+{
+    uLong crc = crc32(0, Z_NULL, 0);
+
+    crc = crc32(crc, (const Bytef *) &rec->fp_valid, sizeof(rec->fp_valid));
+    crc = crc32(crc, (const Bytef *) &rec->fp, sizeof(rec->fp));
+    crc = crc32(crc, (const Bytef *) &rec->media, sizeof(rec->media));
+    crc = crc32(crc, (const Bytef *) &rec->info, sizeof(rec->info));
+
+    return ((uint32_t) crc);
+}
+
+/* Find GNU build ID note of the PAS executable, i.e. the first object
+   listed, and copy it to given header
+*/
+
+static int dn_pas_media_ckpt_build_id_cb(struct dl_phdr_info *info,
+                                         size_t size, void *data
+                                         )
+{
+    pas_media_ckpt_hdr_t *hdr = (pas_media_ckpt_hdr_t *) data;
+    const ElfW(Phdr)     *ph;
+    const ElfW(Nhdr)     *nh;
+    const uint8_t        *p, *end, *desc;
+    uint_t               i;
+
+    for (i = 0; i < info->dlpi_phnum; ++i) {
+        ph = &info->dlpi_phdr[i];
+        if (ph->p_type != PT_NOTE)  continue;
+
+        p   = (const uint8_t *) (info->dlpi_addr + ph->p_vaddr);
+        end = p + ph->p_memsz;
+
+        while (p + sizeof(*nh) <= end) {
+            nh   = (const ElfW(Nhdr) *) p;
+            desc = p + sizeof(*nh) + ((nh->n_namesz + 3) & ~3);
+            p    = desc + ((nh->n_descsz + 3) & ~3);
+            if (p > end)  break;
+
+            if (nh->n_type == NT_GNU_BUILD_ID
+                && nh->n_namesz == 4
+                && memcmp(nh + 1, "GNU", 4) == 0
+                && nh->n_descsz <= sizeof(hdr->build_id)
+                ) {
+                memcpy(hdr->build_id, desc, nh->n_descsz);
+                hdr->build_id_len = nh->n_descsz;
+
+                return (1);
+            }
+        }
+    }
+
+    return (1);     /* Executable only */
+}
+
+/* Fill in given header, for the running PAS build */
+
+static void dn_pas_media_ckpt_hdr_init(pas_media_ckpt_hdr_t *hdr)
+{
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->magic      = PAS_MEDIA_CKPT_MAGIC;
+    hdr->version    = PAS_MEDIA_CKPT_VERSION;
+    hdr->media_size = sizeof(pas_media_t);
+    hdr->info_size  = sizeof(dn_pas_basic_media_info_t);
+
+    dl_iterate_phdr(dn_pas_media_ckpt_build_id_cb, hdr);
+}
+
+void dn_pas_media_ckpt_mark(void)
+{
+    ckpt_dirty = true;
+}
+
+void dn_pas_media_ckpt_sync(void)
+{
+    static const char tmp_suffix[] = ".tmp";
+
+    char                 tmp_filename[sizeof(PAS_MEDIA_CKPT_FILENAME) + sizeof(tmp_suffix)];
+    pas_media_ckpt_hdr_t hdr[1];
+    pas_media_ckpt_rec_t rec[1];
+    phy_media_tbl_t      *mtbl;
+    uint_t               port, count = dn_phy_media_count_get();
+    FILE                 *fp;
+    bool                 ok = true;
+
+    if (!dn_pas_config_media_get()->warm_restart || !ckpt_dirty)  return;
+
+    ckpt_dirty = false;
+
+    snprintf(tmp_filename, sizeof(tmp_filename), "%s%s",
+             PAS_MEDIA_CKPT_FILENAME, tmp_suffix
+             );
+
+    if ((fp = fopen(tmp_filename, "w")) == NULL) {
+        PAS_ERR("Failed to create media checkpoint file %s", tmp_filename);
+
+        return;
+    }
+
+    dn_pas_media_ckpt_hdr_init(hdr);
+
+    /* Header rewritten with record count when done */
+
+    ok = (fwrite(hdr, sizeof(*hdr), 1, fp) == 1);
+
+    for (port = PAS_MEDIA_START_PORT; ok && port <= count; ++port) {
+        if (!dn_pas_is_port_pluggable(port)
+            || (mtbl = dn_phy_media_entry_get(port)) == NULL
+            || !mtbl->res_data->present
+            || (mtbl->insert_stage != PAS_MEDIA_INSERT_IDLE)
+            ) {
+            continue;
+        }
+
+        memset(rec, 0, sizeof(*rec));
+        rec->port  = port;
+        if (mtbl->fp_valid) {
+            rec->fp_valid = true;
+            rec->fp       = mtbl->fp;
+        }
+        rec->media = *mtbl->res_data;
+        rec->info  = mtbl->media_info;
+        rec->crc   = dn_pas_media_ckpt_crc(rec);
+
+        ok = (fwrite(rec, sizeof(*rec), 1, fp) == 1);
+
+        ++hdr->count;
+    }
+
+    if (ok) {
+        ok = (fseek(fp, 0, SEEK_SET) == 0)
+            && (fwrite(hdr, sizeof(*hdr), 1, fp) == 1);
+    }
+
+    if (fclose(fp) != 0)  ok = false;
+
+    if (!ok || rename(tmp_filename, PAS_MEDIA_CKPT_FILENAME) != 0) {
+        PAS_ERR("Failed to write media checkpoint file %s",
+                PAS_MEDIA_CKPT_FILENAME
+                );
+
+        remove(tmp_filename);
+        ckpt_dirty = true;      /* Retry at next sync */
+    }
+}
+
+uint_t dn_pas_media_ckpt_restore(void)
+{
+    pas_media_ckpt_hdr_t hdr[1], cur[1];
+    pas_media_ckpt_rec_t *rec;
+    phy_media_tbl_t      *mtbl;
+    uint_t               i, n = 0;
+    FILE                 *fp;
+
+    if (!dn_pas_config_media_get()->warm_restart)  return (0);
+
+    if ((fp = fopen(PAS_MEDIA_CKPT_FILENAME, "r")) == NULL) {
+        /* Cold start */
+
+        return (0);
+    }
+
+    /* Saved by a different PAS build => Record layout may differ; no
+       build ID => Builds cannot be told apart
+    */
+
+    dn_pas_media_ckpt_hdr_init(cur);
+
+    if (fread(hdr, sizeof(*hdr), 1, fp) != 1
+        || hdr->magic != cur->magic
+        || hdr->version != cur->version
+        || hdr->media_size != cur->media_size
+        || hdr->info_size != cur->info_size
+        || cur->build_id_len == 0
+        || hdr->build_id_len != cur->build_id_len
+        || memcmp(hdr->build_id, cur->build_id, sizeof(cur->build_id)) != 0
+        ) {
+        PAS_NOTICE("Media checkpoint file %s not usable, ignored",
+                   PAS_MEDIA_CKPT_FILENAME
+                   );
+
+        fclose(fp);
+
+        return (0);
+    }
+
+    if ((rec = (pas_media_ckpt_rec_t *) malloc(sizeof(*rec))) == NULL) {
+        fclose(fp);
+
+        return (0);
+    }
+
+    for (i = 0; i < hdr->count; ++i) {
+        char           sn[SDI_MEDIA_MAX_VENDOR_SERIAL_NUMBER_LEN];
+        pas_media_fp_t media_fp;
+        bool           present = false;
+
+        if (fread(rec, sizeof(*rec), 1, fp) != 1)  break;
+
+        if (rec->crc != dn_pas_media_ckpt_crc(rec)
+            || !dn_pas_is_port_pluggable(rec->port)
+            || (mtbl = dn_phy_media_entry_get(rec->port)) == NULL
+            ) {
+            continue;
+        }
+
+        if (pas_sdi_media_presence_get(mtbl->res_hdl, &present) != STD_ERR_OK
+            || !present
+            ) {
+            continue;
+        }
+
+        /* Same module still present <=> Same fingerprint, as on reseat;
+           else, for media without one (e.g. CMIS), same serial number
+        */
+
+        if (rec->fp_valid) {
+            if (!dn_pas_phy_media_fp_get(rec->port, rec->media.category,
+                                         &media_fp
+                                         )
+                || memcmp(&media_fp, &rec->fp, sizeof(media_fp)) != 0
+                ) {
+                continue;
+            }
+        } else {
+            memset(sn, 0, sizeof(sn));
+            if (pas_sdi_media_vendor_info_get(mtbl->res_hdl,
+                                              SDI_MEDIA_VENDOR_SN,
+                                              sn, sizeof(sn)
+                                              ) != STD_ERR_OK
+                || strncmp(sn, rec->media.serial_number, sizeof(sn)) != 0
+                ) {
+                continue;
+            }
+        }
+
+        if (dn_pas_phy_media_adopt(rec->port, &rec->media, &rec->info))  ++n;
+    }
+
+    free(rec);
+    fclose(fp);
+
+    PAS_NOTICE("Media warm restart: %u port(s) adopted from checkpoint", n);
+
+    /* Checkpoint rewritten with current state */
+
+    ckpt_dirty = true;
+
+    return (n);
+}
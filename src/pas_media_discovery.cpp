@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**************************************************************************
+ * @file pas_media_discovery.cpp
+ *
+ * @brief Startup media discovery
+ *
+ * At startup, media presence and identification are read for all
+ * pluggable ports before the monitor starts, instead of one port per
+ * media poll. Ports are grouped by I2C bus (see pas_port_info_t); the
+ * groups are read concurrently, ports within a group in turn. Ports with
+ * no configured bus form a single group.
+ **************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "private/pas_media_discovery.h"
+#include "private/pas_media.h"
+#include "private/pas_media_cache.h"
+#include "private/pas_media_seg.h"
+#include "private/pas_config.h"
+#include "private/pas_log.h"
+
+extern "C" uint_t dn_pas_media_discovery_run(void)
+{
+    struct pas_config_media *cfg = dn_pas_config_media_get();
+    uint_t port, count = dn_phy_media_count_get();
+
+    /* Group ports by I2C bus */
+
+    std::map<uint_t, std::vector<uint_t> > bus_map;
+
+    for (port = PAS_MEDIA_START_PORT; port <= count; ++port) {
+        if (!dn_pas_is_port_pluggable(port))  continue;
+
+        bus_map[cfg->port_info_tbl[port]->i2c_bus].push_back(port);
+    }
+
+    std::vector<std::vector<uint_t> > groups;
+
+    /* Within a bus, one I2C mux segment after another */
+
+    for (auto &it : bus_map) {
+        dn_pas_media_seg_order(it.second.data(), it.second.size());
+        groups.push_back(it.second);
+    }
+
+    if (groups.empty())  return (0);
+
+    std::atomic<size_t> next_group(0);
+    std::atomic<uint_t> present(0);
+
+    auto worker = [&]() {
+        size_t g;
+
+        while ((g = next_group++) < groups.size()) {
+            for (uint_t p : groups[g]) {
+                if (dn_pas_phy_media_discover(p))  ++present;
+            }
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+
+    size_t n = std::min<size_t>(cfg->discovery_workers, groups.size());
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < n; ++i) {
+        try {
+            threads.emplace_back(worker);
+        } catch (...) {
+            PAS_ERR("Failed to create media discovery worker %u", (uint_t) i);
+
+            break;
+        }
+    }
+
+    worker();
+
+    for (auto &t : threads)  t.join();
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - start
+                                                                    ).count();
+
+    PAS_NOTICE("Media discovery complete: %u present, %u I2C bus(es), %u worker(s), %u ms",
+               present.load(), (uint_t) groups.size(), (uint_t) (threads.size() + 1),
+               (uint_t) ms
+               );
+
+    pas_media_cache_stats_t stats;
+
+    dn_pas_media_cache_stats_get(&stats);
+    PAS_NOTICE("Media cache: info %u hit(s) %u miss(es), qualification %u hit(s) %u miss(es)",
+               (uint_t) stats.info_hits, (uint_t) stats.info_misses,
+               (uint_t) stats.qual_hits, (uint_t) stats.qual_misses
+               );
+
+    return (present);
+}
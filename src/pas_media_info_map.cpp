@@ -29,10 +29,12 @@
 #include "private/dn_pas.h"
 #include "private/pas_event.h"
 #include "private/pas_utils.h"
+#include "private/pas_media_vpn_db.h"
 #include <stdlib.h>
 
 #include <unordered_map>
 #include <iostream>
+#include <string>
 #include <string.h>
 
 #define MAX_MEDIA_INTERFACE_DISPLAY_STR_LEN 20
@@ -62,26 +64,6 @@ pas_media_disc_cb_t pas_media_get_disc_cb_from_trans_type (uint_t trans_type)
     return ( it == trans_type_to_media_disc_cb_map.end()) ? NULL : (pas_media_disc_cb_t)(it->second);
 }
 
-/* For SFP info mapping. */
-typedef struct {
-    uint_t wavelength;
-    PLATFORM_MEDIA_INTERFACE_t media_if;
-} pas_sfp_wavelength_media_if_t;
-
-static std::unordered_map<std::string, pas_sfp_wavelength_media_if_t> sfp_vpn_to_media_if_map = {
-    {"FTRJ-1519-7D-CSC",  (pas_sfp_wavelength_media_if_t){ 1550, PLATFORM_MEDIA_INTERFACE_ZX}},
-    {"FTLF1519P1BCL",     (pas_sfp_wavelength_media_if_t){ 1550, PLATFORM_MEDIA_INTERFACE_ZX}},
-    {"FTLF1519P1WCL",     (pas_sfp_wavelength_media_if_t){ 1550, PLATFORM_MEDIA_INTERFACE_ZX}},
-    {"FWDM-1619-7D-47",   (pas_sfp_wavelength_media_if_t){ 1470, PLATFORM_MEDIA_INTERFACE_CWDM}},
-    {"FWDM-1619-7D-49",   (pas_sfp_wavelength_media_if_t){ 1490, PLATFORM_MEDIA_INTERFACE_CWDM}},
-    {"FWDM-1619-7D-51",   (pas_sfp_wavelength_media_if_t){ 1510, PLATFORM_MEDIA_INTERFACE_CWDM}},
-    {"FWDM-1619-7D-53",   (pas_sfp_wavelength_media_if_t){ 1530, PLATFORM_MEDIA_INTERFACE_CWDM}},
-    {"FWDM-1619-7D-55",   (pas_sfp_wavelength_media_if_t){ 1550, PLATFORM_MEDIA_INTERFACE_CWDM}},
-    {"FWDM-1619-7D-57",   (pas_sfp_wavelength_media_if_t){ 1570, PLATFORM_MEDIA_INTERFACE_CWDM}},
-    {"FWDM-1619-7D-59",   (pas_sfp_wavelength_media_if_t){ 1590, PLATFORM_MEDIA_INTERFACE_CWDM}},
-    {"FWDM-1619-7D-61",   (pas_sfp_wavelength_media_if_t){ 1610, PLATFORM_MEDIA_INTERFACE_CWDM}}
-};
-
 static std::unordered_map<uint_t, int> sfp_id_to_media_if_map = {
     {0x01, PLATFORM_MEDIA_INTERFACE_SX},
     {0x02, PLATFORM_MEDIA_INTERFACE_LX},
@@ -93,15 +75,25 @@ static std::unordered_map<uint_t, int> sfp_id_to_media_if_map = {
     {0x80, PLATFORM_MEDIA_INTERFACE_PX}
 };
 
-bool pas_media_get_sfp_info_from_part_no (char* part_no, uint_t* wavelength, PLATFORM_MEDIA_INTERFACE_t* media_if)
+/* SFP info by vendor part number, from the vendor PN database */
+
+bool pas_media_get_sfp_info_from_part_no (char* part_no, char* rev, uint_t* wavelength, PLATFORM_MEDIA_INTERFACE_t* media_if)
 {
-    std::string s = std::string(part_no);
-    auto it = sfp_vpn_to_media_if_map.find(s);
-    if (it == sfp_vpn_to_media_if_map.end()) {
+    const pas_media_vpn_rec_t *rec = dn_pas_media_vpn_db_find(part_no, rev);
+    if (rec == NULL) {
+        return false;
+    }
+
+    /* Whole part number only, not the database's prefix match; trailing
+       blanks are not significant
+    */
+    std::string pn(part_no);
+    pn.erase(pn.find_last_not_of(' ') + 1);
+    if (pn != std::string(rec->vendor_pn, strnlen(rec->vendor_pn, sizeof(rec->vendor_pn)))) {
         return false;
     }
-    *wavelength = it->second.wavelength;
-    *media_if = it->second.media_if;
+    *wavelength = rec->wavelength;
+    *media_if = (PLATFORM_MEDIA_INTERFACE_t) rec->media_if;
     return true;
 }
 
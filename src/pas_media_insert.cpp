@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**************************************************************************
+ * @file pas_media_insert.cpp
+ *
+ * @brief Staged media insertion pipeline
+ *
+ * Inserted media are identified in stages (see pas_media_insert_stage_t).
+ * Each stage of a port runs under the PAS lock, which is released between
+ * stages; a port with stages remaining goes to the back of the queue, so
+ * mass insertions are processed interleaved, and monitor polls and CPS
+ * requests are not held off for the whole identification chain.
+ **************************************************************************/
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "private/pas_media_insert.h"
+#include "private/pas_media.h"
+#include "private/pas_config.h"
+#include "private/pas_log.h"
+
+static std::mutex                               insert_mtx;
+static std::condition_variable                  insert_cv;
+static std::deque<std::pair<uint_t, uint_t> >   insert_q;   /* (port, gen) */
+static bool                                     insert_running = false;
+
+extern "C" bool dn_pas_media_insert_async(void)
+{
+    std::lock_guard<std::mutex> lck(insert_mtx);
+
+    return (insert_running);
+}
+
+extern "C" void dn_pas_media_insert_enqueue(uint_t port, uint_t gen)
+{
+    {
+        std::lock_guard<std::mutex> lck(insert_mtx);
+
+        insert_q.push_back(std::make_pair(port, gen));
+    }
+
+    insert_cv.notify_one();
+}
+
+/* Run queued insertion stages, forever */
+
+static void dn_pas_media_insert_worker(void)
+{
+    for (;;) {
+        std::pair<uint_t, uint_t> item;
+
+        {
+            std::unique_lock<std::mutex> lck(insert_mtx);
+
+            insert_cv.wait(lck, [] { return (!insert_q.empty()); });
+
+            item = insert_q.front();
+            insert_q.pop_front();
+        }
+
+        if (dn_pas_phy_media_insert_stage_run(item.first, item.second)) {
+            /* More stages remain => Requeue behind other ports */
+
+            dn_pas_media_insert_enqueue(item.first, item.second);
+        }
+    }
+}
+
+extern "C" t_std_error dn_pas_media_insert_thread(void)
+{
+    uint_t n = dn_pas_config_media_get()->insertion_workers;
+
+    if (n == 0)  return (STD_ERR_OK); /* Insertions identified inline */
+
+    for (uint_t i = 1; i < n; ++i) {
+        try {
+            std::thread(dn_pas_media_insert_worker).detach();
+        } catch (...) {
+            PAS_ERR("Failed to create media insertion worker %u", i);
+
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lck(insert_mtx);
+
+        insert_running = true;
+    }
+
+    PAS_NOTICE("Media insertion pipeline started, %u worker(s)", n);
+
+    dn_pas_media_insert_worker();
+
+    return (STD_ERR_OK);
+}
@@ -575,13 +575,14 @@ bool dn_pas_std_media_get_basic_properties_sfp(phy_media_tbl_t *mtbl, dn_pas_bas
 
     uint_t pas_id, wavelen;
     char* part_no = (char*)(mtbl->res_data->vendor_pn);
+    char* rev = mtbl->res_data->vendor_rev;
     uint_t sdi_id = mtbl->res_data->transceiver[SFP_GIGE_XCVR_CODE_OFFSET];
 
     uint_t op_wavelength = mtbl->res_data->wavelength;
     uint_t length_sfm_km   = mtbl->res_data->length_sfm_km;
 
     media_interface_qualifier = PLATFORM_MEDIA_INTERFACE_QUALIFIER_NO_QUALIFIER;
-    if (pas_media_get_sfp_info_from_part_no(part_no, &wavelen, &media_interface) == false){
+    if (pas_media_get_sfp_info_from_part_no(part_no, rev, &wavelen, &media_interface) == false){
         pas_id = pas_media_get_sfp_media_if_from_id(sdi_id);
         if (pas_id != PLATFORM_MEDIA_INTERFACE_UNKNOWN) {
             media_interface = pas_id;
@@ -28,6 +28,7 @@
 #include "private/dn_pas.h"
 #include "private/pas_event.h"
 #include "private/pas_utils.h"
+#include "private/pas_media_cache.h"
 #include "dn_pas_media_vendor.h"
 #include <stdlib.h>
 #include "std_utils.h"
@@ -259,12 +260,10 @@ static bool pas_media_handle_proprietary_media (phy_media_tbl_t *mtbl)
 
     bool  found_prop_info  = false;
 
-    typeof(&dn_pas_media_vendor_get_info_from_proprietary_type) func = PAS_MEDIA_VENDOR_FUNC(dn_pas_media_vendor_get_info_from_proprietary_type);
-
-    if (func == NULL){
+    if (!PAS_MEDIA_VENDOR_HAS(PROPRIETARY_INFO)){
         return false;
     }
-    found_prop_info = func(mtbl->res_data->type, prop_info, &is_fake_enum, &prop_cable_len);
+    found_prop_info = pas_media_vendor_proprietary_info_get(mtbl->res_data->type, prop_info, &is_fake_enum, &prop_cable_len);
 
     if ((found_prop_info) & (mtbl->res_data->qualified)) {
         mtbl->media_info.media_interface              = prop_info->media_interface;
@@ -333,9 +332,9 @@ static bool pas_media_handle_proprietary_media (phy_media_tbl_t *mtbl)
     return proprietary_info_found;
 }
 
-/* Function to get media properties including display string, connector, cable etc */
+/* Derive media properties including display string, connector, cable etc */
 
-bool pas_media_get_media_properties(phy_media_tbl_t *mtbl)
+static bool pas_media_derive_media_properties(phy_media_tbl_t *mtbl)
 {
     dn_pas_basic_media_info_t* media_info = &(mtbl->media_info);
     media_info->transceiver_type      = 0;
@@ -458,3 +457,25 @@ bool pas_media_get_media_properties(phy_media_tbl_t *mtbl)
 
     return ret;
 }
+
+/* Function to get media properties including display string, connector, cable etc;
+   derived once per vendor part number, then taken from the media cache */
+
+bool pas_media_get_media_properties(phy_media_tbl_t *mtbl)
+{
+    pas_media_info_key_t key;
+    bool                 cacheable = dn_pas_media_cache_info_key(mtbl, &key);
+    bool                 ret;
+
+    if (cacheable && dn_pas_media_cache_info_get(&key, mtbl)) {
+        return true;
+    }
+
+    ret = pas_media_derive_media_properties(mtbl);
+
+    if (cacheable && ret) {
+        dn_pas_media_cache_info_put(&key, mtbl);
+    }
+
+    return ret;
+}
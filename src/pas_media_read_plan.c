@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: pas_media_read_plan.c
+ *
+ * Page-aware media EEPROM read planner. Reads gathered for a poll cycle
+ * are sorted by bank, page and offset, and reads of the same page lying
+ * close together are merged, so that each page is selected once, and read
+ * in as few transactions as possible.
+ */
+
+#include "private/pas_media_read_plan.h"
+#include "private/pas_media_sdi_wrapper.h"
+#include "private/pas_log.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+void dn_pas_media_read_plan_init(pas_media_read_plan_t *plan)
+{
+    plan->count = 0;
+}
+
+bool dn_pas_media_read_plan_add(pas_media_read_plan_t *plan, uint_t bank,
+                                uint_t page, uint_t offset, uint_t len,
+                                uint8_t *buf
+                                )
+{
+    pas_media_read_req_t *req;
+    bool                 lower = (page == PAS_MEDIA_READ_PLAN_LOWER_PAGE);
+
+    if (plan->count >= PAS_MEDIA_READ_PLAN_MAX_REQS
+        || len == 0
+        || bank > UINT8_MAX
+        || (lower && (bank != 0 || offset + len > 128))
+        || (!lower && (page > UINT8_MAX || offset < 128 || offset + len > 256))
+        ) {
+        return (false);
+    }
+
+    req = &plan->reqs[plan->count];
+    req->bank   = bank;
+    req->page   = page;
+    req->offset = offset;
+    req->len    = len;
+    req->buf    = buf;
+    req->seq    = plan->count;
+
+    ++plan->count;
+
+    return (true);
+}
+
+/* Order reads by bank, page and offset; lower memory first */
+
+static int dn_pas_media_read_req_cmp(const void *a, const void *b)
+{
+    const pas_media_read_req_t *ra = (const pas_media_read_req_t *) a;
+    const pas_media_read_req_t *rb = (const pas_media_read_req_t *) b;
+    bool                       la = (ra->page == PAS_MEDIA_READ_PLAN_LOWER_PAGE);
+    bool                       lb = (rb->page == PAS_MEDIA_READ_PLAN_LOWER_PAGE);
+
+    if (la != lb)                  return (la ? -1 : 1);
+    if (ra->bank != rb->bank)      return ((int) ra->bank - (int) rb->bank);
+    if (ra->page != rb->page)      return ((int) ra->page - (int) rb->page);
+    if (ra->offset != rb->offset)  return ((int) ra->offset - (int) rb->offset);
+
+    return ((int) ra->seq - (int) rb->seq);
+}
+
+/* Read one transaction, from given first to given last read, and hand out
+   the data to each read
+*/
+
+static t_std_error dn_pas_media_read_plan_xfer(sdi_resource_hdl_t res_hdl,
+                                               pas_media_read_req_t *first,
+                                               pas_media_read_req_t *last,
+                                               uint_t end
+                                               )
+{
+    uint8_t                 buf[PAS_MEDIA_READ_PLAN_MAX_XFER];
+    pas_media_read_req_t    *req;
+    t_std_error             ret;
+    sdi_media_eeprom_addr_t addr = {
+        device_addr: SDI_MEDIA_DEVICE_ADDR_AUTO,
+        page:        SDI_MEDIA_PAGE_SELECT_NOT_SUPPORTED,
+        offset:      first->offset
+    };
+
+    /* SDI addresses have no bank => Bank 0 only */
+
+    if (first->bank != 0)  return (STD_ERR(PAS, PARAM, 0));
+
+    if (first->page != PAS_MEDIA_READ_PLAN_LOWER_PAGE) {
+        addr.page = first->page;
+    }
+
+    ret = pas_sdi_media_read_generic(res_hdl, &addr, buf, end - first->offset);
+    if (ret != STD_ERR_OK)  return (ret);
+
+    for (req = first; req <= last; ++req) {
+        memcpy(req->buf, &buf[req->offset - first->offset], req->len);
+    }
+
+    return (STD_ERR_OK);
+}
+
+t_std_error dn_pas_media_read_plan_run(pas_media_read_plan_t *plan,
+                                       sdi_resource_hdl_t res_hdl,
+                                       pas_media_read_plan_stats_t *stats
+                                       )
+{
+    pas_media_read_req_t *first, *req, *end_req;
+    uint_t               end, xfers = 0, page_selects = 0, upper_reqs = 0;
+    uint_t               sel_bank = 0, sel_page = PAS_MEDIA_READ_PLAN_LOWER_PAGE;
+    t_std_error          ret = STD_ERR_OK;
+
+    if (plan->count == 0)  return (STD_ERR_OK);
+
+    qsort(plan->reqs, plan->count, sizeof(plan->reqs[0]),
+          dn_pas_media_read_req_cmp
+          );
+
+    end_req = &plan->reqs[plan->count];
+
+    for (first = plan->reqs; first < end_req && ret == STD_ERR_OK; first = req) {
+        end = first->offset + first->len;
+
+        /* Merge following reads of same page, within gap and size limits */
+
+        for (req = first + 1; req < end_req; ++req) {
+            uint_t req_end = req->offset + req->len;
+
+            if (req->bank != first->bank
+                || req->page != first->page
+                || req->offset > end + PAS_MEDIA_READ_PLAN_MERGE_GAP
+                || (req_end > end
+                    && req_end - first->offset > PAS_MEDIA_READ_PLAN_MAX_XFER)
+                ) {
+                break;
+            }
+
+            if (req_end > end)  end = req_end;
+        }
+
+        ++xfers;
+
+        /* Reads are sorted, so each page is selected once */
+
+        if (first->page != PAS_MEDIA_READ_PLAN_LOWER_PAGE
+            && (first->page != sel_page || first->bank != sel_bank)) {
+            ++page_selects;
+            sel_bank = first->bank;
+            sel_page = first->page;
+        }
+
+        ret = dn_pas_media_read_plan_xfer(res_hdl, first, req - 1, end);
+    }
+
+    for (req = plan->reqs; req < end_req; ++req) {
+        if (req->page != PAS_MEDIA_READ_PLAN_LOWER_PAGE)  ++upper_reqs;
+    }
+
+    ++stats->runs;
+    stats->reqs                    += plan->count;
+    stats->xfers                   += xfers;
+    stats->xfers_saved             += plan->count - xfers;
+    stats->page_selects            += page_selects;
+    stats->page_selects_saved      += upper_reqs - page_selects;
+    stats->last_xfers              = xfers;
+    stats->last_page_selects       = page_selects;
+    stats->last_page_selects_saved = upper_reqs - page_selects;
+
+    PAS_TRACE("Media read plan: %u reads, %u transactions, %u page selects (%u saved)",
+              plan->count, xfers, page_selects, upper_reqs - page_selects
+              );
+
+    plan->count = 0;
+
+    return (ret);
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: pas_media_seg.c
+ *
+ * Media I2C mux segments. Media EEPROMs behind an I2C mux are reached by
+ * switching the mux to their segment first; polling all ports of one
+ * segment before moving on to the next switches the mux once per segment
+ * per poll cycle, rather than on nearly every port. Segments are taken
+ * from the port configuration (i2c-bus and i2c-mux-segment); ports without
+ * them form one segment, and are polled in the original order.
+ */
+
+#include "private/pas_media_seg.h"
+#include "private/pas_config.h"
+#include "private/pas_media.h"
+#include "private/pas_telemetry.h"
+#include "private/pas_log.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    pas_media_seg_stats_t stats;
+    uint_t   bus_first;         /* First segment on the same bus */
+    uint_t   bus_sel;           /* In first segment on a bus: segment last
+                                   polled on the bus, + 1; 0 => none */
+    uint64_t cycle_polls;       /* Counters at start of poll cycle */
+    uint64_t cycle_mux_switches;
+    uint64_t cycle_poll_time_us;
+    uint_t   tlm_idx;           /* Telemetry record index + 1 */
+} pas_media_seg_t;
+
+static pas_media_seg_t *media_seg_tbl   = NULL;
+static uint_t          media_seg_cnt    = 0;
+static uint_t          *media_seg_port  = NULL;  /* Segment of each port */
+static uint_t          media_port_cnt   = 0;
+
+static uint64_t dn_pas_media_seg_now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+/* Order ports by I2C bus, mux segment and port */
+
+static int dn_pas_media_seg_cfg_cmp(const void *a, const void *b)
+{
+    struct pas_config_media *cfg = dn_pas_config_media_get();
+    uint_t                  pa   = *(const uint_t *) a;
+    uint_t                  pb   = *(const uint_t *) b;
+    const pas_port_info_t   *ia  = cfg->port_info_tbl[pa];
+    const pas_port_info_t   *ib  = cfg->port_info_tbl[pb];
+
+    if (ia->i2c_bus != ib->i2c_bus) {
+        return ((ia->i2c_bus < ib->i2c_bus) ? -1 : 1);
+    }
+    if (ia->i2c_mux_seg != ib->i2c_mux_seg) {
+        return ((ia->i2c_mux_seg < ib->i2c_mux_seg) ? -1 : 1);
+    }
+
+    return ((pa < pb) ? -1 : (pa > pb));
+}
+
+bool dn_pas_media_seg_init(void)
+{
+    struct pas_config_media *cfg = dn_pas_config_media_get();
+    const pas_port_info_t   *info, *prev = NULL;
+    pas_media_seg_t         *seg = NULL;
+    uint_t                  *sweep;         /* Ports in segment order */
+    uint_t                  sweep_cnt = 0, port, i;
+
+    dn_pas_media_seg_free();
+
+    media_port_cnt = cfg->port_count;
+    media_seg_port = calloc(media_port_cnt + 1, sizeof(*media_seg_port));
+    media_seg_tbl  = calloc(media_port_cnt + 1, sizeof(*media_seg_tbl));
+    sweep          = calloc(media_port_cnt + 1, sizeof(*sweep));
+    if (media_seg_port == NULL || media_seg_tbl == NULL || sweep == NULL) {
+        PAS_ERR("Failed to allocate media I2C segments");
+        free(sweep);
+        dn_pas_media_seg_free();
+
+        return (false);
+    }
+
+    for (port = PAS_MEDIA_START_PORT; port <= media_port_cnt; ++port) {
+        if (dn_pas_is_port_pluggable(port))  sweep[sweep_cnt++] = port;
+    }
+
+    qsort(sweep, sweep_cnt, sizeof(*sweep), dn_pas_media_seg_cfg_cmp);
+
+    for (i = 0; i < sweep_cnt; ++i) {
+        port = sweep[i];
+        info = cfg->port_info_tbl[port];
+
+        if (prev == NULL
+            || info->i2c_bus != prev->i2c_bus
+            || info->i2c_mux_seg != prev->i2c_mux_seg
+            ) {
+            seg = &media_seg_tbl[media_seg_cnt];
+            seg->stats.i2c_bus     = info->i2c_bus;
+            seg->stats.i2c_mux_seg = info->i2c_mux_seg;
+            seg->bus_first
+                = (prev != NULL && info->i2c_bus == prev->i2c_bus)
+                ? media_seg_tbl[media_seg_cnt - 1].bus_first : media_seg_cnt;
+
+            ++media_seg_cnt;
+        }
+
+        ++seg->stats.port_count;
+        media_seg_port[port] = media_seg_cnt - 1;
+        prev = info;
+    }
+
+    free(sweep);
+
+    PAS_NOTICE("Media ports: %u I2C mux segment(s)", media_seg_cnt);
+
+    return (true);
+}
+
+void dn_pas_media_seg_free(void)
+{
+    free(media_seg_tbl);
+    media_seg_tbl = NULL;
+    media_seg_cnt = 0;
+
+    free(media_seg_port);
+    media_seg_port = NULL;
+    media_port_cnt = 0;
+}
+
+/* Order ports by segment, then by given position */
+
+static int dn_pas_media_seg_pos_cmp(const void *a, const void *b)
+{
+    const uint_t *pa = (const uint_t *) a;
+    const uint_t *pb = (const uint_t *) b;
+
+    if (pa[0] != pb[0])  return ((pa[0] < pb[0]) ? -1 : 1);
+
+    return ((pa[1] < pb[1]) ? -1 : (pa[1] > pb[1]));
+}
+
+void dn_pas_media_seg_order(uint_t *ports, uint_t count)
+{
+    uint_t (*keys)[3];
+    uint_t i;
+
+    if (media_seg_port == NULL || count < 2)  return;
+
+    if ((keys = calloc(count, sizeof(*keys))) == NULL)  return;
+
+    /* Key: segment, position, port */
+
+    for (i = 0; i < count; ++i) {
+        keys[i][0] = (ports[i] <= media_port_cnt) ? media_seg_port[ports[i]] : 0;
+        keys[i][1] = i;
+        keys[i][2] = ports[i];
+    }
+
+    qsort(keys, count, sizeof(*keys), dn_pas_media_seg_pos_cmp);
+
+    for (i = 0; i < count; ++i)  ports[i] = keys[i][2];
+
+    free(keys);
+}
+
+uint64_t dn_pas_media_seg_poll_begin(uint_t port)
+{
+    pas_media_seg_t *seg, *first;
+    uint_t          idx;
+
+    if (media_seg_port == NULL || port > media_port_cnt)  return (0);
+
+    idx   = media_seg_port[port];
+    seg   = &media_seg_tbl[idx];
+    first = &media_seg_tbl[seg->bus_first];
+
+    /* Only ports behind a mux switch it */
+
+    if (seg->stats.i2c_mux_seg != PAS_MEDIA_I2C_SEG_NONE
+        && first->bus_sel != idx + 1
+        ) {
+        ++seg->stats.mux_switches;
+    }
+    first->bus_sel = idx + 1;
+
+    return (dn_pas_media_seg_now_us());
+}
+
+void dn_pas_media_seg_poll_end(uint_t port, uint64_t start)
+{
+    pas_media_seg_t *seg;
+    uint64_t        t;
+
+    if (media_seg_port == NULL || port > media_port_cnt)  return;
+
+    seg = &media_seg_tbl[media_seg_port[port]];
+    t   = dn_pas_media_seg_now_us() - start;
+
+    ++seg->stats.polls;
+    seg->stats.poll_time_us += t;
+    if (t > seg->stats.max_poll_time_us)  seg->stats.max_poll_time_us = t;
+}
+
+void dn_pas_media_seg_cycle_end(void)
+{
+    pas_media_seg_t *seg;
+    uint64_t        polls, mux_switches = 0;
+    uint_t          i;
+
+    for (i = 0; i < media_seg_cnt; ++i) {
+        seg   = &media_seg_tbl[i];
+        polls = seg->stats.polls - seg->cycle_polls;
+
+        if (polls != 0) {
+            PAS_TRACE("Media I2C bus %u segment %u: %u poll(s), %u mux switch(es), avg %u us",
+                      seg->stats.i2c_bus, seg->stats.i2c_mux_seg, (uint_t) polls,
+                      (uint_t) (seg->stats.mux_switches - seg->cycle_mux_switches),
+                      (uint_t) ((seg->stats.poll_time_us - seg->cycle_poll_time_us)
+                                / polls)
+                      );
+        }
+
+        mux_switches += seg->stats.mux_switches - seg->cycle_mux_switches;
+
+        dn_pas_telemetry_media_seg_update(&seg->tlm_idx, &seg->stats);
+
+        seg->cycle_polls        = seg->stats.polls;
+        seg->cycle_mux_switches = seg->stats.mux_switches;
+        seg->cycle_poll_time_us = seg->stats.poll_time_us;
+    }
+
+    PAS_TRACE("Media poll cycle: %u I2C mux switch(es)", (uint_t) mux_switches);
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: pas_media_topo.c
+ *
+ * Media port table topology, built at init. Both the sub-port ids and the
+ * SDI media resource handles are assigned in a single pass over the port
+ * table, so init time is linear in the port count.
+ */
+
+#include "private/pas_media_topo.h"
+
+static bool dn_pas_media_topo_is_pluggable(const struct pas_config_media *cfg,
+                                           uint_t port
+                                           )
+{
+    return (cfg->port_info_tbl[port]->port_type == PLATFORM_PORT_TYPE_PLUGGABLE);
+}
+
+void dn_pas_media_topo_sub_ports_assign(phy_media_tbl_t *tbl,
+                                        const struct pas_config_media *cfg
+                                        )
+{
+    uint_t next_logical_port = PAS_MEDIA_START_PORT;
+    uint_t port, density;
+
+    for (port = PAS_MEDIA_START_PORT; port <= cfg->port_count; ++port) {
+        for (density = 0;
+             density < cfg->port_info_tbl[port]->port_density;
+             ++density
+             ) {
+            tbl[port].sub_port_ids[density] = next_logical_port++;
+        }
+    }
+}
+
+uint_t dn_pas_media_topo_hdl_assign(phy_media_tbl_t *tbl,
+                                    const struct pas_config_media *cfg,
+                                    sdi_resource_hdl_t hdl,
+                                    uint_t *next_port
+                                    )
+{
+    uint_t port;
+
+    for (port = *next_port; port <= cfg->port_count; ++port) {
+        if (dn_pas_media_topo_is_pluggable(cfg, port)
+            && tbl[port].res_hdl == NULL
+            ) {
+            tbl[port].res_hdl = hdl;
+            *next_port = port + 1;
+
+            return (port);
+        }
+    }
+
+    *next_port = port;
+
+    return (PAS_MEDIA_INVALID_PORT);
+}
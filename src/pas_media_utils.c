@@ -23,12 +23,22 @@
 #include "private/pas_media.h"
 #include "private/pas_log.h"
 #include "private/pas_config.h"
+#include "private/pas_media_vpn_db.h"
 #include "sdi_media.h"
 #include <stdlib.h>
 
 
 #define ARRAY_SIZE(a)         (sizeof(a)/sizeof(a[0]))
 
+/*
+ * PAS_MEDIA_TYPE_ROW_HIT is given each table row a lookup matches;
+ * pas_media_type_test defines it, to check every decode row is reached.
+ */
+
+#ifndef PAS_MEDIA_TYPE_ROW_HIT
+#define PAS_MEDIA_TYPE_ROW_HIT(_row)
+#endif
+
 static uint_t dn_pas_media_pas_id_get (const sdi_to_pas_map_t *pmap,
         uint_t count, uint_t id);
 static PLATFORM_MEDIA_TYPE_t dn_pas_sfp_media_type_find (pas_media_t *res_data);
@@ -97,20 +107,6 @@ static sdi_to_pas_map_t media_type_map [] = {
     {QSFP_4X1_1000BASE_T, PLATFORM_MEDIA_TYPE_AR_4X1_1000BASE_T}
 };
 
-static const sfp_vpn_to_type_map_t media_sfp_vpn_type_tbl [] = {
-    {"FTRJ-1519-7D-CSC", 1550, PLATFORM_MEDIA_TYPE_SFP_ZX},
-    {"FTLF1519P1BCL", 1550, PLATFORM_MEDIA_TYPE_SFP_ZX},
-    {"FTLF1519P1WCL", 1550, PLATFORM_MEDIA_TYPE_SFP_ZX},
-    {"FWDM-1619-7D-47", 1470, PLATFORM_MEDIA_TYPE_SFP_CWDM},
-    {"FWDM-1619-7D-49", 1490, PLATFORM_MEDIA_TYPE_SFP_CWDM},
-    {"FWDM-1619-7D-51", 1510, PLATFORM_MEDIA_TYPE_SFP_CWDM},
-    {"FWDM-1619-7D-53", 1530, PLATFORM_MEDIA_TYPE_SFP_CWDM},
-    {"FWDM-1619-7D-55", 1550, PLATFORM_MEDIA_TYPE_SFP_CWDM},
-    {"FWDM-1619-7D-57", 1570, PLATFORM_MEDIA_TYPE_SFP_CWDM},
-    {"FWDM-1619-7D-59", 1590, PLATFORM_MEDIA_TYPE_SFP_CWDM},
-    {"FWDM-1619-7D-61", 1610, PLATFORM_MEDIA_TYPE_SFP_CWDM}
-};
-
 static const sdi_to_pas_map_t  media_sfp_gige_type_tbl [] = {
     {0x01, PLATFORM_MEDIA_TYPE_SFP_SX},
     {0x02, PLATFORM_MEDIA_TYPE_SFP_LX},
@@ -122,6 +118,165 @@ static const sdi_to_pas_map_t  media_sfp_gige_type_tbl [] = {
     {0x80, PLATFORM_MEDIA_TYPE_SFP_PX}
 };
 
+/*
+ * Media type decode tables, for non-qualified media. Where a table is
+ * given with a default type, values not listed map to the default.
+ */
+
+/* SFP BX10 by wavelength and SMF length (km) */
+
+static const struct {
+    uint_t                  wavelength;
+    uint_t                  length_sfm_km;
+    PLATFORM_MEDIA_TYPE_t   type;
+} media_sfp_bx_type_tbl [] = {
+    {0x051E, 0x0A, PLATFORM_MEDIA_TYPE_SFP_BX10_UP},
+    {0x051E, 0x28, PLATFORM_MEDIA_TYPE_SFP_BX40_UP},
+    {0x05D2, 0x50, PLATFORM_MEDIA_TYPE_SFP_BX80_UP},
+    {0x05D2, 0x0A, PLATFORM_MEDIA_TYPE_SFP_BX10_DOWN},
+    {0x05D2, 0x28, PLATFORM_MEDIA_TYPE_SFP_BX40_DOWN},
+    {0x060E, 0x50, PLATFORM_MEDIA_TYPE_SFP_BX80_DOWN}
+};
+
+/* QSFP28 optical, by compliance code (options upper byte) */
+
+static const sdi_to_pas_map_t media_qsfp28_option_type_tbl [] = {
+    {QSFP_100GBASE_AOC, PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_AOC},
+    {QSFP_100GBASE_SR4, PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_SR4},
+    {QSFP_100GBASE_LR4, PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_LR4},
+    {QSFP_100GBASE_CWDM4, PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CWDM4},
+    {QSFP_100GBASE_PSM4_IR, PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_PSM4_IR}
+};
+
+/* QSFP28 copper compliance codes */
+
+static const sdi_to_pas_map_t media_qsfp28_option_copper_tbl [] = {
+    {QSFP_100GBASE_CR4, QSFP_100GBASE_CR4},
+    {QSFP28_BRKOUT_CR_CAS, QSFP28_BRKOUT_CR_CAS},
+    {QSFP28_BRKOUT_CR_CAN, QSFP28_BRKOUT_CR_CAN}
+};
+
+/* QSFP copper cable transmitter technologies */
+
+static const sdi_to_pas_map_t media_qsfp_copper_tech_tbl [] = {
+    {QSFP_COPPER_UNEQ, QSFP_COPPER_UNEQ},
+    {QSFP_COPPER_PASSIVE_EQ, QSFP_COPPER_PASSIVE_EQ},
+    {QSFP_COPPER_NEAR_FAR_EQ, QSFP_COPPER_NEAR_FAR_EQ},
+    {QSFP_COPPER_FAR_EQ, QSFP_COPPER_FAR_EQ},
+    {QSFP_COPPER_NEAR_EQ, QSFP_COPPER_NEAR_EQ},
+    {QSFP_COPPER_LINEAR_ACTIVE, QSFP_COPPER_LINEAR_ACTIVE}
+};
+
+/* QSFP28 copper breakout, by free side device properties */
+
+static const sdi_to_pas_map_t media_qsfp28_breakout_type_tbl [] = {
+    {0x40, PLATFORM_MEDIA_TYPE_4X25_25GBASE_CR1},
+    {0x50, PLATFORM_MEDIA_TYPE_2X50_50GBASE_CR2}
+};
+
+/* QSFP28 copper, by cable length (m); default 100GBASE-CR4 */
+
+static const sdi_to_pas_map_t media_qsfp28_cr4_len_type_tbl [] = {
+    {1, PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_1M},
+    {2, PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_2M},
+    {3, PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_3M},
+    {4, PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_4M},
+    {5, PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_5M}
+};
+
+/* QSFP+, by 10/40G ethernet compliance code */
+
+static const sdi_to_pas_map_t media_qsfp_1040g_type_tbl [] = {
+    {QSFP_40GBASE_LR4, PLATFORM_MEDIA_TYPE_AR_QSFP_40GBASE_LR4},
+    {QSFP_40GBASE_SR4, PLATFORM_MEDIA_TYPE_AR_QSFP_40GBASE_SR4},
+    {QSFP_40GBASE_CR4, PLATFORM_MEDIA_TYPE_AR_QSFP_40GBASE_CR4},
+    {QSFP_40G_ACTIVE_CABLE, PLATFORM_MEDIA_TYPE_QSFP_40GBASE_AOC}
+};
+
+/* SFP+, by 10G ethernet compliance code */
+
+static const sdi_to_pas_map_t media_sfpplus_10g_type_tbl [] = {
+    {SFP_10GBASE_SR, PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_SR},
+    {SFP_10GBASE_LR, PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_LR},
+    {SFP_10GBASE_LRM, PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_LRM},
+    {SFP_10GBASE_ER, PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_ER}
+};
+
+/* SFP+ passive cable, by length (m); default 1m */
+
+static const sdi_to_pas_map_t media_sfpplus_passive_len_type_tbl [] = {
+    {1, PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU1M},
+    {2, PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU2M},
+    {3, PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU3M},
+    {5, PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU5M}
+};
+
+/* SFP+ active cable, by length (m); default 7m */
+
+static const sdi_to_pas_map_t media_sfpplus_active_len_type_tbl [] = {
+    {7, PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU7M},
+    {10, PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU10M}
+};
+
+/* SFP+ fibre channel long and short wave, by max supported speed */
+
+static const sdi_to_pas_map_t media_sfpplus_fc_lw_type_tbl [] = {
+    {BASE_IF_SPEED_8GFC, PLATFORM_MEDIA_TYPE_SFPPLUS_8GBASE_FC_LW},
+    {BASE_IF_SPEED_16GFC, PLATFORM_MEDIA_TYPE_SFPPLUS_16GBASE_FC_LW}
+};
+
+static const sdi_to_pas_map_t media_sfpplus_fc_sw_type_tbl [] = {
+    {BASE_IF_SPEED_8GFC, PLATFORM_MEDIA_TYPE_SFPPLUS_8GBASE_FC_SW},
+    {BASE_IF_SPEED_16GFC, PLATFORM_MEDIA_TYPE_SFPPLUS_16GBASE_FC_SW}
+};
+
+/* QSFP28-DD, by compliance code (options upper byte); 2xCR4 handled by length */
+
+static const sdi_to_pas_map_t media_qsfp28_dd_option_type_tbl [] = {
+    {0x02, PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_SR4},
+    {0x03, PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_2SR4_AOC},
+    {0x06, PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CWDM4},
+    {0x07, PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_PSM4_IR}
+};
+
+#define QSFP28_DD_OPTION_2CR4  0x0B
+
+/* QSFP28-DD 2xCR4, by cable length (m); default 200GBASE-CR4 */
+
+static const sdi_to_pas_map_t media_qsfp28_dd_cr4_len_type_tbl [] = {
+    {1, PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4_1M},
+    {2, PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4_2M},
+    {3, PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4_3M},
+    {5, PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4_5M}
+};
+
+/* SFP28 short reach (extended compliance 0x2), by OM3 and cable length */
+
+static const struct {
+    uint_t                  length_om3;
+    uint_t                  length_cable;
+    PLATFORM_MEDIA_TYPE_t   type;
+} media_sfp28_sr_type_tbl [] = {
+    {0x07, 0x0A, PLATFORM_MEDIA_TYPE_SFP28_25GBASE_SR},
+    {0x03, 0x04, PLATFORM_MEDIA_TYPE_SFP28_25GBASE_SR_NOF},
+    {0x14, 0x1E, PLATFORM_MEDIA_TYPE_SFP28_25GBASE_ESR}
+};
+
+/* SFP28 long reach (extended compliance 0x3), by SMF length (km) */
+
+static const sdi_to_pas_map_t media_sfp28_lr_type_tbl [] = {
+    {0x0A, PLATFORM_MEDIA_TYPE_SFP28_25GBASE_LR},
+    {0x02, PLATFORM_MEDIA_TYPE_SFP28_25GBASE_LR_LITE}
+};
+
+/* SFP28 copper extended compliance codes */
+
+static const sdi_to_pas_map_t media_sfp28_ext_type_tbl [] = {
+    {0x0B, PLATFORM_MEDIA_TYPE_SFP28_25GBASE_CR1},
+    {0x0C, PLATFORM_MEDIA_TYPE_SFP28_25GBASE_CR1},
+    {0x0D, PLATFORM_MEDIA_TYPE_SFP28_25GBASE_CR1}
+};
+
 
 static const media_type_to_breakout_map_t media_type_to_breakout_tbl[] = {
     {PLATFORM_MEDIA_TYPE_QSFPPLUS_4X16_16GBASE_FC_SW,
@@ -322,19 +477,15 @@ static PLATFORM_MEDIA_TYPE_t dn_pas_sfp_media_type_find (pas_media_t *res_data)
     PLATFORM_MEDIA_TYPE_t optics_type = PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN;
     uint_t                index;
     uint_t                pas_id, sdi_id;
+    const pas_media_vpn_rec_t *vpn_rec;
 
-    for (index = 0; index < ARRAY_SIZE(media_sfp_vpn_type_tbl); index++) {
+    vpn_rec = dn_pas_media_vpn_db_find((char *) res_data->vendor_pn,
+                                       res_data->vendor_rev);
 
-        if (strncmp(media_sfp_vpn_type_tbl[index].vendor_pn,
-                    (char *)res_data->vendor_pn,
-                    strlen(media_sfp_vpn_type_tbl[index].vendor_pn)) == 0) {
-            break;
-        }
-    }
+    if ((vpn_rec != NULL)
+            && (vpn_rec->media_type != PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN)) {
 
-    if (index < ARRAY_SIZE(media_sfp_vpn_type_tbl)) {
-
-        optics_type = media_sfp_vpn_type_tbl[index].type;
+        optics_type = vpn_rec->media_type;
 
     } else {
 
@@ -352,24 +503,14 @@ static PLATFORM_MEDIA_TYPE_t dn_pas_sfp_media_type_find (pas_media_t *res_data)
 
                 optics_type = PLATFORM_MEDIA_TYPE_SFP_ZX;
             } else if (pas_id == PLATFORM_MEDIA_TYPE_SFP_BX10) {
-                if ((res_data->wavelength == 0x051E)
-                        && (res_data->length_sfm_km == 0xA)) {
-                    optics_type = PLATFORM_MEDIA_TYPE_SFP_BX10_UP;
-                } else if ((res_data->wavelength == 0x051E)
-                        && (res_data->length_sfm_km == 0x28)) {
-                    optics_type = PLATFORM_MEDIA_TYPE_SFP_BX40_UP;
-                } else if ((res_data->wavelength == 0x05D2)
-                        && (res_data->length_sfm_km == 0x50)) {
-                    optics_type = PLATFORM_MEDIA_TYPE_SFP_BX80_UP;
-                } else if ((res_data->wavelength == 0x05D2)
-                        && (res_data->length_sfm_km == 0xA)) {
-                    optics_type = PLATFORM_MEDIA_TYPE_SFP_BX10_DOWN;
-                } else if ((res_data->wavelength == 0x05D2)
-                        && (res_data->length_sfm_km == 0x28)) {
-                    optics_type = PLATFORM_MEDIA_TYPE_SFP_BX40_DOWN;
-                } else if ((res_data->wavelength == 0x060E)
-                        && (res_data->length_sfm_km == 0x50)) {
-                    optics_type = PLATFORM_MEDIA_TYPE_SFP_BX80_DOWN;
+                for (index = 0; index < ARRAY_SIZE(media_sfp_bx_type_tbl); index++) {
+                    if ((res_data->wavelength == media_sfp_bx_type_tbl[index].wavelength)
+                            && (res_data->length_sfm_km
+                                == media_sfp_bx_type_tbl[index].length_sfm_km)) {
+                        PAS_MEDIA_TYPE_ROW_HIT(&media_sfp_bx_type_tbl[index]);
+                        optics_type = media_sfp_bx_type_tbl[index].type;
+                        break;
+                    }
                 }
             }
 
@@ -411,6 +552,7 @@ static uint_t dn_pas_media_pas_id_get (const sdi_to_pas_map_t *pmap,
 
     for (index = 0; index < count; index++) {
         if (pmap[index].sdi_id == id) {
+            PAS_MEDIA_TYPE_ROW_HIT(&pmap[index]);
             return pmap[index].pas_id;
         }
     }
@@ -462,89 +604,69 @@ BASE_IF_SPEED_t dn_pas_max_fc_supported_speed(uint8_t sfp_fc_speed)
 
 
 
+/*
+ * dn_pas_media_type_lookup returns the media type mapped from given id in
+ * given table, or given default if not listed.
+ */
+
+static PLATFORM_MEDIA_TYPE_t dn_pas_media_type_lookup (
+        const sdi_to_pas_map_t *pmap, uint_t count, uint_t id,
+        PLATFORM_MEDIA_TYPE_t dflt)
+{
+    uint_t pas_id = dn_pas_media_pas_id_get(pmap, count, id);
+
+    return ((pas_id == PAS_MEDIA_INVALID_ID)
+            ? dflt : (PLATFORM_MEDIA_TYPE_t) pas_id);
+}
+
+#define MEDIA_TYPE_LOOKUP(_tbl, _id, _dflt) \
+    dn_pas_media_type_lookup((_tbl), ARRAY_SIZE(_tbl), (_id), (_dflt))
+
+#define MEDIA_CODE_LISTED(_tbl, _id) \
+    (dn_pas_media_pas_id_get((_tbl), ARRAY_SIZE(_tbl), (_id)) \
+     != PAS_MEDIA_INVALID_ID)
+
 static PLATFORM_MEDIA_TYPE_t dn_pas_std_optics_type_get (pas_media_t *res_data)
 {
-    uint8_t transmitter_code;
+    const PLATFORM_MEDIA_TYPE_t unknown = PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN;
+    uint8_t                     transmitter_code;
+    uint_t                      code, index;
+    PLATFORM_MEDIA_TYPE_t       type;
     sdi_media_transceiver_descr_t *trans_desc =
         (sdi_media_transceiver_descr_t *) res_data->transceiver;
 
-    if (res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP28) {
-        switch ((res_data->options >> QSFP28_OPTION1_BIT_SHIFT) &
-                (QSFP28_OPTION1_BIT_MASK)) {
-            case QSFP_100GBASE_AOC:
-                return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_AOC);
-            case QSFP_100GBASE_SR4:
-                return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_SR4);
-            case QSFP_100GBASE_LR4:
-                return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_LR4);
-            case QSFP_100GBASE_CWDM4:
-                return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CWDM4);
-            case QSFP_100GBASE_PSM4_IR:
-                return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_PSM4_IR);
-            case QSFP_100GBASE_CR4:
-            case QSFP28_BRKOUT_CR_CAS:
-            case QSFP28_BRKOUT_CR_CAN:
-                if (res_data->free_side_dev_prop == 0x40) {
-                    return PLATFORM_MEDIA_TYPE_4X25_25GBASE_CR1;
-                } else if (res_data->free_side_dev_prop == 0x50) {
-                    return PLATFORM_MEDIA_TYPE_2X50_50GBASE_CR2;
-                }
-                switch (res_data->length_cable) {
-                    case 1:
-                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_1M);
-                    case 2:
-                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_2M);
-                    case 3:
-                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_3M);
-                    case 4:
-                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_4M);
-                    case 5:
-                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_5M);
-                    default:
-                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4);
-                }
-            default:
-                break;
+    switch (res_data->category) {
+    case PLATFORM_MEDIA_CATEGORY_QSFP28:
+        code = (res_data->options >> QSFP28_OPTION1_BIT_SHIFT)
+            & QSFP28_OPTION1_BIT_MASK;
+
+        type = MEDIA_TYPE_LOOKUP(media_qsfp28_option_type_tbl, code, unknown);
+        if (type != unknown)  return (type);
+
+        if (MEDIA_CODE_LISTED(media_qsfp28_option_copper_tbl, code)) {
+            type = MEDIA_TYPE_LOOKUP(media_qsfp28_breakout_type_tbl,
+                                     res_data->free_side_dev_prop, unknown);
+            if (type != unknown)  return (type);
+
+            return (MEDIA_TYPE_LOOKUP(media_qsfp28_cr4_len_type_tbl,
+                                      res_data->length_cable,
+                                      PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4));
         }
 
         transmitter_code = res_data->device_tech >> PAS_QSFP_TRANS_TECH_OFFSET;
-        switch (transmitter_code) {
-            case QSFP_COPPER_UNEQ:
-            case QSFP_COPPER_PASSIVE_EQ:
-            case QSFP_COPPER_NEAR_FAR_EQ:
-            case QSFP_COPPER_FAR_EQ:
-            case QSFP_COPPER_NEAR_EQ:
-            case QSFP_COPPER_LINEAR_ACTIVE:
-                switch (res_data->length_cable) {
-                    case 1:
-                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_1M);
-                    case 2:
-                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_2M);
-                    case 3:
-                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_3M);
-                    case 4:
-                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_4M);
-                    case 5:
-                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_5M);
-                    default:
-                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4);
-                }
-        }
-    } else if ((res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP_PLUS)
-            || (res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP)) {
-        switch (trans_desc->qsfp_descr.sdi_qsfp_eth_1040g_code) {
-
-            case QSFP_40GBASE_LR4:
-                return(PLATFORM_MEDIA_TYPE_AR_QSFP_40GBASE_LR4);
-            case QSFP_40GBASE_SR4:
-                return(PLATFORM_MEDIA_TYPE_AR_QSFP_40GBASE_SR4);
-            case QSFP_40GBASE_CR4:
-                return(PLATFORM_MEDIA_TYPE_AR_QSFP_40GBASE_CR4);
-            case QSFP_40G_ACTIVE_CABLE:
-                return (PLATFORM_MEDIA_TYPE_QSFP_40GBASE_AOC);
-            default:
-                break;
+        if (MEDIA_CODE_LISTED(media_qsfp_copper_tech_tbl, transmitter_code)) {
+            return (MEDIA_TYPE_LOOKUP(media_qsfp28_cr4_len_type_tbl,
+                                      res_data->length_cable,
+                                      PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4));
         }
+        break;
+
+    case PLATFORM_MEDIA_CATEGORY_QSFP_PLUS:
+    case PLATFORM_MEDIA_CATEGORY_QSFP:
+        type = MEDIA_TYPE_LOOKUP(media_qsfp_1040g_type_tbl,
+                                 trans_desc->qsfp_descr.sdi_qsfp_eth_1040g_code,
+                                 unknown);
+        if (type != unknown)  return (type);
 
         if ((res_data->options & QSFP28_OPTION1_BIT_MASK)
                 == QSFP_40GBASE_ER4) {
@@ -552,154 +674,94 @@ static PLATFORM_MEDIA_TYPE_t dn_pas_std_optics_type_get (pas_media_t *res_data)
         }
 
         transmitter_code = res_data->device_tech >> PAS_QSFP_TRANS_TECH_OFFSET;
-
-        switch (transmitter_code) {
-            case QSFP_COPPER_UNEQ:
-            case QSFP_COPPER_PASSIVE_EQ:
-            case QSFP_COPPER_NEAR_FAR_EQ:
-            case QSFP_COPPER_FAR_EQ:
-            case QSFP_COPPER_NEAR_EQ:
-            case QSFP_COPPER_LINEAR_ACTIVE:
-                return (PLATFORM_MEDIA_TYPE_AR_QSFP_40GBASE_CR4);
-            default:
-                break;
-        }
-    } else if (res_data->category == PLATFORM_MEDIA_CATEGORY_SFP_PLUS) {
-        /* \todo add support for handling sfp plus media type */
-
-        switch (trans_desc->sfp_descr.sdi_sfp_eth_10g_code) {
-            case SFP_10GBASE_SR:
-                return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_SR;
-            case SFP_10GBASE_LR:
-                return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_LR;
-            case SFP_10GBASE_LRM:
-                return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_LRM;
-            case SFP_10GBASE_ER:
-                return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_ER;
-            default:
-                break;
+        if (MEDIA_CODE_LISTED(media_qsfp_copper_tech_tbl, transmitter_code)) {
+            return (PLATFORM_MEDIA_TYPE_AR_QSFP_40GBASE_CR4);
         }
+        break;
+
+    case PLATFORM_MEDIA_CATEGORY_SFP_PLUS:
+        type = MEDIA_TYPE_LOOKUP(media_sfpplus_10g_type_tbl,
+                                 trans_desc->sfp_descr.sdi_sfp_eth_10g_code,
+                                 unknown);
+        if (type != unknown)  return (type);
 
         if (trans_desc->sfp_descr.sdi_sfp_plus_cable_technology
                 == SFP_PLUS_PASSIVE_CABLE) {
-            switch (res_data->length_cable) {
-                case 1:
-                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU1M;
-                case 2:
-                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU2M;
-                case 3:
-                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU3M;
-                case 5:
-                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU5M;
-                default:
-                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU1M;
-            }
-        } else if (trans_desc->sfp_descr.sdi_sfp_plus_cable_technology
+            return (MEDIA_TYPE_LOOKUP(media_sfpplus_passive_len_type_tbl,
+                                      res_data->length_cable,
+                                      PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU1M));
+        }
+        if (trans_desc->sfp_descr.sdi_sfp_plus_cable_technology
                 == SFP_PLUS_ACTIVE_CABLE) {
-            switch (res_data->length_cable) {
-                case 7:
-                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU7M;
-                case 10:
-                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU10M;
-                default:
-                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU7M;
-            }
-        } else if (trans_desc->sfp_descr.sdi_sfp_fc_media == 0x01) {
-            switch(dn_pas_max_fc_supported_speed(trans_desc->sfp_descr.sdi_sfp_fc_speed)) {
-                case BASE_IF_SPEED_8GFC:
-                    res_data->capability = BASE_IF_SPEED_8GFC;
-                    return PLATFORM_MEDIA_TYPE_SFPPLUS_8GBASE_FC_LW;
-                case BASE_IF_SPEED_16GFC:
-                    res_data->capability = BASE_IF_SPEED_16GFC;
-                    return PLATFORM_MEDIA_TYPE_SFPPLUS_16GBASE_FC_LW;
-                default:
-                    return PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN;
-            }
-        } else if (trans_desc->sfp_descr.sdi_sfp_fc_media & 0x04) {
-            switch(dn_pas_max_fc_supported_speed(trans_desc->sfp_descr.sdi_sfp_fc_speed)) {
-                case BASE_IF_SPEED_8GFC:
-                    res_data->capability = BASE_IF_SPEED_8GFC;
-                    return PLATFORM_MEDIA_TYPE_SFPPLUS_8GBASE_FC_SW;
-                case BASE_IF_SPEED_16GFC:
-                    res_data->capability = BASE_IF_SPEED_16GFC;
-                    return PLATFORM_MEDIA_TYPE_SFPPLUS_16GBASE_FC_SW;
-                default:
-                    return PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN;
+            return (MEDIA_TYPE_LOOKUP(media_sfpplus_active_len_type_tbl,
+                                      res_data->length_cable,
+                                      PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU7M));
+        }
+
+        if ((trans_desc->sfp_descr.sdi_sfp_fc_media == 0x01)
+                || (trans_desc->sfp_descr.sdi_sfp_fc_media & 0x04)) {
+            BASE_IF_SPEED_t speed =
+                dn_pas_max_fc_supported_speed(trans_desc->sfp_descr.sdi_sfp_fc_speed);
+
+            if (trans_desc->sfp_descr.sdi_sfp_fc_media == 0x01) {
+                type = MEDIA_TYPE_LOOKUP(media_sfpplus_fc_lw_type_tbl, speed,
+                                         unknown);
+            } else {
+                type = MEDIA_TYPE_LOOKUP(media_sfpplus_fc_sw_type_tbl, speed,
+                                         unknown);
             }
+            if (type != unknown)  res_data->capability = speed;
+
+            return (type);
         }
-    } else if (res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP_DD) {
-        /* \todo add extra support for handling QSFP-DD media types. */
-        uint_t length = res_data->length_cable;
+        break;
+
+    case PLATFORM_MEDIA_CATEGORY_QSFP_DD:
         /* This uses the information in the "options' field when the qualifier string fails*/
         /* Relevant data is upper byte of 32 bits */
-        switch((char)( (res_data->options >> 24) & 0xFF) ){
-            /* 2xCR4 */
-            case 0x0B:
-                switch(length){
-                    case 0x01:
-                        return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4_1M;
-                    case 0x02:
-                        return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4_2M;
-                    case 0x03:
-                        return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4_3M;
-                    case 0x05:
-                        return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4_5M;
-                    default:
-                        return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4;
-                }
-            break;
-            /* 2xSR4 */
-            case 0x02:
-                    return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_SR4;
-            break;
+        code = (res_data->options >> 24) & 0xFF;
 
-            /* 2xLR4 */
-            case 0x03:
-                return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_2SR4_AOC;
-            break;
+        if (code == QSFP28_DD_OPTION_2CR4) {
+            return (MEDIA_TYPE_LOOKUP(media_qsfp28_dd_cr4_len_type_tbl,
+                                      res_data->length_cable,
+                                      PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4));
+        }
 
-            /* 2xCWDM4 */
-            case 0x06:
-                return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CWDM4;
-            break;
+        /* Unkown or not yet supported => Unknown */
 
-            /* 2xPSM4 */
-            case 0x07:
-                return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_PSM4_IR;
-            break;
+        return (MEDIA_TYPE_LOOKUP(media_qsfp28_dd_option_type_tbl, code, unknown));
 
-            /* Unkown or not yet supported*/
-            default:
-                return PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN;
-        }
-    } else if (res_data->category == PLATFORM_MEDIA_CATEGORY_SFP28) {
-        if (res_data->ext_transceiver == 0x2) {
-            if ((res_data->length_om3 == 0x7)
-                    && (res_data->length_cable == 0xA)) {
-                return PLATFORM_MEDIA_TYPE_SFP28_25GBASE_SR;
-            } else if ((res_data->length_om3 == 0x3)
-                    && (res_data->length_cable == 0x4)) {
-                return PLATFORM_MEDIA_TYPE_SFP28_25GBASE_SR_NOF;
-            } else if ((res_data->length_om3 == 0x14)
-                    && (res_data->length_cable == 0x1E)) {
-                return PLATFORM_MEDIA_TYPE_SFP28_25GBASE_ESR;
-            }
-        } else if (res_data->ext_transceiver == 0x3) {
-            if (res_data->length_sfm_km == 0xA) {
-                return PLATFORM_MEDIA_TYPE_SFP28_25GBASE_LR;
-            } else if (res_data->length_sfm_km == 0x2) {
-                return PLATFORM_MEDIA_TYPE_SFP28_25GBASE_LR_LITE;
+    case PLATFORM_MEDIA_CATEGORY_SFP28:
+        switch (res_data->ext_transceiver) {
+        case 0x2:
+            for (index = 0; index < ARRAY_SIZE(media_sfp28_sr_type_tbl); index++) {
+                if ((res_data->length_om3 == media_sfp28_sr_type_tbl[index].length_om3)
+                        && (res_data->length_cable
+                            == media_sfp28_sr_type_tbl[index].length_cable)) {
+                    PAS_MEDIA_TYPE_ROW_HIT(&media_sfp28_sr_type_tbl[index]);
+                    return (media_sfp28_sr_type_tbl[index].type);
+                }
             }
-        } else if ((res_data->ext_transceiver == 0xB)
-                || (res_data->ext_transceiver == 0xC)
-                || (res_data->ext_transceiver == 0xD)) {
-            return PLATFORM_MEDIA_TYPE_SFP28_25GBASE_CR1;
+            break;
+
+        case 0x3:
+            return (MEDIA_TYPE_LOOKUP(media_sfp28_lr_type_tbl,
+                                      res_data->length_sfm_km, unknown));
+
+        default:
+            return (MEDIA_TYPE_LOOKUP(media_sfp28_ext_type_tbl,
+                                      res_data->ext_transceiver, unknown));
         }
-    } else if (res_data->category == PLATFORM_MEDIA_CATEGORY_DEPOP_QSFP28) {
-        return PLATFORM_MEDIA_TYPE_QSFPPLUS_50GBASE_CR2;
+        break;
+
+    case PLATFORM_MEDIA_CATEGORY_DEPOP_QSFP28:
+        return (PLATFORM_MEDIA_TYPE_QSFPPLUS_50GBASE_CR2);
+
+    default:
+        break;
     }
 
-    return (PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN);
+    return (unknown);
 }
 
 PLATFORM_MEDIA_TYPE_t dn_pas_media_type_get (pas_media_t *res_data)
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: pas_media_vpn_db.c
+ *
+ * Media vendor part number database. Optics identified by vendor part
+ * number are looked up in a sorted binary file, mapped read-only at
+ * startup, so that new part numbers can be shipped without rebuilding
+ * PAS. A small built-in table covers the part numbers PAS has always
+ * known, when no file is installed.
+ */
+
+#include "private/pas_media_vpn_db.h"
+#include "private/pas_log.h"
+#include "dell-base-platform-common.h"
+
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define ARRAY_SIZE(a)         (sizeof(a)/sizeof(a[0]))
+
+/* Built-in entries; must be kept sorted by vendor PN */
+
+static const pas_media_vpn_rec_t vpn_builtin_tbl[] = {
+    {"FTLF1519P1BCL",    "", 1550, PLATFORM_MEDIA_INTERFACE_ZX,   PLATFORM_MEDIA_TYPE_SFP_ZX},
+    {"FTLF1519P1WCL",    "", 1550, PLATFORM_MEDIA_INTERFACE_ZX,   PLATFORM_MEDIA_TYPE_SFP_ZX},
+    {"FTRJ-1519-7D-CSC", "", 1550, PLATFORM_MEDIA_INTERFACE_ZX,   PLATFORM_MEDIA_TYPE_SFP_ZX},
+    {"FWDM-1619-7D-47",  "", 1470, PLATFORM_MEDIA_INTERFACE_CWDM, PLATFORM_MEDIA_TYPE_SFP_CWDM},
+    {"FWDM-1619-7D-49",  "", 1490, PLATFORM_MEDIA_INTERFACE_CWDM, PLATFORM_MEDIA_TYPE_SFP_CWDM},
+    {"FWDM-1619-7D-51",  "", 1510, PLATFORM_MEDIA_INTERFACE_CWDM, PLATFORM_MEDIA_TYPE_SFP_CWDM},
+    {"FWDM-1619-7D-53",  "", 1530, PLATFORM_MEDIA_INTERFACE_CWDM, PLATFORM_MEDIA_TYPE_SFP_CWDM},
+    {"FWDM-1619-7D-55",  "", 1550, PLATFORM_MEDIA_INTERFACE_CWDM, PLATFORM_MEDIA_TYPE_SFP_CWDM},
+    {"FWDM-1619-7D-57",  "", 1570, PLATFORM_MEDIA_INTERFACE_CWDM, PLATFORM_MEDIA_TYPE_SFP_CWDM},
+    {"FWDM-1619-7D-59",  "", 1590, PLATFORM_MEDIA_INTERFACE_CWDM, PLATFORM_MEDIA_TYPE_SFP_CWDM},
+    {"FWDM-1619-7D-61",  "", 1610, PLATFORM_MEDIA_INTERFACE_CWDM, PLATFORM_MEDIA_TYPE_SFP_CWDM}
+};
+
+/* Mapped database file; read-only once opened, so lookups need no lock */
+
+static const pas_media_vpn_rec_t *vpn_db_recs  = NULL;
+static uint_t                    vpn_db_count = 0;
+
+/* Lookup key, as stored in a record */
+
+typedef struct {
+    char vendor_pn[PAS_MEDIA_VPN_DB_PN_LEN];
+    char vendor_rev[PAS_MEDIA_VPN_DB_REV_LEN];
+} pas_media_vpn_key_t;
+
+/* Copy given string to given key field, dropping trailing blanks */
+
+static void dn_pas_media_vpn_key_field(char *dst, uint_t len, const char *src)
+{
+    uint_t n = 0;
+
+    memset(dst, 0, len);
+    if (src == NULL)  return;
+
+    while (n < len && src[n] != 0)  ++n;
+    while (n > 0 && src[n - 1] == ' ')  --n;
+
+    memcpy(dst, src, n);
+}
+
+/* Compare given key to given record, in database order */
+
+static int dn_pas_media_vpn_key_cmp(const pas_media_vpn_key_t *key,
+                                    const pas_media_vpn_rec_t *rec
+                                    )
+{
+    int result = memcmp(key->vendor_pn, rec->vendor_pn, sizeof(key->vendor_pn));
+
+    if (result != 0)  return (result);
+
+    return (memcmp(key->vendor_rev, rec->vendor_rev, sizeof(key->vendor_rev)));
+}
+
+/* Binary search given sorted records for given key */
+
+static const pas_media_vpn_rec_t *dn_pas_media_vpn_search(
+    const pas_media_vpn_rec_t *recs,
+    uint_t                    count,
+    const pas_media_vpn_key_t *key
+                                                          )
+{
+    uint_t lo = 0, hi = count, mid;
+    int    cmp;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        cmp = dn_pas_media_vpn_key_cmp(key, &recs[mid]);
+        if (cmp == 0)  return (&recs[mid]);
+        if (cmp < 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+
+    return (NULL);
+}
+
+/* Look up given key, for given revision and then for any revision */
+
+static const pas_media_vpn_rec_t *dn_pas_media_vpn_search_rev(
+    const pas_media_vpn_rec_t *recs,
+    uint_t                    count,
+    pas_media_vpn_key_t       *key
+                                                              )
+{
+    const pas_media_vpn_rec_t *rec;
+
+    if (count == 0)  return (NULL);
+
+    rec = dn_pas_media_vpn_search(recs, count, key);
+    if (rec == NULL && key->vendor_rev[0] != 0) {
+        char rev[sizeof(key->vendor_rev)];
+
+        memcpy(rev, key->vendor_rev, sizeof(rev));
+        memset(key->vendor_rev, 0, sizeof(key->vendor_rev));
+        rec = dn_pas_media_vpn_search(recs, count, key);
+        memcpy(key->vendor_rev, rev, sizeof(rev));
+    }
+
+    return (rec);
+}
+
+/* Return index of first record with vendor PN above given one */
+
+static uint_t dn_pas_media_vpn_upper_bound(const pas_media_vpn_rec_t *recs,
+                                           uint_t count, const char *vendor_pn
+                                           )
+{
+    uint_t lo = 0, hi = count, mid;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (memcmp(vendor_pn, recs[mid].vendor_pn,
+                   sizeof(recs[mid].vendor_pn)
+                   ) < 0
+            ) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+
+    return (lo);
+}
+
+/* Look up the longest record vendor PN that is a prefix of the given key
+   vendor PN, as media vendor PNs may carry suffixes; then given revision,
+   and then any revision, of that vendor PN. A record PN that is a prefix
+   of the key is also a prefix of the key's common prefix with the closest
+   record below the key, so the search repeats for that common prefix.
+*/
+
+static const pas_media_vpn_rec_t *dn_pas_media_vpn_search_prefix(
+    const pas_media_vpn_rec_t *recs,
+    uint_t                    count,
+    const pas_media_vpn_key_t *key
+                                                                 )
+{
+    pas_media_vpn_key_t       pfx;
+    const pas_media_vpn_rec_t *rec;
+    uint_t                    len, rec_len, n, idx;
+
+    memcpy(&pfx, key, sizeof(pfx));
+
+    for (len = strnlen(key->vendor_pn, sizeof(key->vendor_pn)); len > 0; ) {
+        memset(&pfx.vendor_pn[len], 0, sizeof(pfx.vendor_pn) - len);
+
+        idx = dn_pas_media_vpn_upper_bound(recs, count, pfx.vendor_pn);
+        if (idx == 0)  break;
+
+        rec     = &recs[idx - 1];
+        rec_len = strnlen(rec->vendor_pn, sizeof(rec->vendor_pn));
+        if (rec_len == 0)  break;   /* No empty prefix matches */
+
+        for (n = 0; n < rec_len && n < len && rec->vendor_pn[n] == pfx.vendor_pn[n]; ++n);
+
+        if (n < rec_len) {
+            /* Not a prefix; n < len, as record sorts at or below key */
+
+            len = n;
+            continue;
+        }
+
+        /* Record PN is a prefix of the key, and the longest one */
+
+        memset(&pfx.vendor_pn[rec_len], 0, sizeof(pfx.vendor_pn) - rec_len);
+        rec = dn_pas_media_vpn_search_rev(recs, count, &pfx);
+        if (rec != NULL)  return (rec);
+
+        /* No record for the revision => Try shorter prefixes */
+
+        len = rec_len - 1;
+    }
+
+    return (NULL);
+}
+
+const pas_media_vpn_rec_t *dn_pas_media_vpn_db_find(const char *vendor_pn,
+                                                    const char *vendor_rev
+                                                    )
+{
+    pas_media_vpn_key_t       key;
+    const pas_media_vpn_rec_t *rec;
+
+    if (vendor_pn == NULL)  return (NULL);
+
+    dn_pas_media_vpn_key_field(key.vendor_pn, sizeof(key.vendor_pn), vendor_pn);
+    dn_pas_media_vpn_key_field(key.vendor_rev, sizeof(key.vendor_rev), vendor_rev);
+
+    rec = dn_pas_media_vpn_search_prefix(vpn_db_recs, vpn_db_count, &key);
+    if (rec != NULL)  return (rec);
+
+    return (dn_pas_media_vpn_search_prefix(vpn_builtin_tbl,
+                                           ARRAY_SIZE(vpn_builtin_tbl),
+                                           &key
+                                           )
+            );
+}
+
+void dn_pas_media_vpn_db_open(const char *filename)
+{
+    const pas_media_vpn_db_hdr_t *hdr;
+    const pas_media_vpn_rec_t    *recs;
+    struct stat                  st;
+    void                         *p;
+    uint_t                       i;
+    int                          fd;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        PAS_TRACE("No media vendor PN database %s", filename);
+
+        return;
+    }
+
+    if (fstat(fd, &st) != 0
+        || (size_t) st.st_size < sizeof(pas_media_vpn_db_hdr_t)
+        ) {
+        PAS_ERR("Media vendor PN database %s truncated", filename);
+        close(fd);
+
+        return;
+    }
+
+    p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        PAS_ERR("Failed to map media vendor PN database %s", filename);
+
+        return;
+    }
+
+    hdr  = (const pas_media_vpn_db_hdr_t *) p;
+    recs = (const pas_media_vpn_rec_t *) (hdr + 1);
+
+    if (hdr->magic != PAS_MEDIA_VPN_DB_MAGIC
+        || hdr->version != PAS_MEDIA_VPN_DB_VERSION
+        || hdr->rec_size != sizeof(pas_media_vpn_rec_t)
+        || sizeof(*hdr) + (size_t) hdr->count * sizeof(*recs)
+           != (size_t) st.st_size
+        ) {
+        PAS_ERR("Media vendor PN database %s invalid", filename);
+        munmap(p, st.st_size);
+
+        return;
+    }
+
+    /* Binary search relies on strict ordering */
+
+    for (i = 1; i < hdr->count; ++i) {
+        if (memcmp(&recs[i - 1], &recs[i],
+                   sizeof(recs->vendor_pn) + sizeof(recs->vendor_rev)
+                   ) >= 0
+            ) {
+            PAS_ERR("Media vendor PN database %s not sorted", filename);
+            munmap(p, st.st_size);
+
+            return;
+        }
+    }
+
+    vpn_db_recs  = recs;
+    vpn_db_count = hdr->count;
+
+    PAS_NOTICE("Media vendor PN database %s, %u entries", filename, vpn_db_count);
+}
@@ -27,6 +27,8 @@
 #include "private/pas_comm_dev.h"
 #include "private/pas_config.h"
 #include "private/pas_utils.h"
+#include "private/pas_nvram.h"
+#include "private/pas_media_seg.h"
 
 #include "std_utils.h"
 #include "dell-base-platform-common.h"
@@ -80,6 +82,10 @@ void populate_pollable_port_list(void)
     if ( (res) != dn_pas_config_media_get()->pluggable_media_count){
         PAS_ERR("Disparity in pluggable media counts. Check config file");
     }
+
+    /* Poll ports one I2C mux segment after another */
+
+    dn_pas_media_seg_order(pluggable_ports, res);
 }
 
 uint_t get_pollable_port(uint_t index)
@@ -183,15 +189,26 @@ static void dn_poll_comm_dev (struct timer *tmr)
 
 static void dn_poll_media(struct timer *tmr)
 {
+    static uint_t        rot;
     phy_media_tbl_t      *mtbl = NULL;
 
-    if (++tmr->cur > tmr->cnt)  tmr->cur = 1;
+    if (++tmr->cur > tmr->cnt) {
+        tmr->cur = 1;
+
+        /* New cycle; with a real time data poll budget, rotate the
+           starting port, so that deferred ports are not starved
+        */
+
+        rot = (dn_pas_config_media_get()->rtd_budget == 0) ? 0 : (rot + 1) % tmr->cnt;
+    }
 
     dn_pas_lock();
 
+    if (tmr->cur == 1)  dn_pas_phy_media_poll_cycle_start();
+
     if(!dn_pald_diag_mode_get()) {
 
-        dn_pas_phy_media_poll(get_pollable_port(tmr->cur), true);
+        dn_pas_phy_media_poll(get_pollable_port((tmr->cur - 1 + rot) % tmr->cnt + 1), true);
 
         mtbl = dn_phy_media_entry_get((tmr->cur));
 
@@ -205,8 +222,36 @@ static void dn_poll_media(struct timer *tmr)
     dn_pas_unlock();
 }
 
+/* Check copper SFP link status */
 
-enum { MAX_TIMERS = 4 };
+static void dn_poll_media_link(struct timer *tmr)
+{
+    if (++tmr->cur > tmr->cnt)  tmr->cur = 1;
+
+    dn_pas_lock();
+
+    if(!dn_pald_diag_mode_get()) {
+        dn_pas_media_sfp_t_link_poll_all();
+    }
+
+    dn_pas_unlock();
+}
+
+/* Write out coalesced NVRAM updates */
+
+static void dn_flush_nvram(struct timer *tmr)
+{
+    if (++tmr->cur > tmr->cnt)  tmr->cur = 1;
+
+    dn_pas_lock();
+
+    dn_nvram_flush(false);
+
+    dn_pas_unlock();
+}
+
+
+enum { MAX_TIMERS = 7 };
 
 static struct timer timers[MAX_TIMERS];
 
@@ -266,6 +311,16 @@ static t_std_error timerq_init(void)
         timers[num_timers].callback = dn_poll_media;
 
         ++num_timers;
+
+        /* Copper SFP link checks, at their own cadence, if configured */
+
+        if (dn_pas_config_media_get()->sfp_t_link_interval != 0) {
+            timers[num_timers].cnt      = 1;
+            timers[num_timers].period   = dn_pas_config_media_get()->sfp_t_link_interval;
+            timers[num_timers].callback = dn_poll_media_link;
+
+            ++num_timers;
+        }
     }
 
     /*
@@ -284,6 +339,19 @@ static t_std_error timerq_init(void)
         num_timers = num_timers +1 ;
     }
 
+    /* Add flushing of deferred NVRAM writes, if there is an NVRAM */
+
+    n = sdi_entity_resource_count_get(
+            sdi_entity_lookup(SDI_ENTITY_SYSTEM_BOARD, 1),
+            SDI_RESOURCE_NVRAM);
+
+    if (n > 0) {
+        timers[num_timers].cnt      = 1;
+        timers[num_timers].period   = PAS_NVRAM_FLUSH_WINDOW_MS;
+        timers[num_timers].callback = dn_flush_nvram;
+        ++num_timers;
+    }
+
     /* Set initial deadlines */
 
     for (i = 0; i < num_timers; ++i) {
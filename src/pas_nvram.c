@@ -33,6 +33,7 @@
 #include "dell-base-pas.h"
 
 #include <stdlib.h>
+#include <time.h>
 #include <zlib.h>
 
 #define ARRAY_SIZE(a)        (sizeof(a) / sizeof((a)[0]))
@@ -55,7 +56,19 @@ static pas_nvram_t nvram;
 
 #define TLV_CSUM_LEN        4
 
-/* Create an NVRAM cache record */
+static uint64_t _dn_nvram_now_ms(void)
+{
+    struct timespec ts[1];
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    return ((uint64_t) ts->tv_sec * 1000 + ts->tv_nsec / 1000000);
+}
+
+static inline uint_t _dn_nvram_tag_hash(uint64_t tag)
+{
+    return ((uint_t) ((tag ^ (tag >> 16) ^ (tag >> 32)) % PAS_NVRAM_TAG_HASH_SIZE));
+}
+
+/* Free all cached TLV entries and clear the tag index */
 
 static void _dn_nvram_free_entries(void)
 {
@@ -67,6 +80,80 @@ static void _dn_nvram_free_entries(void)
         /* Desroty (now dangling) entry */
         free(entry);
     }
+
+    if (nvram.tag_hash != 0) {
+        memset(nvram.tag_hash, 0,
+               PAS_NVRAM_TAG_HASH_SIZE * sizeof(nvram.tag_hash[0]));
+    }
+}
+
+/* Find the cached entry for the given tag */
+
+pas_nvram_entry_t *dn_nvram_entry_find(uint64_t tag)
+{
+    pas_nvram_entry_t *entry;
+
+    if (nvram.tag_hash == 0)  return (0);
+
+    for (entry = nvram.tag_hash[_dn_nvram_tag_hash(tag)];
+         entry != 0;
+         entry = entry->hash_next) {
+        if (entry->tag == tag)  return (entry);
+    }
+
+    return (0);
+}
+
+/* Add a new cached entry, at the end of the TLV list */
+
+pas_nvram_entry_t *dn_nvram_entry_add(uint64_t tag, uint64_t length, uint8_t *data)
+{
+    pas_nvram_entry_t *entry;
+    uint_t            h;
+
+    if (nvram.tag_hash == 0)  return (0);
+
+    entry = CALLOC_T(pas_nvram_entry_t, 1);
+    if (entry == 0)  return (0);
+
+    /* Length limit the data size */
+    if (length > sizeof(entry->data)) {
+        length = sizeof(entry->data);
+    }
+    entry->tag    = tag;
+    entry->length = length;
+    memcpy(entry->data, data, length);
+
+    h = _dn_nvram_tag_hash(tag);
+    entry->hash_next = nvram.tag_hash[h];
+    nvram.tag_hash[h] = entry;
+
+    std_dll_insertatback(&nvram.nvram_data, (std_dll *)entry);
+
+    return (entry);
+}
+
+/* Remove a cached entry from the TLV list and tag index, and free it */
+
+void dn_nvram_entry_del(pas_nvram_entry_t *entry)
+{
+    pas_nvram_entry_t **p;
+
+    if (entry == 0)  return;
+
+    if (nvram.tag_hash != 0) {
+        for (p = &nvram.tag_hash[_dn_nvram_tag_hash(entry->tag)];
+             *p != 0;
+             p = &(*p)->hash_next) {
+            if (*p == entry) {
+                *p = entry->hash_next;
+                break;
+            }
+        }
+    }
+
+    std_dll_remove(&nvram.nvram_data, (std_dll *)entry);
+    free(entry);
 }
 
 /* Initialize the NVRAM cache, for calling from the CPS handlers */
@@ -104,6 +191,13 @@ void dn_cache_init_nvram(
     nvram.sdi_resource_hdl = sdi_resource_hdl;
 
     std_dll_init(&nvram.nvram_data);
+
+    nvram.tag_hash = CALLOC_T(pas_nvram_entry_t *, PAS_NVRAM_TAG_HASH_SIZE);
+    if (nvram.tag_hash == 0) {
+        PAS_ERR("Insufficient memory for NVRAM tag index");
+        return;
+    }
+
     nvram.initialized = true;
 
     if (sdi_nvram_size(sdi_resource_hdl, &size) == STD_ERR_OK) {
@@ -115,6 +209,11 @@ void dn_cache_init_nvram(
         nvram.tlv_size = 0;
     }
 
+    nvram.dirty        = false;
+    nvram.shadow_valid = false;
+    nvram.shadow_len   = 0;
+    nvram.shadow       = CALLOC_T(uint8_t, nvram.nvram_size + 1);
+
     dn_nvram_parse();
 }
 
@@ -122,10 +221,20 @@ void dn_cache_init_nvram(
 
 void dn_cache_del_nvram(pas_entity_t *parent)
 {
+    /* Do not lose pending updates */
+    dn_nvram_flush(true);
+
     nvram.parent = NULL;
     nvram.sdi_resource_hdl = NULL;
 
     _dn_nvram_free_entries();
+
+    free(nvram.tag_hash);
+    nvram.tag_hash = NULL;
+    free(nvram.shadow);
+    nvram.shadow = NULL;
+    nvram.shadow_valid = false;
+    nvram.initialized = false;
 }
 
 /* Return the NVRAM cache record */
@@ -149,6 +258,8 @@ void dn_nvram_parse(void)
     uint8_t buf[nvram.nvram_size];
 
     _dn_nvram_free_entries();
+    nvram.shadow_valid = false;
+    nvram.dirty = false;
 
     do {
         /* Read NVRAM contents into memory */
@@ -203,37 +314,36 @@ void dn_nvram_parse(void)
         for (data_p = &buf[TLV_DATA_OFFS]; data_p;
              data_p = std_tlv_next(data_p, &remaining)) {
 
-            pas_nvram_entry_t *entry = calloc(1, sizeof(*entry));
-            if (!entry) {
+            /* Add the entry to the end of the list, and index it */
+            if (dn_nvram_entry_add(std_tlv_tag(data_p), std_tlv_len(data_p),
+                                   std_tlv_data(data_p)) == 0) {
                 /* Insufficient memory to save the data, return early */
                 PAS_ERR("Insufficient memory to save NVRAM data");
                 break;
             }
+        }
 
-            entry->tag = std_tlv_tag(data_p);
-            entry->length = std_tlv_len(data_p);
-
-            /* Length limit the data size */
-            if (entry->length > sizeof(entry->data)) {
-               entry->length = sizeof(entry->data);
-            }
-
-            /* Copy the data to the entry */
-            memcpy(entry->data, std_tlv_data(data_p), entry->length);
-
-            /* Add the entry to the end of the list */
-            std_dll_insertatback(&nvram.nvram_data, (std_dll *)entry);
+        /* Remember what is on the NVRAM, so that later writes can be
+           limited to the bytes that change
+        */
+        if (nvram.shadow != 0) {
+            memcpy(nvram.shadow, buf, count + TLV_CSUM_LEN);
+            nvram.shadow_len   = count + TLV_CSUM_LEN;
+            nvram.shadow_valid = true;
         }
     } while(0);
 }
 
-/* Save the individual entries in TLV format */
-void dn_nvram_write(void)
+/* Serialize the cached entries in TLV format into the given image buffer,
+   which must be nvram_size bytes. Returns the number of bytes in the image,
+   including the checksum, or 0 on failure.
+*/
+
+static size_t _dn_nvram_image_build(uint8_t *nvram_data)
 {
     unsigned long checksum;
     uint8_t tmpbuf[16];
 
-    uint8_t nvram_data[nvram.nvram_size];
     uint8_t *data_p;
 
     size_t count;
@@ -260,7 +370,7 @@ void dn_nvram_write(void)
 
         if (!data_p) {
             /* TLV Add encountered an error, abort */
-            return;
+            return (0);
         }
     }
 
@@ -281,7 +391,122 @@ void dn_nvram_write(void)
     tmpbuf[3] = (checksum & 0xFF);
     memcpy(&nvram_data[count], tmpbuf, TLV_CSUM_LEN);
 
-    /* Write the data to NVRAM */
-    sdi_nvram_write(nvram.sdi_resource_hdl, nvram_data,
-                    TLV_MAGIC_OFFS, count + TLV_CSUM_LEN);
+    return (count + TLV_CSUM_LEN);
+}
+
+/* Write the given byte range of the image to NVRAM */
+
+static bool _dn_nvram_range_write(uint8_t *nvram_data, size_t offs, size_t len)
+{
+    if (len == 0)  return (true);
+
+    if (STD_IS_ERR(sdi_nvram_write(nvram.sdi_resource_hdl, &nvram_data[offs],
+                                   offs, len))) {
+        PAS_ERR("Error writing NVRAM, offset %u, length %u",
+                (uint_t) offs, (uint_t) len);
+        return (false);
+    }
+
+    return (true);
+}
+
+/* Mark the cached entries as changed. The NVRAM itself is written by
+   dn_nvram_flush(), so that a burst of updates results in a single write.
+*/
+
+void dn_nvram_write(void)
+{
+    if (!nvram.dirty) {
+        nvram.dirty       = true;
+        nvram.dirty_since = _dn_nvram_now_ms();
+    }
+}
+
+/* Write pending changes to NVRAM. Only the changed TLV bytes, the count
+   header and the checksum are written, when the previous image is known.
+*/
+
+void dn_nvram_flush(bool force)
+{
+    uint8_t nvram_data[nvram.nvram_size + 1];
+    size_t  len, count, first, last;
+    bool    ok = true;
+
+    if (!nvram.initialized || !nvram.dirty)  return;
+    if (!force
+        && (_dn_nvram_now_ms() - nvram.dirty_since) < PAS_NVRAM_FLUSH_WINDOW_MS
+        ) {
+        return;
+    }
+
+    nvram.dirty = false;
+
+    if (nvram.nvram_size == 0 || nvram.sdi_resource_hdl == 0)  return;
+
+    if ((len = _dn_nvram_image_build(nvram_data)) == 0) {
+        PAS_ERR("NVRAM data exceeds capacity, not written");
+        return;
+    }
+    count = len - TLV_CSUM_LEN;
+
+    if (!nvram.shadow_valid || nvram.shadow == 0) {
+        /* Previous contents unknown => write the whole image */
+        ok = _dn_nvram_range_write(nvram_data, TLV_MAGIC_OFFS, len);
+    } else {
+        /* Locate the changed TLV data, if any; bytes beyond the previous
+           image always count as changed
+        */
+        for (first = TLV_DATA_OFFS; first < count; ++first) {
+            if (first >= nvram.shadow_len
+                || nvram_data[first] != nvram.shadow[first]) {
+                break;
+            }
+        }
+        for (last = count; last > first; --last) {
+            if (last - 1 >= nvram.shadow_len
+                || nvram_data[last - 1] != nvram.shadow[last - 1]) {
+                break;
+            }
+        }
+
+        if (first == count && len == nvram.shadow_len
+            && memcmp(&nvram_data[count], &nvram.shadow[count], TLV_CSUM_LEN) == 0
+            ) {
+            /* Nothing changed on the device */
+            return;
+        }
+
+        /* Data first, then count and checksum, so that a partial update
+           is caught by the checksum on the next parse
+        */
+        ok = _dn_nvram_range_write(nvram_data, first, last - first);
+        if (ok && memcmp(&nvram_data[TLV_COUNT_OFFS],
+                         &nvram.shadow[TLV_COUNT_OFFS], TLV_COUNT_LEN) != 0) {
+            ok = _dn_nvram_range_write(nvram_data, TLV_COUNT_OFFS, TLV_COUNT_LEN);
+        }
+        if (ok) {
+            ok = _dn_nvram_range_write(nvram_data, count, TLV_CSUM_LEN);
+        }
+    }
+
+    if (!ok) {
+        /* Device state unknown => rewrite fully next time */
+        nvram.shadow_valid = false;
+        nvram.dirty        = true;
+        nvram.dirty_since  = _dn_nvram_now_ms();
+        return;
+    }
+
+    if (nvram.shadow != 0) {
+        memcpy(nvram.shadow, nvram_data, len);
+        nvram.shadow_len   = len;
+        nvram.shadow_valid = true;
+    }
+}
+
+/* Forget the last known NVRAM image */
+
+void dn_nvram_shadow_invalidate(void)
+{
+    nvram.shadow_valid = false;
 }
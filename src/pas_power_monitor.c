@@ -20,6 +20,7 @@
 #include "private/pas_event.h"
 #include "private/pas_config.h"
 #include "private/pas_utils.h"
+#include "private/pas_telemetry.h"
 #include "private/dn_pas.h"
 
 #include "std_type_defs.h"
@@ -134,5 +135,7 @@ bool dn_power_monitor_poll(pas_power_monitor_t *rec)
 
     } while (0);
 
+    dn_pas_telemetry_power_monitor_update(rec);
+
     return (true);
 }
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**************************************************************************
+ * @file pas_publish_policy.cpp
+ *
+ * @brief Deadband and rate-limit policy for analog values in published
+ *        events
+ **************************************************************************/
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "private/pas_publish_policy.h"
+#include "private/pas_event_seq.h"
+#include "private/pas_config.h"
+#include "private/pas_data_store.h"
+#include "private/pas_log.h"
+#include "dn_pas_event_seq.h"
+
+#include "cps_api_key.h"
+#include "cps_class_map.h"
+#include "dell-base-pas.h"
+
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+/* Attributes of each analog metric class */
+
+static const struct {
+    cps_api_attr_id_t attr;
+    uint_t            metric;
+} publish_policy_attr_tbl[] = {
+    { BASE_PAS_TEMPERATURE_TEMPERATURE,      PAS_METRIC_TEMPERATURE },
+    { BASE_PAS_MEDIA_CURRENT_TEMPERATURE,    PAS_METRIC_MEDIA_TEMPERATURE },
+    { BASE_PAS_MEDIA_CURRENT_VOLTAGE,        PAS_METRIC_MEDIA_VOLTAGE },
+    { BASE_PAS_MEDIA_CHANNEL_RX_POWER,       PAS_METRIC_MEDIA_RX_POWER },
+    { BASE_PAS_MEDIA_CHANNEL_TX_POWER,       PAS_METRIC_MEDIA_TX_POWER },
+    { BASE_PAS_MEDIA_CHANNEL_TX_BIAS_CURRENT, PAS_METRIC_MEDIA_TX_BIAS }
+};
+
+/* Last published state of an object instance */
+
+struct publish_policy_inst {
+    cps_api_object_t                      last;      /* Last published attributes */
+    std::map<cps_api_attr_id_t, uint64_t> pub_time;  /* Last publish time of
+                                                        each analog attribute */
+};
+
+static std::mutex                                        policy_lock;
+static std::map<std::string, publish_policy_inst>        policy_insts;
+
+/* Return monotonic time, in ms */
+
+static uint64_t dn_pas_publish_policy_now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+/* Return configured policy for given attribute, or 0 if none */
+
+static struct pas_config_publish_policy *dn_pas_publish_policy_find(cps_api_attr_id_t attr)
+{
+    struct pas_config_publish_policy *p;
+    size_t                           i;
+
+    for (i = 0; i < sizeof(publish_policy_attr_tbl) / sizeof(publish_policy_attr_tbl[0]); ++i) {
+        if (publish_policy_attr_tbl[i].attr == attr) {
+            p = dn_pas_config_publish_policy_get(publish_policy_attr_tbl[i].metric);
+
+            return (p != 0 && p->valid ? p : 0);
+        }
+    }
+
+    return (0);
+}
+
+/* Test if any metric class has a policy configured */
+
+static bool dn_pas_publish_policy_any(void)
+{
+    uint_t i;
+
+    for (i = 0; i < PAS_METRIC_MAX; ++i) {
+        if (dn_pas_config_publish_policy_get(i)->valid)  return (true);
+    }
+
+    return (false);
+}
+
+/* Return value of an analog attribute; temperatures are 16-bit signed
+   integers, DOM values are doubles
+*/
+
+static double dn_pas_publish_policy_val(cps_api_object_attr_t a)
+{
+    double d;
+
+    switch (cps_api_object_attr_len(a)) {
+    case sizeof(uint16_t):
+        return ((int16_t) cps_api_object_attr_data_u16(a));
+
+    case sizeof(uint32_t):
+        return ((int32_t) cps_api_object_attr_data_u32(a));
+
+    case sizeof(double):
+        memcpy(&d, cps_api_object_attr_data_bin(a), sizeof(d));
+
+        return (d);
+
+    default:
+        break;
+    }
+
+    return (0);
+}
+
+/* Test if attribute differs from the same attribute in given object */
+
+static bool dn_pas_publish_policy_attr_changed(cps_api_object_attr_t a,
+                                               cps_api_object_t      last
+                                               )
+{
+    cps_api_object_attr_t b;
+
+    b = cps_api_object_attr_get(last, cps_api_object_attr_id(a));
+
+    return (b == CPS_API_ATTR_NULL
+            || cps_api_object_attr_len(a) != cps_api_object_attr_len(b)
+            || memcmp(cps_api_object_attr_data_bin(a),
+                      cps_api_object_attr_data_bin(b),
+                      cps_api_object_attr_len(a)
+                      ) != 0
+            );
+}
+
+/* Test if an analog attribute is to be published, per its policy */
+
+static bool dn_pas_publish_policy_attr_ok(struct pas_config_publish_policy *p,
+                                          cps_api_object_attr_t            a,
+                                          publish_policy_inst              &inst,
+                                          uint64_t                         now
+                                          )
+{
+    cps_api_attr_id_t     id = cps_api_object_attr_id(a);
+    cps_api_object_attr_t b;
+    double                v, last, d;
+
+    auto it = inst.pub_time.find(id);
+    b = cps_api_object_attr_get(inst.last, id);
+    if (it == inst.pub_time.end() || b == CPS_API_ATTR_NULL)  return (true);
+
+    if (now - it->second < p->min_interval)  return (false);
+
+    if (p->refresh_interval != 0 && now - it->second >= p->refresh_interval) {
+        return (true);
+    }
+
+    v    = dn_pas_publish_policy_val(a);
+    last = dn_pas_publish_policy_val(b);
+    d    = fabs(v - last);
+
+    if (isnan(v) != isnan(last))  return (true);
+
+    return (d > p->abs_deadband && d > p->rel_deadband / 100 * fabs(last));
+}
+
+bool dn_pas_publish_policy_apply(cps_api_object_t obj)
+{
+    std::vector<cps_api_object_attr_t> analog;
+    std::vector<cps_api_attr_id_t>     suppress;
+    cps_api_object_it_t                it;
+    cps_api_object_attr_t              a;
+    cps_api_attr_id_t                  id;
+    char                               key[PAS_CPS_KEY_STR_LEN];
+    bool                               other_changed = false;
+    uint64_t                           now;
+
+    if (!dn_pas_publish_policy_any())  return (true);
+
+    if (!dn_pas_event_inst_key(obj, key, sizeof(key)))  return (true);
+
+    std::lock_guard<std::mutex> lg(policy_lock);
+
+    publish_policy_inst &inst = policy_insts[key];
+
+    if (inst.last == CPS_API_OBJECT_NULL) {
+        inst.last = cps_api_object_create();
+        if (inst.last == CPS_API_OBJECT_NULL)  return (true);
+
+        other_changed = true;
+    }
+
+    /* Any change to a non-analog attribute, e.g. a state, is published
+       as is; otherwise, the policy decides for each analog attribute
+    */
+
+    for (cps_api_object_it_begin(obj, &it);
+         cps_api_object_it_valid(&it);
+         cps_api_object_it_next(&it)
+         ) {
+        a  = it.attr;
+        id = cps_api_object_attr_id(a);
+
+        if (id == DN_PAS_ATTR_EVENT_SEQ || dn_pas_event_key_attr_is(obj, id))  continue;
+
+        if (dn_pas_publish_policy_find(id) != 0) {
+            analog.push_back(a);
+        } else if (dn_pas_publish_policy_attr_changed(a, inst.last)) {
+            other_changed = true;
+        }
+    }
+
+    now = dn_pas_publish_policy_now_ms();
+
+    if (!other_changed && !analog.empty()) {
+        for (auto b : analog) {
+            if (!dn_pas_publish_policy_attr_ok(dn_pas_publish_policy_find(cps_api_object_attr_id(b)),
+                                               b,
+                                               inst,
+                                               now
+                                               )
+                ) {
+                suppress.push_back(cps_api_object_attr_id(b));
+            }
+        }
+
+        if (suppress.size() == analog.size()) {
+            /* Nothing significant => Suppress event */
+
+            return (false);
+        }
+
+        for (auto s : suppress)  cps_api_object_attr_delete(obj, s);
+    }
+
+    /* Record what is published */
+
+    for (cps_api_object_it_begin(obj, &it);
+         cps_api_object_it_valid(&it);
+         cps_api_object_it_next(&it)
+         ) {
+        id = cps_api_object_attr_id(it.attr);
+
+        if (dn_pas_publish_policy_find(id) != 0)  inst.pub_time[id] = now;
+    }
+
+    cps_api_object_attr_merge(inst.last, obj, true);
+
+    return (true);
+}
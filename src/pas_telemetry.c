@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * filename: pas_telemetry.c
+ *
+ * Shared-memory telemetry region writer
+ */
+
+#include "private/pas_telemetry.h"
+#include "private/pas_utils.h"
+#include "private/pas_log.h"
+#include "dn_pas_telemetry.h"
+#include "std_time_tools.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static dn_pas_telemetry_hdr_t *tlm_hdr;
+
+bool dn_pas_telemetry_init(void)
+{
+    size_t size = sizeof(dn_pas_telemetry_hdr_t)
+        + DN_PAS_TELEMETRY_MAX_RECS * sizeof(dn_pas_telemetry_rec_t);
+    void   *p;
+    int    fd;
+
+    fd = shm_open(DN_PAS_TELEMETRY_SHM_NAME, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        PAS_ERR("Failed to open telemetry region");
+
+        return (false);
+    }
+
+    if (ftruncate(fd, size) != 0) {
+        PAS_ERR("Failed to size telemetry region");
+        close(fd);
+
+        return (false);
+    }
+
+    p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        PAS_ERR("Failed to map telemetry region");
+
+        return (false);
+    }
+
+    tlm_hdr = (dn_pas_telemetry_hdr_t *) p;
+
+    /* Region may be left over from a previous run, and mapped by readers;
+       empty the table before touching anything else
+    */
+
+    __atomic_store_n(&tlm_hdr->num_recs, 0, __ATOMIC_RELEASE);
+
+    tlm_hdr->version  = DN_PAS_TELEMETRY_VERSION;
+    tlm_hdr->rec_size = sizeof(dn_pas_telemetry_rec_t);
+    tlm_hdr->max_recs = DN_PAS_TELEMETRY_MAX_RECS;
+    __atomic_add_fetch(&tlm_hdr->generation, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&tlm_hdr->magic, DN_PAS_TELEMETRY_MAGIC, __ATOMIC_RELEASE);
+
+    return (true);
+}
+
+/* Start an update of the record for the given resource, allocating it on
+   first use; *tlm_idx caches the record index (+ 1) in the resource's cache
+   record
+*/
+
+static dn_pas_telemetry_rec_t *dn_pas_telemetry_rec_begin(
+    uint_t                   *tlm_idx,
+    dn_pas_telemetry_class_t cls,
+    uint_t                   entity_type,
+    uint_t                   slot,
+    uint_t                   idx,
+    uint_t                   channel,
+    const char               *name
+                                                          )
+{
+    dn_pas_telemetry_rec_t *rec;
+    uint_t                 i, n;
+
+    if (tlm_hdr == NULL)  return (NULL);
+
+    n = tlm_hdr->num_recs;
+
+    if (*tlm_idx == 0) {
+        /* Resource may have been deleted and re-created; reuse its record */
+
+        for (i = 0; i < n; ++i) {
+            rec = &tlm_hdr->recs[i];
+
+            if (rec->cls == (uint32_t) cls && rec->entity_type == entity_type
+                && rec->slot == slot && rec->idx == idx
+                && rec->channel == channel
+                ) {
+                *tlm_idx = i + 1;
+
+                break;
+            }
+        }
+    }
+
+    if (*tlm_idx == 0) {
+        if (n >= tlm_hdr->max_recs)  return (NULL);
+
+        rec = &tlm_hdr->recs[n];
+
+        __atomic_store_n(&rec->seq, rec->seq | 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+
+        /* Slot may hold a record from before the table was last emptied */
+
+        memset(&rec->cls, 0, sizeof(*rec) - offsetof(dn_pas_telemetry_rec_t, cls));
+
+        rec->cls         = cls;
+        rec->entity_type = entity_type;
+        rec->slot        = slot;
+        rec->idx         = idx;
+        rec->channel     = channel;
+
+        *tlm_idx = n + 1;
+
+        __atomic_store_n(&tlm_hdr->num_recs, n + 1, __ATOMIC_RELEASE);
+    } else {
+        rec = &tlm_hdr->recs[*tlm_idx - 1];
+
+        __atomic_store_n(&rec->seq, rec->seq + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+    }
+
+    if (name != NULL)  STRLCPY(rec->name, name);
+    rec->poll_time = std_time_get_current_from_epoch_in_nanoseconds();
+
+    return (rec);
+}
+
+/* Finish an update of a record */
+
+static void dn_pas_telemetry_rec_end(dn_pas_telemetry_rec_t *rec)
+{
+    __atomic_store_n(&rec->seq, rec->seq + 1, __ATOMIC_RELEASE);
+}
+
+void dn_pas_telemetry_entity_update(pas_entity_t *rec)
+{
+    dn_pas_telemetry_rec_t *t;
+
+    t = dn_pas_telemetry_rec_begin(&rec->tlm_idx,
+                                   DN_PAS_TELEMETRY_CLASS_ENTITY,
+                                   rec->entity_type, rec->slot, 0, 0,
+                                   rec->name
+                                   );
+    if (t == NULL)  return;
+
+    t->valid       = rec->valid;
+    t->present     = rec->present;
+    t->oper_status = rec->oper_fault_state->oper_status;
+    t->fault_type  = rec->oper_fault_state->fault_type;
+
+    dn_pas_telemetry_rec_end(t);
+}
+
+void dn_pas_telemetry_fan_update(pas_fan_t *rec)
+{
+    dn_pas_telemetry_rec_t *t;
+
+    t = dn_pas_telemetry_rec_begin(&rec->tlm_idx,
+                                   DN_PAS_TELEMETRY_CLASS_FAN,
+                                   rec->parent->entity_type, rec->parent->slot,
+                                   rec->fan_idx, 0,
+                                   NULL
+                                   );
+    if (t == NULL)  return;
+
+    t->valid              = rec->valid;
+    t->present            = rec->parent->present;
+    t->oper_status        = rec->oper_fault_state->oper_status;
+    t->fault_type         = rec->oper_fault_state->fault_type;
+    t->u.fan.obs_speed    = rec->obs_speed;
+    t->u.fan.targ_speed   = rec->targ_speed;
+    t->u.fan.max_speed    = rec->max_speed;
+
+    dn_pas_telemetry_rec_end(t);
+}
+
+void dn_pas_telemetry_temp_sensor_update(pas_temperature_sensor_t *rec)
+{
+    dn_pas_telemetry_rec_t *t;
+
+    t = dn_pas_telemetry_rec_begin(&rec->tlm_idx,
+                                   DN_PAS_TELEMETRY_CLASS_TEMPERATURE,
+                                   rec->parent->entity_type, rec->parent->slot,
+                                   rec->sensor_idx, 0,
+                                   rec->name
+                                   );
+    if (t == NULL)  return;
+
+    t->valid             = rec->valid;
+    t->present           = rec->parent->present;
+    t->oper_status       = rec->oper_fault_state->oper_status;
+    t->fault_type        = rec->oper_fault_state->fault_type;
+    t->u.temperature.cur = rec->cur;
+
+    dn_pas_telemetry_rec_end(t);
+}
+
+void dn_pas_telemetry_power_monitor_update(pas_power_monitor_t *rec)
+{
+    dn_pas_telemetry_rec_t *t;
+
+    t = dn_pas_telemetry_rec_begin(&rec->tlm_idx,
+                                   DN_PAS_TELEMETRY_CLASS_POWER_MONITOR,
+                                   rec->parent->entity_type, rec->parent->slot,
+                                   rec->pm_idx, 0,
+                                   NULL
+                                   );
+    if (t == NULL)  return;
+
+    t->valid                   = rec->valid;
+    t->present                 = rec->parent->present;
+    t->oper_status             = rec->oper_fault_state->oper_status;
+    t->fault_type              = rec->oper_fault_state->fault_type;
+    t->u.power_monitor.voltage = rec->obs_pm_voltage_volt;
+    t->u.power_monitor.current = rec->obs_pm_current_amp;
+    t->u.power_monitor.power   = rec->obs_pm_power_watt;
+
+    dn_pas_telemetry_rec_end(t);
+}
+
+void dn_pas_telemetry_media_update(uint_t port, pas_media_t *rec,
+                                   const pas_media_read_plan_stats_t *read_stats
+                                   )
+{
+    dn_pas_telemetry_rec_t *t;
+    uint_t                 slot;
+
+    dn_pas_myslot_get(&slot);
+
+    t = dn_pas_telemetry_rec_begin(&rec->tlm_idx,
+                                   DN_PAS_TELEMETRY_CLASS_MEDIA,
+                                   0, slot, port, 0,
+                                   NULL
+                                   );
+    if (t == NULL)  return;
+
+    t->valid               = rec->valid;
+    t->present             = rec->present;
+    t->oper_status         = rec->oper_status;
+    t->fault_type          = rec->fault_type;
+    t->u.media.temperature = rec->current_temperature;
+    t->u.media.voltage     = rec->current_voltage;
+
+    t->u.media.read_xfers              = read_stats->xfers;
+    t->u.media.read_xfers_saved        = read_stats->xfers_saved;
+    t->u.media.read_page_selects       = read_stats->page_selects;
+    t->u.media.read_page_selects_saved = read_stats->page_selects_saved;
+
+    dn_pas_telemetry_rec_end(t);
+}
+
+void dn_pas_telemetry_media_channel_update(uint_t port,
+                                           uint_t channel,
+                                           pas_media_channel_t *rec
+                                           )
+{
+    dn_pas_telemetry_rec_t *t;
+    uint_t                 slot;
+
+    dn_pas_myslot_get(&slot);
+
+    t = dn_pas_telemetry_rec_begin(&rec->tlm_idx,
+                                   DN_PAS_TELEMETRY_CLASS_MEDIA_CHANNEL,
+                                   0, slot, port, channel,
+                                   NULL
+                                   );
+    if (t == NULL)  return;
+
+    t->valid                     = true;
+    t->present                   = true;
+    t->oper_status               = rec->oper_status;
+    t->u.media_channel.rx_power  = rec->rx_power;
+    t->u.media_channel.tx_power  = rec->tx_power;
+    t->u.media_channel.tx_bias   = rec->tx_bias_current;
+    t->u.media_channel.state     = rec->state;
+    t->u.media_channel.rx_loss   = rec->rx_loss;
+    t->u.media_channel.tx_loss   = rec->tx_loss;
+    t->u.media_channel.tx_fault  = rec->tx_fault;
+
+    dn_pas_telemetry_rec_end(t);
+}
+
+void dn_pas_telemetry_media_seg_update(uint_t *tlm_idx,
+                                       const pas_media_seg_stats_t *stats
+                                       )
+{
+    dn_pas_telemetry_rec_t *t;
+    uint_t                 slot;
+
+    dn_pas_myslot_get(&slot);
+
+    t = dn_pas_telemetry_rec_begin(tlm_idx,
+                                   DN_PAS_TELEMETRY_CLASS_MEDIA_SEGMENT,
+                                   0, slot, stats->i2c_bus, stats->i2c_mux_seg,
+                                   NULL
+                                   );
+    if (t == NULL)  return;
+
+    t->valid                            = true;
+    t->present                          = true;
+    t->u.media_segment.polls            = stats->polls;
+    t->u.media_segment.mux_switches     = stats->mux_switches;
+    t->u.media_segment.poll_time_us     = stats->poll_time_us;
+    t->u.media_segment.max_poll_time_us = stats->max_poll_time_us;
+    t->u.media_segment.port_count       = stats->port_count;
+
+    dn_pas_telemetry_rec_end(t);
+}
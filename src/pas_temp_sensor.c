@@ -23,6 +23,7 @@
 #include "private/pas_config.h"
 #include "private/pas_utils.h"
 #include "private/pas_data_store.h"
+#include "private/pas_telemetry.h"
 #include "private/dn_pas.h"
 
 #include "std_type_defs.h"
@@ -371,5 +372,7 @@ bool dn_temp_sensor_poll(
 
     rec->polltime_from_epoch = std_time_get_current_from_epoch_in_nanoseconds();
 
+    dn_pas_telemetry_temp_sensor_update(rec);
+
     return (true);
 }
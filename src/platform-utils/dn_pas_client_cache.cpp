@@ -0,0 +1,706 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**************************************************************************
+ * @file dn_pas_client_cache.cpp
+ *
+ * @brief Client-side cache of PAS objects, per API defined in
+ *        dn_pas_client_cache.h
+ **************************************************************************/
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <new>
+#include <initializer_list>
+
+#include "dn_pas_client_cache.h"
+
+#include "cps_api_key.h"
+#include "cps_api_object_key.h"
+#include "cps_api_operation.h"
+#include "cps_api_events.h"
+#include "cps_class_map.h"
+#include "dell-base-pas.h"
+
+#include <stdio.h>
+#include <string.h>
+
+enum {
+    MAX_KEY_ATTRS = 3
+};
+
+/* Instance key attributes of each cacheable PAS object */
+
+static const struct cache_class {
+    uint_t            subcat;
+    cps_api_attr_id_t key_attrs[MAX_KEY_ATTRS];
+    bool              key_attr_str[MAX_KEY_ATTRS]; /* true <=> string */
+    size_t            num_key_attrs;
+} cache_class_tbl[] = {
+    { BASE_PAS_ENTITY_OBJ,
+      { BASE_PAS_ENTITY_ENTITY_TYPE, BASE_PAS_ENTITY_SLOT }, { false, false }, 2 },
+    { BASE_PAS_PSU_OBJ,
+      { BASE_PAS_PSU_SLOT }, { false }, 1 },
+    { BASE_PAS_FAN_TRAY_OBJ,
+      { BASE_PAS_FAN_TRAY_SLOT }, { false }, 1 },
+    { BASE_PAS_CARD_OBJ,
+      { BASE_PAS_CARD_SLOT }, { false }, 1 },
+    { BASE_PAS_FAN_OBJ,
+      { BASE_PAS_FAN_ENTITY_TYPE, BASE_PAS_FAN_SLOT, BASE_PAS_FAN_FAN_INDEX },
+      { false, false, false }, 3 },
+    { BASE_PAS_POWER_MONITOR_OBJ,
+      { BASE_PAS_POWER_MONITOR_ENTITY_TYPE, BASE_PAS_POWER_MONITOR_SLOT,
+        BASE_PAS_POWER_MONITOR_MONITOR_INDEX },
+      { false, false, false }, 3 },
+    { BASE_PAS_LED_OBJ,
+      { BASE_PAS_LED_ENTITY_TYPE, BASE_PAS_LED_SLOT, BASE_PAS_LED_NAME },
+      { false, false, true }, 3 },
+    { BASE_PAS_TEMPERATURE_OBJ,
+      { BASE_PAS_TEMPERATURE_ENTITY_TYPE, BASE_PAS_TEMPERATURE_SLOT,
+        BASE_PAS_TEMPERATURE_NAME },
+      { false, false, true }, 3 },
+    { BASE_PAS_MEDIA_OBJ,
+      { BASE_PAS_MEDIA_SLOT, BASE_PAS_MEDIA_PORT }, { false, false }, 2 },
+    { BASE_PAS_MEDIA_CHANNEL_OBJ,
+      { BASE_PAS_MEDIA_CHANNEL_SLOT, BASE_PAS_MEDIA_CHANNEL_PORT,
+        BASE_PAS_MEDIA_CHANNEL_CHANNEL },
+      { false, false, false }, 3 },
+};
+
+struct dn_pas_cache_cb_entry {
+    uint_t            subcat;
+    dn_pas_cache_cb_t cb;
+    void              *context;
+};
+
+struct dn_pas_cache {
+    uint64_t                                id;
+    std::mutex                              lock;
+    std::vector<uint_t>                     subcats;
+    std::map<std::string, cps_api_object_t> objs;
+    std::vector<dn_pas_cache_cb_entry>      cbs;
+
+    ~dn_pas_cache()
+    {
+        for (auto &e : objs)  cps_api_object_delete(e.second);
+    }
+};
+
+typedef std::shared_ptr<dn_pas_cache_t> cache_ref_t;
+
+/* Live caches, by id. Ids are never reused, so an event can not reach a
+   cache created at the address of a destroyed one; event handling holds a
+   reference, so a cache destroyed meanwhile is freed when handling ends.
+*/
+
+static std::mutex                      caches_lock;
+static std::map<uint64_t, cache_ref_t> caches;
+static uint64_t                        cache_next_id = 1;
+
+/* Sub-categories registered for PAS events. The CPS event thread has no
+   de-registration, so each sub-category is registered once, for all
+   caches, rather than once per cache.
+*/
+
+static std::mutex                      events_lock;
+static std::set<uint_t>                events_subcats;
+
+static const struct cache_class *cache_class_find(uint_t subcat)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(cache_class_tbl) / sizeof(cache_class_tbl[0]); ++i) {
+        if (cache_class_tbl[i].subcat == subcat)  return (&cache_class_tbl[i]);
+    }
+
+    return (NULL);
+}
+
+/* Return an integer attribute, of whatever width PAS used */
+
+static uint64_t attr_uint(cps_api_object_attr_t a)
+{
+    switch (cps_api_object_attr_len(a)) {
+    case 1:  return (*(uint8_t *) cps_api_object_attr_data_bin(a));
+    case 2:  return (cps_api_object_attr_data_u16(a));
+    case 4:  return (cps_api_object_attr_data_u32(a));
+    case 8:  return (cps_api_object_attr_data_u64(a));
+    default: return (0);
+    }
+}
+
+/* Compose index key of an object; false <=> not a complete instance key */
+
+static bool cache_index_key(cps_api_object_t obj, std::string &idx)
+{
+    cps_api_key_t            *key = cps_api_object_key(obj);
+    const struct cache_class *cc;
+    cps_api_object_attr_t    a;
+    char                     buf[32];
+    size_t                   i;
+
+    if (cps_api_key_get_cat(key) != cps_api_obj_CAT_BASE_PAS)  return (false);
+
+    cc = cache_class_find(cps_api_key_get_subcat(key));
+    if (cc == NULL)  return (false);
+
+    snprintf(buf, sizeof(buf), "%u", cc->subcat);
+    idx = buf;
+
+    for (i = 0; i < cc->num_key_attrs; ++i) {
+        a = cps_api_get_key_data(obj, cc->key_attrs[i]);
+        if (a == CPS_API_ATTR_NULL)  a = cps_api_object_attr_get(obj, cc->key_attrs[i]);
+        if (a == CPS_API_ATTR_NULL)  return (false);
+
+        idx += '.';
+        if (cc->key_attr_str[i]) {
+            idx.append((const char *) cps_api_object_attr_data_bin(a),
+                       strnlen((const char *) cps_api_object_attr_data_bin(a),
+                               cps_api_object_attr_len(a)
+                               )
+                       );
+        } else {
+            snprintf(buf, sizeof(buf), "%llu", (unsigned long long) attr_uint(a));
+            idx += buf;
+        }
+    }
+
+    return (true);
+}
+
+/* Merge a received object into the cache; returns the cached object,
+   or CPS_API_OBJECT_NULL. Caller must hold cache lock.
+*/
+
+static cps_api_object_t cache_merge(dn_pas_cache_t *cache, cps_api_object_t obj)
+{
+    std::string      idx;
+    cps_api_object_t cobj;
+
+    if (!cache_index_key(obj, idx))  return (CPS_API_OBJECT_NULL);
+
+    auto it = cache->objs.find(idx);
+    if (it == cache->objs.end()) {
+        cobj = cps_api_object_create();
+        if (cobj == CPS_API_OBJECT_NULL)  return (CPS_API_OBJECT_NULL);
+
+        if (!cps_api_object_clone(cobj, obj)) {
+            cps_api_object_delete(cobj);
+
+            return (CPS_API_OBJECT_NULL);
+        }
+
+        cache->objs[idx] = cobj;
+
+        return (cobj);
+    }
+
+    cobj = it->second;
+
+    /* Events only carry changed attributes => Overlay onto cached object */
+
+    cps_api_object_attr_merge(cobj, obj, true);
+
+    return (cobj);
+}
+
+/* Invoke change callbacks for an updated object; cache lock not held */
+
+static void cache_notify(dn_pas_cache_t *cache, uint_t subcat, cps_api_object_t obj)
+{
+    std::vector<dn_pas_cache_cb_entry> cbs;
+
+    {
+        std::lock_guard<std::mutex> lg(cache->lock);
+
+        cbs = cache->cbs;
+    }
+
+    for (auto &e : cbs) {
+        if (e.subcat == 0 || e.subcat == subcat)  (*e.cb)(obj, e.context);
+    }
+}
+
+/* Return a reference to the live cache with the given id, if any */
+
+static cache_ref_t cache_ref_get(uint64_t id)
+{
+    std::lock_guard<std::mutex> clg(caches_lock);
+
+    auto it = caches.find(id);
+
+    return ((it == caches.end()) ? cache_ref_t() : it->second);
+}
+
+/* Merge a PAS event into one cache, and notify its callbacks */
+
+static void cache_event_apply(dn_pas_cache_t *cache, uint_t subcat,
+                              cps_api_object_t obj
+                              )
+{
+    cps_api_object_t copy;
+
+    {
+        std::lock_guard<std::mutex> lg(cache->lock);
+
+        cps_api_object_t cobj = cache_merge(cache, obj);
+        if (cobj == CPS_API_OBJECT_NULL)  return;
+
+        /* Hand callbacks a private copy, so they can run unlocked */
+
+        copy = cps_api_object_create();
+        if (copy == CPS_API_OBJECT_NULL)  return;
+        if (!cps_api_object_clone(copy, cobj)) {
+            cps_api_object_delete(copy);
+
+            return;
+        }
+    }
+
+    cache_notify(cache, subcat, copy);
+    cps_api_object_delete(copy);
+}
+
+/* Handle a PAS event; no lock is held while callbacks run, so they may
+   create and destroy caches
+*/
+
+static bool cache_event_cb(cps_api_object_t obj, void *)
+{
+    std::vector<uint64_t> ids;
+    uint_t                subcat;
+
+    subcat = cps_api_key_get_subcat(cps_api_object_key(obj));
+
+    {
+        std::lock_guard<std::mutex> clg(caches_lock);
+
+        for (auto &e : caches) {
+            const std::vector<uint_t> &sc = e.second->subcats;
+
+            if (std::find(sc.begin(), sc.end(), subcat) != sc.end()) {
+                ids.push_back(e.first);
+            }
+        }
+    }
+
+    for (uint64_t id : ids) {
+        cache_ref_t cache = cache_ref_get(id);
+
+        /* Destroyed by an earlier callback => Skip */
+
+        if (cache)  cache_event_apply(cache.get(), subcat, obj);
+    }
+
+    return (true);
+}
+
+/* Load all objects of the given sub-categories, with one CPS GET */
+
+static bool cache_load(dn_pas_cache_t *cache, const uint_t *subcats, size_t n)
+{
+    cps_api_get_params_t gp;
+    cps_api_object_t     obj;
+    size_t               i, mx;
+    bool                 result = false;
+
+    if (cps_api_get_request_init(&gp) != cps_api_ret_code_OK)  return (false);
+
+    do {
+        for (i = 0; i < n; ++i) {
+            obj = cps_api_object_list_create_obj_and_append(gp.filters);
+            if (obj == CPS_API_OBJECT_NULL)  break;
+
+            cps_api_key_from_attr_with_qual(cps_api_object_key(obj),
+                                            subcats[i],
+                                            cps_api_qualifier_OBSERVED
+                                            );
+        }
+        if (i < n)  break;
+
+        if (cps_api_get(&gp) != cps_api_ret_code_OK)  break;
+
+        std::lock_guard<std::mutex> lg(cache->lock);
+
+        mx = cps_api_object_list_size(gp.list);
+        for (i = 0; i < mx; ++i) {
+            cache_merge(cache, cps_api_object_list_get(gp.list, i));
+        }
+
+        result = true;
+    } while (0);
+
+    cps_api_get_request_close(&gp);
+
+    return (result);
+}
+
+/* Subscribe to PAS events of the cached sub-categories, not already
+   subscribed to for another cache
+*/
+
+static bool cache_subscribe(dn_pas_cache_t *cache)
+{
+    static std::once_flag       init_once;
+    static bool                 init_ok;
+    std::vector<cps_api_key_t>  keys;
+    std::vector<uint_t>         subcats;
+    cps_api_event_reg_t         reg;
+    size_t                      i;
+
+    std::call_once(init_once, []() {
+            init_ok = (cps_api_event_thread_init() == cps_api_ret_code_OK);
+        });
+    if (!init_ok)  return (false);
+
+    std::lock_guard<std::mutex> elg(events_lock);
+
+    for (uint_t subcat : cache->subcats) {
+        if (events_subcats.count(subcat) == 0)  subcats.push_back(subcat);
+    }
+    if (subcats.empty())  return (true);
+
+    keys.resize(subcats.size());
+    for (i = 0; i < keys.size(); ++i) {
+        cps_api_key_from_attr_with_qual(&keys[i],
+                                        subcats[i],
+                                        cps_api_qualifier_OBSERVED
+                                        );
+    }
+
+    memset(&reg, 0, sizeof(reg));
+    reg.objects           = keys.data();
+    reg.number_of_objects = keys.size();
+
+    if (cps_api_event_thread_reg(&reg, cache_event_cb, NULL)
+        != cps_api_ret_code_OK
+        ) {
+        return (false);
+    }
+
+    events_subcats.insert(subcats.begin(), subcats.end());
+
+    return (true);
+}
+
+extern "C" {
+
+dn_pas_cache_t *dn_pas_cache_create(const uint_t *subcats, size_t n)
+{
+    dn_pas_cache_t *cache = new (std::nothrow) dn_pas_cache_t;
+    cache_ref_t    ref;
+    size_t         i;
+
+    if (cache == NULL)  return (NULL);
+
+    if (subcats == NULL) {
+        for (i = 0; i < sizeof(cache_class_tbl) / sizeof(cache_class_tbl[0]); ++i) {
+            cache->subcats.push_back(cache_class_tbl[i].subcat);
+        }
+    } else {
+        for (i = 0; i < n; ++i) {
+            if (cache_class_find(subcats[i]) == NULL) {
+                delete cache;
+
+                return (NULL);
+            }
+            cache->subcats.push_back(subcats[i]);
+        }
+    }
+
+    try {
+        ref.reset(cache);
+
+        std::lock_guard<std::mutex> clg(caches_lock);
+
+        cache->id = cache_next_id++;
+        caches[cache->id] = ref;
+    } catch (const std::bad_alloc &) {
+        /* A failed reset deletes the cache */
+
+        return (NULL);
+    }
+
+    /* Subscribe before loading, so that no change is missed in between */
+
+    if (!cache_subscribe(cache)
+        || !cache_load(cache, cache->subcats.data(), cache->subcats.size())
+        ) {
+        dn_pas_cache_destroy(cache);
+
+        return (NULL);
+    }
+
+    return (cache);
+}
+
+void dn_pas_cache_destroy(dn_pas_cache_t *cache)
+{
+    cache_ref_t ref;
+
+    if (cache == NULL)  return;
+
+    /* Drop the cache from event dispatch; freed with the last reference,
+       i.e. here, or when event handling in progress ends
+    */
+
+    std::lock_guard<std::mutex> clg(caches_lock);
+
+    auto it = caches.find(cache->id);
+    if (it == caches.end())  return;
+
+    ref = it->second;
+    caches.erase(it);
+}
+
+bool dn_pas_cache_refresh(dn_pas_cache_t *cache, uint_t subcat)
+{
+    return (cache_load(cache, &subcat, 1));
+}
+
+bool dn_pas_cache_cb_register(dn_pas_cache_t *cache,
+                              uint_t subcat,
+                              dn_pas_cache_cb_t cb,
+                              void *context
+                              )
+{
+    if (cb == NULL)  return (false);
+
+    std::lock_guard<std::mutex> lg(cache->lock);
+
+    cache->cbs.push_back({ subcat, cb, context });
+
+    return (true);
+}
+
+cps_api_object_t dn_pas_cache_object_get(dn_pas_cache_t *cache,
+                                         cps_api_object_t key
+                                         )
+{
+    std::string      idx;
+    cps_api_object_t copy;
+
+    if (!cache_index_key(key, idx))  return (CPS_API_OBJECT_NULL);
+
+    std::lock_guard<std::mutex> lg(cache->lock);
+
+    auto it = cache->objs.find(idx);
+    if (it == cache->objs.end())  return (CPS_API_OBJECT_NULL);
+
+    copy = cps_api_object_create();
+    if (copy == CPS_API_OBJECT_NULL)  return (CPS_API_OBJECT_NULL);
+
+    if (!cps_api_object_clone(copy, it->second)) {
+        cps_api_object_delete(copy);
+
+        return (CPS_API_OBJECT_NULL);
+    }
+
+    return (copy);
+}
+
+} /* extern "C" */
+
+/* Look up an integer attribute of a cached object, by index key */
+
+static bool cache_attr_uint(dn_pas_cache_t *cache,
+                            const std::string &idx,
+                            cps_api_attr_id_t attr,
+                            uint64_t *val
+                            )
+{
+    cps_api_object_attr_t a;
+
+    std::lock_guard<std::mutex> lg(cache->lock);
+
+    auto it = cache->objs.find(idx);
+    if (it == cache->objs.end())  return (false);
+
+    a = cps_api_object_attr_get(it->second, attr);
+    if (a == CPS_API_ATTR_NULL)  return (false);
+
+    *val = attr_uint(a);
+
+    return (true);
+}
+
+/* Compose an index key from integer key attribute values */
+
+static std::string cache_index_key_uint(uint_t subcat,
+                                        std::initializer_list<uint_t> vals
+                                        )
+{
+    std::string idx = std::to_string(subcat);
+
+    for (uint_t v : vals)  idx += '.' + std::to_string(v);
+
+    return (idx);
+}
+
+extern "C" {
+
+bool dn_pas_cache_entity_present_get(dn_pas_cache_t *cache,
+                                     uint_t entity_type,
+                                     uint_t slot,
+                                     bool *present
+                                     )
+{
+    uint64_t val;
+
+    if (!cache_attr_uint(cache,
+                         cache_index_key_uint(BASE_PAS_ENTITY_OBJ, { entity_type, slot }),
+                         BASE_PAS_ENTITY_PRESENT,
+                         &val
+                         )
+        ) {
+        return (false);
+    }
+
+    *present = (val != 0);
+
+    return (true);
+}
+
+bool dn_pas_cache_entity_oper_status_get(dn_pas_cache_t *cache,
+                                         uint_t entity_type,
+                                         uint_t slot,
+                                         uint_t *oper_status
+                                         )
+{
+    uint64_t val;
+
+    if (!cache_attr_uint(cache,
+                         cache_index_key_uint(BASE_PAS_ENTITY_OBJ, { entity_type, slot }),
+                         BASE_PAS_ENTITY_OPER_STATUS,
+                         &val
+                         )
+        ) {
+        return (false);
+    }
+
+    *oper_status = val;
+
+    return (true);
+}
+
+bool dn_pas_cache_fan_speed_get(dn_pas_cache_t *cache,
+                                uint_t entity_type,
+                                uint_t slot,
+                                uint_t fan_idx,
+                                uint_t *speed
+                                )
+{
+    uint64_t val;
+
+    if (!cache_attr_uint(cache,
+                         cache_index_key_uint(BASE_PAS_FAN_OBJ,
+                                              { entity_type, slot, fan_idx }
+                                              ),
+                         BASE_PAS_FAN_SPEED,
+                         &val
+                         )
+        ) {
+        return (false);
+    }
+
+    *speed = val;
+
+    return (true);
+}
+
+bool dn_pas_cache_temperature_get(dn_pas_cache_t *cache,
+                                  uint_t entity_type,
+                                  uint_t slot,
+                                  const char *name,
+                                  int *temperature
+                                  )
+{
+    cps_api_object_attr_t a;
+    std::string           idx;
+
+    idx = cache_index_key_uint(BASE_PAS_TEMPERATURE_OBJ, { entity_type, slot });
+    idx += '.';
+    idx += name;
+
+    std::lock_guard<std::mutex> lg(cache->lock);
+
+    auto it = cache->objs.find(idx);
+    if (it == cache->objs.end())  return (false);
+
+    a = cps_api_object_attr_get(it->second, BASE_PAS_TEMPERATURE_TEMPERATURE);
+    if (a == CPS_API_ATTR_NULL)  return (false);
+
+    /* Temperature is signed */
+
+    switch (cps_api_object_attr_len(a)) {
+    case 1:  *temperature = *(int8_t *) cps_api_object_attr_data_bin(a);  break;
+    case 2:  *temperature = (int16_t) cps_api_object_attr_data_u16(a);    break;
+    default: *temperature = (int32_t) attr_uint(a);                       break;
+    }
+
+    return (true);
+}
+
+bool dn_pas_cache_media_present_get(dn_pas_cache_t *cache,
+                                    uint_t slot,
+                                    uint_t port,
+                                    bool *present
+                                    )
+{
+    uint64_t val;
+
+    if (!cache_attr_uint(cache,
+                         cache_index_key_uint(BASE_PAS_MEDIA_OBJ, { slot, port }),
+                         BASE_PAS_MEDIA_PRESENT,
+                         &val
+                         )
+        ) {
+        return (false);
+    }
+
+    *present = (val != 0);
+
+    return (true);
+}
+
+bool dn_pas_cache_media_type_get(dn_pas_cache_t *cache,
+                                 uint_t slot,
+                                 uint_t port,
+                                 uint_t *type
+                                 )
+{
+    uint64_t val;
+
+    if (!cache_attr_uint(cache,
+                         cache_index_key_uint(BASE_PAS_MEDIA_OBJ, { slot, port }),
+                         BASE_PAS_MEDIA_TYPE,
+                         &val
+                         )
+        ) {
+        return (false);
+    }
+
+    *type = val;
+
+    return (true);
+}
+
+} /* extern "C" */
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**************************************************************************
+ * @file dn_pas_media_dom.c
+ *
+ * @brief Encoder and decoder for packed media DOM attribute, per
+ *        dn_pas_media_dom.h
+ **************************************************************************/
+
+#include "dn_pas_media_dom.h"
+
+#include <endian.h>
+#include <math.h>
+#include <string.h>
+
+/* Convert to and from fixed point, in thousandths */
+
+static int32_t dn_pas_media_dom_fixed(double v)
+{
+    v = round(v * 1000);
+
+    if (v > INT32_MAX)  return (INT32_MAX);
+    if (v < INT32_MIN)  return (INT32_MIN);
+
+    return ((int32_t) v);
+}
+
+static double dn_pas_media_dom_unfixed(int32_t v)
+{
+    return ((int32_t) le32toh(v) / 1000.0);
+}
+
+size_t dn_pas_media_dom_encode(const dn_pas_media_dom_t *dom,
+                               void *buf,
+                               size_t size
+                               )
+{
+    dn_pas_media_dom_packed_hdr_t  *hdr = (dn_pas_media_dom_packed_hdr_t *) buf;
+    dn_pas_media_dom_packed_chan_t *ch;
+    uint_t                         n = dom->num_channels, i;
+    size_t                         len;
+
+    if (n > DN_PAS_MEDIA_DOM_MAX_CHANNELS)  n = DN_PAS_MEDIA_DOM_MAX_CHANNELS;
+
+    len = sizeof(*hdr) + n * sizeof(*ch);
+    if (len > size)  return (0);
+
+    hdr->version       = DN_PAS_MEDIA_DOM_VERSION;
+    hdr->num_channels  = n;
+    hdr->temp_state    = dom->temp_state;
+    hdr->voltage_state = dom->voltage_state;
+    hdr->port          = htole32(dom->port);
+    hdr->poll_time     = htole64(dom->poll_time);
+    hdr->temperature   = htole32(dn_pas_media_dom_fixed(dom->temperature));
+    hdr->voltage       = htole32(dn_pas_media_dom_fixed(dom->voltage));
+
+    ch = (dn_pas_media_dom_packed_chan_t *)(hdr + 1);
+    for (i = 0; i < n; ++i, ++ch) {
+        ch->rx_power        = htole32(dn_pas_media_dom_fixed(dom->channels[i].rx_power));
+        ch->tx_power        = htole32(dn_pas_media_dom_fixed(dom->channels[i].tx_power));
+        ch->tx_bias_current = htole32(dn_pas_media_dom_fixed(dom->channels[i].tx_bias_current));
+        ch->rx_power_state  = dom->channels[i].rx_power_state;
+        ch->tx_power_state  = dom->channels[i].tx_power_state;
+        ch->tx_bias_state   = dom->channels[i].tx_bias_state;
+        ch->flags           = dom->channels[i].flags;
+    }
+
+    return (len);
+}
+
+bool dn_pas_media_dom_decode(const void *buf,
+                             size_t len,
+                             dn_pas_media_dom_t *dom
+                             )
+{
+    const dn_pas_media_dom_packed_hdr_t  *hdr = (const dn_pas_media_dom_packed_hdr_t *) buf;
+    const dn_pas_media_dom_packed_chan_t *ch;
+    uint_t                               i;
+
+    if (len < sizeof(*hdr)
+        || hdr->version != DN_PAS_MEDIA_DOM_VERSION
+        || hdr->num_channels > DN_PAS_MEDIA_DOM_MAX_CHANNELS
+        || len < sizeof(*hdr) + hdr->num_channels * sizeof(*ch)
+        ) {
+        return (false);
+    }
+
+    memset(dom, 0, sizeof(*dom));
+
+    dom->port          = le32toh(hdr->port);
+    dom->poll_time     = le64toh(hdr->poll_time);
+    dom->temperature   = dn_pas_media_dom_unfixed(hdr->temperature);
+    dom->voltage       = dn_pas_media_dom_unfixed(hdr->voltage);
+    dom->temp_state    = hdr->temp_state;
+    dom->voltage_state = hdr->voltage_state;
+    dom->num_channels  = hdr->num_channels;
+
+    ch = (const dn_pas_media_dom_packed_chan_t *)(hdr + 1);
+    for (i = 0; i < dom->num_channels; ++i, ++ch) {
+        dom->channels[i].rx_power        = dn_pas_media_dom_unfixed(ch->rx_power);
+        dom->channels[i].tx_power        = dn_pas_media_dom_unfixed(ch->tx_power);
+        dom->channels[i].tx_bias_current = dn_pas_media_dom_unfixed(ch->tx_bias_current);
+        dom->channels[i].rx_power_state  = ch->rx_power_state;
+        dom->channels[i].tx_power_state  = ch->tx_power_state;
+        dom->channels[i].tx_bias_state   = ch->tx_bias_state;
+        dom->channels[i].flags           = ch->flags;
+    }
+
+    return (true);
+}
+
+bool dn_pas_media_dom_get(cps_api_object_t obj, dn_pas_media_dom_t *dom)
+{
+    cps_api_object_attr_t a;
+
+    a = cps_api_object_attr_get(obj, DN_PAS_ATTR_MEDIA_DOM_PACKED);
+    if (a == CPS_API_ATTR_NULL)  return (false);
+
+    return (dn_pas_media_dom_decode(cps_api_object_attr_data_bin(a),
+                                    cps_api_object_attr_len(a),
+                                    dom
+                                    )
+            );
+}
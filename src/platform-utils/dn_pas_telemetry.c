@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/***************************************************************************
+ *
+ * Reader of PAS shared-memory telemetry region, per API defined in
+ * dn_pas_telemetry.h
+ */
+
+#include "dn_pas_telemetry.h"
+#include "std_type_defs.h"
+#include <string.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* Number of attempts to get a consistent copy of a record */
+#define READ_RETRIES  (1000)
+
+struct dn_pas_telemetry {
+    dn_pas_telemetry_hdr_t *hdr;
+    size_t                 size;
+};
+
+dn_pas_telemetry_t *dn_pas_telemetry_open(void)
+{
+    dn_pas_telemetry_t *t;
+    struct stat        st;
+    int                fd;
+    void               *p;
+
+    fd = shm_open(DN_PAS_TELEMETRY_SHM_NAME, O_RDONLY, 0);
+    if (fd < 0)  return (NULL);
+
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(dn_pas_telemetry_hdr_t)) {
+        close(fd);
+
+        return (NULL);
+    }
+
+    p = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)  return (NULL);
+
+    t = (dn_pas_telemetry_t *) calloc(1, sizeof(*t));
+    if (t == NULL) {
+        munmap(p, st.st_size);
+
+        return (NULL);
+    }
+
+    t->hdr  = (dn_pas_telemetry_hdr_t *) p;
+    t->size = st.st_size;
+
+    if (t->hdr->magic != DN_PAS_TELEMETRY_MAGIC
+        || t->hdr->version != DN_PAS_TELEMETRY_VERSION
+        || t->hdr->rec_size != sizeof(dn_pas_telemetry_rec_t)
+        || sizeof(dn_pas_telemetry_hdr_t)
+           + (size_t) t->hdr->max_recs * sizeof(dn_pas_telemetry_rec_t) > t->size
+        ) {
+        dn_pas_telemetry_close(t);
+
+        return (NULL);
+    }
+
+    return (t);
+}
+
+void dn_pas_telemetry_close(dn_pas_telemetry_t *t)
+{
+    if (t == NULL)  return;
+
+    munmap(t->hdr, t->size);
+    free(t);
+}
+
+uint32_t dn_pas_telemetry_generation(dn_pas_telemetry_t *t)
+{
+    return (__atomic_load_n(&t->hdr->generation, __ATOMIC_ACQUIRE));
+}
+
+uint_t dn_pas_telemetry_count(dn_pas_telemetry_t *t)
+{
+    uint_t n = __atomic_load_n(&t->hdr->num_recs, __ATOMIC_ACQUIRE);
+
+    return (n > t->hdr->max_recs ? t->hdr->max_recs : n);
+}
+
+bool dn_pas_telemetry_read(dn_pas_telemetry_t *t,
+                           uint_t idx,
+                           dn_pas_telemetry_rec_t *rec
+                           )
+{
+    const dn_pas_telemetry_rec_t *src;
+    uint32_t                     seq1, seq2;
+    uint_t                       retries;
+
+    if (idx >= dn_pas_telemetry_count(t))  return (false);
+
+    src = &t->hdr->recs[idx];
+
+    for (retries = 0; retries < READ_RETRIES; ++retries) {
+        seq1 = __atomic_load_n(&src->seq, __ATOMIC_ACQUIRE);
+        if (seq1 & 1)  continue;  /* Update in progress */
+
+        memcpy(rec, src, sizeof(*rec));
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        seq2 = __atomic_load_n(&src->seq, __ATOMIC_RELAXED);
+
+        if (seq1 == seq2) {
+            rec->seq = seq1;
+
+            return (rec->cls != DN_PAS_TELEMETRY_CLASS_NONE);
+        }
+    }
+
+    return (false);
+}
+
+bool dn_pas_telemetry_find(dn_pas_telemetry_t *t,
+                           dn_pas_telemetry_class_t cls,
+                           uint_t entity_type,
+                           uint_t slot,
+                           uint_t idx,
+                           uint_t channel,
+                           dn_pas_telemetry_rec_t *rec
+                           )
+{
+    const dn_pas_telemetry_rec_t *r;
+    bool                         media, chan;
+    uint_t                       i, n = dn_pas_telemetry_count(t);
+
+    chan  = (cls == DN_PAS_TELEMETRY_CLASS_MEDIA_CHANNEL
+             || cls == DN_PAS_TELEMETRY_CLASS_MEDIA_SEGMENT
+             );
+    media = (cls == DN_PAS_TELEMETRY_CLASS_MEDIA || chan);
+
+    for (i = 0; i < n; ++i) {
+        r = &t->hdr->recs[i];
+
+        /* Identity fields are only written when a record is allocated */
+
+        if (r->cls != (uint32_t) cls || r->slot != slot || r->idx != idx
+            || (!media && r->entity_type != entity_type)
+            || (chan && r->channel != channel)
+            ) {
+            continue;
+        }
+
+        return (dn_pas_telemetry_read(t, i, rec));
+    }
+
+    return (false);
+}
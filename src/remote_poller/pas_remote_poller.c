@@ -23,6 +23,8 @@
 #include "private/pas_utils.h"
 #include "private/pas_data_store.h"
 #include "private/pas_comm_dev.h"
+#include "private/pas_config.h"
+#include "private/pas_telemetry.h"
 
 #include "cps_api_key.h"
 #include "cps_api_object_key.h"
@@ -30,6 +32,7 @@
 #include "cps_class_map.h"
 #include "cps_api_operation.h"
 #include "cps_api_service.h"
+#include "cps_api_events.h"
 
 #include "dell-base-pas.h"
 #include "dell-base-common.h"   /** \todo Simplify */
@@ -39,36 +42,72 @@
 #include <stdio.h>
 #include <sys/types.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
+#include <time.h>
 
-static volatile bool remote_npu_temp_sensor_init_flag = false;
+static volatile bool remote_temp_sensor_init_flag = false;
 
-/* initiaize cacheDB entry for remote NPU temp sensor */
-void dn_cache_init_remote_temp_sensor(void)
+/*
+ * Run-time state of a remote temperature sensor
+ */
+
+typedef struct _pas_remote_sensor_t {
+    pas_config_remote_sensor *cfg;
+    cps_api_key_t            key;           /* CPS key of object to get */
+    cps_api_attr_id_t        attr_id;       /* Temperature attribute */
+    cps_api_attr_id_t        key_attr_id;   /* Instance key attribute */
+    bool                     valid;         /* true <=> ids resolved */
+    uint64_t                 next_poll_ms;  /* Time of next poll, in ms */
+    volatile uint64_t        event_ms;      /* Time of last event, in ms;
+                                               0 => none yet */
+} pas_remote_sensor_t;
+
+static pas_remote_sensor_t *remote_sensors;
+static uint_t              remote_sensor_cnt;
+
+/* Return monotonic time, in ms */
+static uint64_t dn_pas_remote_poller_now_ms(void)
 {
-    /* slot_no and sensor_name are hard-coded for pizza-boxes */
-    uint_t                    slot_no      = 1;
-    const char                *sensor_name = "NPU temp sensor";
-    pas_entity_t              *parent;
-    pas_temperature_sensor_t  *rec;
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+/* Convert a CPS attribute name, or number, from config to an attribute id */
+static bool dn_pas_remote_attr_id(const char *name, cps_api_attr_id_t *id)
+{
+    unsigned long long val;
+    char               c;
 
-    /* get parent from cache */
+    if (name[0] == 0)  return false;
 
-    char res_key[PAS_RES_KEY_SIZE];
+    if (sscanf(name, "%llu%c", &val, &c) == 1) {
+        *id = (cps_api_attr_id_t) val;
 
-    parent = (pas_entity_t *) dn_pas_res_getc(dn_pas_res_key_entity(res_key,
-                                                                    sizeof(res_key),
-                                                                    PLATFORM_ENTITY_TYPE_CARD,
-                                                                    slot_no
-                                                                    )
-                                              );
-    if (NULL == parent) return;
+        return true;
+    }
+
+    *id = cps_name_to_attr(name);
+
+    return (*id != (cps_api_attr_id_t) -1);
+}
+
+/* initialize cacheDB entry for one remote temp sensor, of given card */
+static void dn_cache_init_remote_temp_sensor1(pas_entity_t *parent,
+                                              pas_config_remote_sensor *cfg
+                                              )
+{
+    pas_temperature_sensor_t  *rec;
+    char                      res_key[PAS_RES_KEY_SIZE];
 
     rec = pas_temperature_new();
     if (rec == 0)  return;
 
     ++parent->num_temp_sensors;
-    STRLCPY(rec->name, sensor_name);
+    STRLCPY(rec->name, cfg->name);
     rec->parent           = parent;
     rec->sensor_idx       = parent->num_temp_sensors;
     rec->sdi_resource_hdl = NULL; /* not handled by SDI, hence resource_hdl is NULL */
@@ -108,150 +147,123 @@ void dn_cache_init_remote_temp_sensor(void)
         pas_temperature_del(rec);
         return;
     }
-
-    remote_npu_temp_sensor_init_flag = true;
 }
 
-/* Get temperature value on a NPU Temperature Sensor by NAS CPS get */
-static t_std_error dn_pas_npu_temperature_get(uint_t *temp)
+/* initialize cacheDB entries for configured remote temp sensors of given
+   card; called once per card initialization
+*/
+void dn_cache_init_remote_temp_sensor(pas_entity_t *parent)
 {
-    int                  switch_id = 0;
-    cps_api_key_t        key;
-    cps_api_get_params_t gp;
-    bool                 err_flag  = false;
-
-    /* Initialize a CPS get request */
-    cps_api_get_request_init(&gp);
-    cps_api_object_t obj = cps_api_object_list_create_obj_and_append(gp.filters);
-
-    do {
-        if (NULL == obj) {
-            PAS_ERR("Failed to create CPS API object");
-
-            err_flag = true;
-            break;
-        }
-
-        /* make a CPS key and attach to request */
-        cps_api_key_from_attr_with_qual(&key,
-                                        BASE_SWITCH_SWITCHING_ENTITIES_SWITCHING_ENTITY,
-                                        cps_api_qualifier_TARGET);
-        cps_api_object_set_key(obj, &key);
-
-        cps_api_set_key_data(obj,
-                             BASE_SWITCH_SWITCHING_ENTITIES_SWITCHING_ENTITY_SWITCH_ID,
-                             cps_api_object_ATTR_T_U32,
-                             &switch_id,
-                             sizeof(switch_id));
+    struct pas_config_remote_poller *cfg = dn_pas_config_remote_poller_get();
+    uint_t                          i;
 
-        cps_api_object_attr_add_u32(obj,
-                BASE_SWITCH_SWITCHING_ENTITIES_SWITCHING_ENTITY_TEMPERATURE,
-                0);
+    for (i = 0; i < cfg->num_sensors; ++i) {
+        if (cfg->sensors[i].slot != parent->slot)  continue;
 
+        dn_cache_init_remote_temp_sensor1(parent, &cfg->sensors[i]);
+    }
 
-        /* getting a list of CPS response objects */
-        if (cps_api_get(&gp) == cps_api_ret_code_OK) {
-
-            size_t mx = cps_api_object_list_size(gp.list);
-            size_t ix = 0;
-
-            for (ix = 0 ; ix < mx ; ++ix ) {
+    remote_temp_sensor_init_flag = true;
+}
 
-                cps_api_object_it_t   it;
-                cps_api_object_attr_t a;
-                cps_api_object_t      obj = cps_api_object_list_get(gp.list, ix);
+/* Resolve CPS keys and attribute ids of all configured remote sensors */
+static bool dn_pas_remote_sensors_init(void)
+{
+    struct pas_config_remote_poller *cfg = dn_pas_config_remote_poller_get();
+    pas_remote_sensor_t             *rs;
+    cps_api_attr_id_t               key_id;
+    uint_t                          i;
+
+    remote_sensors = (pas_remote_sensor_t *)
+        calloc(cfg->num_sensors, sizeof(*remote_sensors));
+    if (remote_sensors == NULL)  return false;
+
+    remote_sensor_cnt = cfg->num_sensors;
+
+    for (i = 0; i < remote_sensor_cnt; ++i) {
+        rs = &remote_sensors[i];
+        rs->cfg = &cfg->sensors[i];
+
+        if (!dn_pas_remote_attr_id(rs->cfg->key, &key_id)
+            || !dn_pas_remote_attr_id(rs->cfg->attr, &rs->attr_id)
+            || (rs->cfg->key_attr[0] != 0
+                && !dn_pas_remote_attr_id(rs->cfg->key_attr, &rs->key_attr_id)
+                )
+            ) {
+            PAS_ERR("Remote sensor %s has invalid CPS key or attribute",
+                    rs->cfg->name
+                    );
+
+            continue;
+        }
 
-                cps_api_object_it_begin(obj, &it);
-                a = cps_api_object_attr_get(obj,
-                                            BASE_SWITCH_SWITCHING_ENTITIES_SWITCHING_ENTITY_TEMPERATURE);
+        cps_api_key_from_attr_with_qual(&rs->key, key_id, cps_api_qualifier_TARGET);
 
-                if(a != CPS_API_ATTR_NULL) {
+        rs->valid = true;
+    }
 
-            	    *temp = cps_api_object_attr_data_uint(a);
+    return true;
+}
 
-                } else {
-                    PAS_ERR("Temperature attribute not found");
+/* Return true iff given CPS object is the instance read by given remote sensor */
+static bool dn_pas_remote_sensor_match(pas_remote_sensor_t *rs,
+                                       cps_api_object_t    obj
+                                       )
+{
+    cps_api_object_attr_t a;
 
-            	    err_flag = true;
-            	    break;
-            	}
-            } /* for loop - closing brace */
-        } else {
+    /* Compare ignoring qualifier, so that events match too */
+    if (cps_api_key_get_cat(cps_api_object_key(obj)) != cps_api_key_get_cat(&rs->key)
+        || cps_api_key_get_subcat(cps_api_object_key(obj)) != cps_api_key_get_subcat(&rs->key)
+        ) {
+        return false;
+    }
 
-    	    err_flag = true;
-    	    break;
-        }
-    } while(0);
+    if (rs->cfg->key_attr[0] == 0)  return true;
 
-    cps_api_get_request_close(&gp);
-    if (err_flag) {
+    /* Instance key may be in the object key, or an attribute; if absent,
+       the object cannot be told apart from other instances
+    */
 
-        return STD_ERR(PAS, FAIL, 0);
-    } else {
+    a = cps_api_get_key_data(obj, rs->key_attr_id);
+    if (a == CPS_API_ATTR_NULL)  a = cps_api_object_attr_get(obj, rs->key_attr_id);
 
-        return STD_ERR_OK;
-    }
+    return (a != CPS_API_ATTR_NULL
+            && cps_api_object_attr_data_u32(a) == rs->cfg->key_val
+            );
 }
 
-/* Poll a remote temperature sensor on the NPU */
-static bool dn_remote_temp_sensor_poll(void)
+/* Update a remote temperature sensor with the result of a fetch;
+   caller must hold pas_lock
+*/
+static bool dn_remote_temp_sensor_update(pas_config_remote_sensor *cfg,
+                                         bool fetch_ok,
+                                         uint_t temp
+                                         )
 {
-    /* slot_no and sensor_name are hard-coded for pizza-boxes */
-    uint_t                   slot_no       = 1;
-    char                     *sensor_name  = "NPU temp sensor";
     bool                     notif         = false;
-    bool                     ret           = true;
-    uint_t                   temp = 0;
     pas_oper_fault_state_t   oper_fault_state[1];
-    pas_temperature_sensor_t *temp_rec;
     pas_temperature_sensor_t *rec;
 
-    /* get parent from cache */
-
-    char res_key[PAS_RES_KEY_SIZE];
-
-    pas_entity_t *parent = (pas_entity_t *)
-        dn_pas_res_getc(dn_pas_res_key_entity(res_key,
-                                              sizeof(res_key),
-                                              PLATFORM_ENTITY_TYPE_CARD,
-                                              slot_no
-                                              )
-                        );
-    if (NULL == parent) return false;
-
     /* retrieve temp record from the cache based on name */
-    temp_rec = dn_pas_temperature_rec_get_name(parent->entity_type,
-                                               parent->slot,
-                                               sensor_name
-                                               );
-    if (NULL == temp_rec) return false;
-
-    /* retrieve temp record from the cache based on index */
-    rec = dn_pas_temperature_rec_get_idx(parent->entity_type,
-                                         parent->slot,
-                                         temp_rec->sensor_idx);
+    rec = dn_pas_temperature_rec_get_name(PLATFORM_ENTITY_TYPE_CARD,
+                                          cfg->slot,
+                                          cfg->name
+                                          );
     if (NULL == rec) return false;
 
     dn_pas_oper_fault_state_init(oper_fault_state);
 
-    do {
-        /* get the realtime temperature value from NAS and if nothing is returned say error */
-        if (STD_IS_ERR(dn_pas_npu_temperature_get(&temp))) {
-            PAS_ERR("CPS API get failed");
-
-            dn_pas_oper_fault_state_update(oper_fault_state,
-                                           PLATFORM_FAULT_TYPE_ECOMM);
-
-            ret = false;
-            break;
-        }
-
+    if (fetch_ok) {
         rec->prev = rec->cur;
         rec->cur  = temp;
         if (rec->nsamples < 2)  ++rec->nsamples;
 
         if (dn_temp_sensor_thresh_chk(rec))  notif = true;
-    } while (0);
+    } else {
+        dn_pas_oper_fault_state_update(oper_fault_state,
+                                       PLATFORM_FAULT_TYPE_ECOMM);
+    }
 
     if (rec->oper_fault_state->oper_status != oper_fault_state->oper_status) {
 
@@ -264,32 +276,223 @@ static bool dn_remote_temp_sensor_poll(void)
 
     if (notif)  dn_temp_sensor_notify(rec);
 
+    dn_pas_telemetry_temp_sensor_update(rec);
+
+    return fetch_ok;
+}
+
+/* Poll all remote temperature sensors that are due, with one CPS get */
+static bool dn_remote_temp_sensors_poll(void)
+{
+    struct pas_config_remote_poller *cfg = dn_pas_config_remote_poller_get();
+    cps_api_get_params_t gp;
+    cps_api_object_t     obj;
+    cps_api_object_attr_t a;
+    pas_remote_sensor_t  *rs;
+    bool                 due[PAS_REMOTE_SENSOR_MAX];
+    bool                 found[PAS_REMOTE_SENSOR_MAX];
+    uint_t               temp[PAS_REMOTE_SENSOR_MAX];
+    uint_t               i, due_cnt = 0;
+    size_t               ix, mx;
+    bool                 fetch_ok, ret = true;
+    uint64_t             now = dn_pas_remote_poller_now_ms();
+
+    cps_api_get_request_init(&gp);
+    gp.timeout = cfg->timeout;
+
+    for (i = 0; i < remote_sensor_cnt; ++i) {
+        rs = &remote_sensors[i];
+
+        due[i]   = false;
+        found[i] = false;
+
+        if (!rs->valid || now < rs->next_poll_ms)  continue;
+
+        rs->next_poll_ms = now + rs->cfg->poll_interval;
+
+        /* Events arriving => Poll only if they stop */
+        if (rs->event_ms != 0 && now - rs->event_ms < rs->cfg->poll_interval) {
+            continue;
+        }
+
+        obj = cps_api_object_list_create_obj_and_append(gp.filters);
+        if (NULL == obj) {
+            PAS_ERR("Failed to create CPS API object");
+
+            break;
+        }
+
+        cps_api_object_set_key(obj, &rs->key);
+        if (rs->cfg->key_attr[0] != 0) {
+            cps_api_set_key_data(obj,
+                                 rs->key_attr_id,
+                                 cps_api_object_ATTR_T_U32,
+                                 &rs->cfg->key_val,
+                                 sizeof(rs->cfg->key_val)
+                                 );
+        }
+        cps_api_object_attr_add_u32(obj, rs->attr_id, 0);
+
+        due[i] = true;
+        ++due_cnt;
+    }
+
+    if (due_cnt == 0) {
+        cps_api_get_request_close(&gp);
+
+        return true;
+    }
+
+    /* get the realtime values without holding pas_lock,
+       so that PAS is not blocked for the remote round trip
+    */
+    fetch_ok = (cps_api_get(&gp) == cps_api_ret_code_OK);
+    if (!fetch_ok) {
+        PAS_ERR("CPS API get failed");
+    } else {
+        mx = cps_api_object_list_size(gp.list);
+        for (ix = 0; ix < mx; ++ix) {
+            obj = cps_api_object_list_get(gp.list, ix);
+
+            for (i = 0; i < remote_sensor_cnt; ++i) {
+                rs = &remote_sensors[i];
+
+                if (!due[i] || found[i] || !dn_pas_remote_sensor_match(rs, obj)) {
+                    continue;
+                }
+
+                a = cps_api_object_attr_get(obj, rs->attr_id);
+                if (a == CPS_API_ATTR_NULL)  continue;
+
+                temp[i]  = cps_api_object_attr_data_uint(a);
+                found[i] = true;
+            }
+        }
+    }
+
+    cps_api_get_request_close(&gp);
+
+    dn_pas_lock();
+    for (i = 0; i < remote_sensor_cnt; ++i) {
+        if (!due[i])  continue;
+
+        if (!found[i] && fetch_ok) {
+            PAS_ERR("Temperature attribute not found for %s",
+                    remote_sensors[i].cfg->name
+                    );
+        }
+
+        if (!dn_remote_temp_sensor_update(remote_sensors[i].cfg,
+                                          found[i],
+                                          found[i] ? temp[i] : 0
+                                          )
+            ) {
+            ret = false;
+        }
+    }
+    dn_pas_unlock();
+
     return ret;
 }
 
-/* NPU temperature sensor poller thread initialization */
+/* Handle an event carrying remote sensor temperatures */
+static bool dn_pas_remote_temp_event_cb(cps_api_object_t obj, void *context)
+{
+    cps_api_object_attr_t a;
+    pas_remote_sensor_t   *rs;
+    uint_t                i;
+
+    dn_pas_lock();
+    for (i = 0; i < remote_sensor_cnt; ++i) {
+        rs = &remote_sensors[i];
+
+        if (!rs->valid || !dn_pas_remote_sensor_match(rs, obj))  continue;
+
+        a = cps_api_object_attr_get(obj, rs->attr_id);
+        if (a == CPS_API_ATTR_NULL)  continue;
+
+        if (dn_remote_temp_sensor_update(rs->cfg, true, cps_api_object_attr_data_uint(a))) {
+            rs->event_ms = dn_pas_remote_poller_now_ms();
+        }
+    }
+    dn_pas_unlock();
+
+    return true;
+}
+
+/* Subscribe to events for the objects of all remote sensors */
+static bool dn_pas_remote_temp_subscribe(void)
+{
+    static cps_api_key_t keys[PAS_REMOTE_SENSOR_MAX];
+    cps_api_event_reg_t  reg;
+    uint_t               i;
+
+    if (cps_api_event_thread_init() != cps_api_ret_code_OK) {
+        return false;
+    }
+
+    memset(&reg, 0, sizeof(reg));
+    reg.objects = keys;
+
+    for (i = 0; i < remote_sensor_cnt; ++i) {
+        if (!remote_sensors[i].valid)  continue;
+
+        cps_api_key_copy(&keys[reg.number_of_objects], &remote_sensors[i].key);
+        cps_api_key_set_qualifier(&keys[reg.number_of_objects],
+                                  cps_api_qualifier_OBSERVED
+                                  );
+        ++reg.number_of_objects;
+    }
+
+    if (reg.number_of_objects == 0)  return false;
+
+    return (cps_api_event_thread_reg(&reg,
+                                     dn_pas_remote_temp_event_cb,
+                                     NULL
+                                     ) == cps_api_ret_code_OK
+            );
+}
+
+/* Remote temperature sensor poller thread */
 t_std_error dn_pas_remote_poller_thread(void)
 {
-    /* hard-coded for now; will use config file in future depending on design */
-    int polling_freq = 5;
+    struct pas_config_remote_poller *cfg = dn_pas_config_remote_poller_get();
+    uint_t                          i, tick;
 
-    /* keep trying till remote npu temp sensor's cacheDB entry gets initialized */
-    while(!remote_npu_temp_sensor_init_flag) {
+    /* keep trying till remote temp sensors' cacheDB entries get initialized */
+    while(!remote_temp_sensor_init_flag) {
 
     	sleep(1);
     }
 
+    if (!dn_pas_remote_sensors_init()) {
+        PAS_ERR("Remote poller failed to initialize");
+
+        return (STD_ERR(PAS, NOMEM, 0));
+    }
+
+    if (cfg->subscribe && !dn_pas_remote_temp_subscribe()) {
+        PAS_ERR("Remote poller event subscription failed, polling only");
+    }
+
+    /* Wake up at the shortest configured interval */
+    tick = cfg->poll_interval;
+    for (i = 0; i < remote_sensor_cnt; ++i) {
+        if (remote_sensors[i].cfg->poll_interval < tick) {
+            tick = remote_sensors[i].cfg->poll_interval;
+        }
+    }
+    if (tick == 0)  tick = PAS_REMOTE_POLL_INTERVAL_DFLT;
+
     PAS_NOTICE("Remote poller initialized");
 
     for (;;) {
 
-        sleep(polling_freq);
+        usleep(tick * 1000);
 
-        dn_pas_lock();
-        if (false == dn_remote_temp_sensor_poll()) {
+        if (false == dn_remote_temp_sensors_poll()) {
             PAS_ERR("Poll cycle failed");
         }
-        dn_pas_unlock();
     }
 
     PAS_NOTICE("Remote poller exiting");
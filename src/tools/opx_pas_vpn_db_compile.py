@@ -0,0 +1,143 @@
+#!/usr/bin/python
+#
+# Copyright (c) 2018 Dell Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may
+# not use this file except in compliance with the License. You may obtain
+# a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+# THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+# CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+# LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+# FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+#
+# See the Apache Version 2.0 License for specific language governing
+# permissions and limitations under the License.
+#
+
+"""
+Compile the PAS media vendor part number database.
+
+Each line of the source file gives one part number:
+
+    <vendor-pn> <vendor-rev> <wavelength> <media-interface> [<media-type>]
+
+- vendor-rev is '*' to match any revision
+- media-interface is a PLATFORM_MEDIA_INTERFACE_ name, with or without
+  the prefix, or a number
+- media-type is a PLATFORM_MEDIA_TYPE_ name, with or without the prefix,
+  or a number; if omitted, the media type is derived as for other media
+- fields containing blanks may be quoted, and '#' starts a comment
+
+The output file is installed as /etc/opx/pas/media-vpn.db, and takes
+effect when PAS is restarted.
+"""
+
+import argparse
+import re
+import shlex
+import struct
+import sys
+
+DB_MAGIC = 0x4244504e
+DB_VERSION = 1
+PN_LEN = 16
+REV_LEN = 4
+
+HDR_FMT = '<4I'
+REC_FMT = '<%ds%ds3I' % (PN_LEN, REV_LEN)
+
+DFLT_HEADER = '/usr/include/opx/dell-base-platform-common.h'
+MEDIA_IF_PREFIX = 'PLATFORM_MEDIA_INTERFACE_'
+MEDIA_TYPE_PREFIX = 'PLATFORM_MEDIA_TYPE_'
+MEDIA_TYPE_UNKNOWN = 'PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN'
+
+
+def enums_load(header):
+    """Return enum name to value map, from given C header"""
+    enums = {}
+    with open(header) as f:
+        for m in re.finditer(r'\b(PLATFORM_MEDIA_\w+)\s*=\s*(\d+)', f.read()):
+            enums[m.group(1)] = int(m.group(2))
+    return enums
+
+
+def enum_value(enums, prefix, name):
+    """Return value of given enum name, with or without given prefix"""
+    if name.isdigit():
+        return int(name)
+    for n in (name, prefix + name):
+        if n in enums:
+            return enums[n]
+    raise ValueError('unknown %s value %s' % (prefix, name))
+
+
+def key_field(s, size, what):
+    """Return given key string as stored: no trailing blanks, NUL padded"""
+    b = s.rstrip(' ').encode('ascii')
+    if len(b) > size:
+        raise ValueError('%s %s longer than %d' % (what, s, size))
+    return b.ljust(size, b'\0')
+
+
+def source_parse(filename, enums):
+    """Return list of records, keyed by (vendor PN, vendor rev)"""
+    recs = {}
+    with open(filename) as f:
+        for lineno, line in enumerate(f, 1):
+            try:
+                fields = shlex.split(line, comments=True)
+                if not fields:
+                    continue
+                if len(fields) not in (4, 5):
+                    raise ValueError('expected 4 or 5 fields')
+                pn = key_field(fields[0], PN_LEN, 'vendor PN')
+                rev = key_field('' if fields[1] == '*' else fields[1],
+                                REV_LEN, 'vendor revision')
+                wavelength = int(fields[2], 0)
+                media_if = enum_value(enums, MEDIA_IF_PREFIX, fields[3])
+                media_type = enum_value(enums, MEDIA_TYPE_PREFIX,
+                                        fields[4] if len(fields) > 4
+                                        else MEDIA_TYPE_UNKNOWN)
+            except ValueError as e:
+                raise ValueError('%s:%d: %s' % (filename, lineno, e))
+            if (pn, rev) in recs:
+                raise ValueError('%s:%d: duplicate entry' % (filename, lineno))
+            recs[(pn, rev)] = (wavelength, media_if, media_type)
+    return recs
+
+
+def db_write(filename, recs):
+    """Write given records, sorted by key, to given database file"""
+    with open(filename, 'wb') as f:
+        f.write(struct.pack(HDR_FMT, DB_MAGIC, DB_VERSION,
+                            struct.calcsize(REC_FMT), len(recs)))
+        for key in sorted(recs):
+            f.write(struct.pack(REC_FMT, key[0], key[1], *recs[key]))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compile PAS media vendor part number database',
+        epilog=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('source', help='text source file')
+    parser.add_argument('output', help='database file to write')
+    parser.add_argument('--header', default=DFLT_HEADER,
+                        help='header defining media enums (default %s)'
+                        % DFLT_HEADER)
+    args = parser.parse_args()
+
+    try:
+        recs = source_parse(args.source, enums_load(args.header))
+        db_write(args.output, recs)
+    except (IOError, OSError, ValueError) as e:
+        sys.stderr.write('%s\n' % e)
+        return 1
+
+    print('%d entries written to %s' % (len(recs), args.output))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: pas_media_topo_test.c
+ *
+ * Scale test of media port table topology build, over synthetic 512 and
+ * 1024 port tables: sub-port ids are contiguous, SDI handles land on
+ * pluggable ports in order, and the whole table is walked once.
+ */
+
+#include "private/pas_media_topo.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Every 64th port fixed; densities 1, 2, 4 and 8 */
+
+#define TEST_FIXED_PORT_INTERVAL 64
+
+static const uint_t test_density[] = { 1, 2, 4, 8 };
+
+static uint_t test_failures = 0;
+
+#define TEST_CHECK(cond, ...)                                   \
+    do {                                                        \
+        if (!(cond)) {                                          \
+            fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__); \
+            fprintf(stderr, __VA_ARGS__);                       \
+            fprintf(stderr, "\n");                              \
+            ++test_failures;                                    \
+        }                                                       \
+    } while (0)
+
+static double test_now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (ts.tv_sec * 1e6 + ts.tv_nsec / 1e3);
+}
+
+static void test_topo(uint_t port_count)
+{
+    struct pas_config_media cfg = { 0 };
+    pas_port_info_t         *info;
+    phy_media_tbl_t         *tbl;
+    uint_t                  port, density, pluggable = 0, lport, next_port;
+    uint_t                  prev_port, assigned = 0, walked = 0;
+    double                  t0, t_sub, t_hdl;
+
+    info = calloc(port_count + 1, sizeof(*info));
+    tbl  = calloc(port_count + 1, sizeof(*tbl));
+    cfg.port_info_tbl = calloc(port_count + 1, sizeof(*cfg.port_info_tbl));
+    if (info == NULL || tbl == NULL || cfg.port_info_tbl == NULL) {
+        TEST_CHECK(false, "allocation failed, %u ports", port_count);
+
+        goto done;
+    }
+
+    cfg.port_count = port_count;
+    for (port = PAS_MEDIA_START_PORT; port <= port_count; ++port) {
+        info[port].port_type = (port % TEST_FIXED_PORT_INTERVAL == 0)
+            ? PLATFORM_PORT_TYPE_FIXED : PLATFORM_PORT_TYPE_PLUGGABLE;
+        info[port].port_density
+            = test_density[port % (sizeof(test_density) / sizeof(test_density[0]))];
+        cfg.port_info_tbl[port] = &info[port];
+
+        if (info[port].port_type == PLATFORM_PORT_TYPE_PLUGGABLE)  ++pluggable;
+    }
+
+    /* Sub-port ids: 1, 2, ..., in port order, without gaps */
+
+    t0 = test_now_us();
+    dn_pas_media_topo_sub_ports_assign(tbl, &cfg);
+    t_sub = test_now_us() - t0;
+
+    lport = PAS_MEDIA_START_PORT;
+    for (port = PAS_MEDIA_START_PORT; port <= port_count; ++port) {
+        for (density = 0; density < info[port].port_density; ++density) {
+            TEST_CHECK(tbl[port].sub_port_ids[density] == lport,
+                       "port %u sub-port %u: id %u, expected %u",
+                       port, density, tbl[port].sub_port_ids[density], lport
+                       );
+            ++lport;
+        }
+    }
+
+    /* SDI handles: one per pluggable port, enumerated in order, plus one
+       too many
+    */
+
+    t0 = test_now_us();
+    next_port = PAS_MEDIA_START_PORT;
+    prev_port = 0;
+    for (; assigned <= pluggable; ++assigned) {
+        uint_t before = next_port;
+
+        port = dn_pas_media_topo_hdl_assign(tbl, &cfg,
+                                            (sdi_resource_hdl_t) (uintptr_t) (assigned + 1),
+                                            &next_port
+                                            );
+        walked += next_port - before;
+
+        if (assigned == pluggable) {
+            TEST_CHECK(port == PAS_MEDIA_INVALID_PORT,
+                       "extra handle assigned to port %u", port
+                       );
+            break;
+        }
+
+        TEST_CHECK(port > prev_port && port <= port_count
+                   && info[port].port_type == PLATFORM_PORT_TYPE_PLUGGABLE,
+                   "handle %u assigned to port %u", assigned + 1, port
+                   );
+        prev_port = port;
+    }
+    t_hdl = test_now_us() - t0;
+
+    for (port = PAS_MEDIA_START_PORT; port <= port_count; ++port) {
+        TEST_CHECK((tbl[port].res_hdl != NULL)
+                   == (info[port].port_type == PLATFORM_PORT_TYPE_PLUGGABLE),
+                   "port %u: handle %p", port, (void *) tbl[port].res_hdl
+                   );
+    }
+
+    /* One pass => Each port visited once, over all handles */
+
+    TEST_CHECK(walked <= port_count + 1,
+               "%u port visits for %u ports", walked, port_count
+               );
+
+    printf("%u ports (%u pluggable, %u sub-ports): sub-ports %.1f us, handles %.1f us, %u port visits\n",
+           port_count, pluggable, lport - PAS_MEDIA_START_PORT, t_sub, t_hdl,
+           walked
+           );
+
+ done:
+    free(cfg.port_info_tbl);
+    free(tbl);
+    free(info);
+}
+
+int main(void)
+{
+    test_topo(512);
+    test_topo(1024);
+
+    if (test_failures != 0) {
+        fprintf(stderr, "%u failure(s)\n", test_failures);
+
+        return (1);
+    }
+
+    return (0);
+}
@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: pas_media_type_ref.c
+ *
+ * Reference media type decoder, for pas_media_type_test: the compliance
+ * code decode of dn_pas_media_type_get, as it was before it was made table
+ * driven. It is not the whole of the old decoder: the vendor part number
+ * rules that ran first, since moved to the vendor part number database,
+ * are left out.
+ */
+
+#include "private/pas_media.h"
+
+#define ARRAY_SIZE(a)         (sizeof(a)/sizeof(a[0]))
+
+PLATFORM_MEDIA_TYPE_t pas_media_type_ref_get (pas_media_t *res_data);
+
+static const sdi_to_pas_map_t  media_sfp_gige_type_tbl [] = {
+    {0x01, PLATFORM_MEDIA_TYPE_SFP_SX},
+    {0x02, PLATFORM_MEDIA_TYPE_SFP_LX},
+    {0x04, PLATFORM_MEDIA_TYPE_SFP_CX},
+    {0x08, PLATFORM_MEDIA_TYPE_SFP_T},
+    {0x10, PLATFORM_MEDIA_TYPE_SFP_LX},
+    {0x20, PLATFORM_MEDIA_TYPE_SFP_FX},
+    {0x40, PLATFORM_MEDIA_TYPE_SFP_BX10},
+    {0x80, PLATFORM_MEDIA_TYPE_SFP_PX}
+};
+
+static uint_t dn_pas_media_pas_id_get (const sdi_to_pas_map_t *pmap,
+        uint_t count, uint_t id)
+{
+    uint_t index;
+
+    if ((pmap == NULL) || (count == 0)) {
+        return PAS_MEDIA_INVALID_ID;
+    }
+
+    for (index = 0; index < count; index++) {
+        if (pmap[index].sdi_id == id) {
+            return pmap[index].pas_id;
+        }
+    }
+
+    return PAS_MEDIA_INVALID_ID;
+}
+
+static PLATFORM_MEDIA_TYPE_t ref_sfp_media_type_find (pas_media_t *res_data)
+{
+    PLATFORM_MEDIA_TYPE_t optics_type = PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN;
+    uint_t                pas_id, sdi_id;
+
+    sdi_id = res_data->transceiver[SFP_GIGE_XCVR_CODE_OFFSET];
+
+    pas_id = dn_pas_media_pas_id_get(media_sfp_gige_type_tbl,
+            ARRAY_SIZE(media_sfp_gige_type_tbl), sdi_id);
+
+    if (pas_id != PAS_MEDIA_INVALID_ID) {
+
+        optics_type = pas_id;
+        if ((pas_id == PLATFORM_MEDIA_TYPE_SFP_LX)
+                && (res_data->wavelength == 1550)
+                && (res_data->length_sfm_km <= 80)) {
+
+            optics_type = PLATFORM_MEDIA_TYPE_SFP_ZX;
+        } else if (pas_id == PLATFORM_MEDIA_TYPE_SFP_BX10) {
+            if ((res_data->wavelength == 0x051E)
+                    && (res_data->length_sfm_km == 0xA)) {
+                optics_type = PLATFORM_MEDIA_TYPE_SFP_BX10_UP;
+            } else if ((res_data->wavelength == 0x051E)
+                    && (res_data->length_sfm_km == 0x28)) {
+                optics_type = PLATFORM_MEDIA_TYPE_SFP_BX40_UP;
+            } else if ((res_data->wavelength == 0x05D2)
+                    && (res_data->length_sfm_km == 0x50)) {
+                optics_type = PLATFORM_MEDIA_TYPE_SFP_BX80_UP;
+            } else if ((res_data->wavelength == 0x05D2)
+                    && (res_data->length_sfm_km == 0xA)) {
+                optics_type = PLATFORM_MEDIA_TYPE_SFP_BX10_DOWN;
+            } else if ((res_data->wavelength == 0x05D2)
+                    && (res_data->length_sfm_km == 0x28)) {
+                optics_type = PLATFORM_MEDIA_TYPE_SFP_BX40_DOWN;
+            } else if ((res_data->wavelength == 0x060E)
+                    && (res_data->length_sfm_km == 0x50)) {
+                optics_type = PLATFORM_MEDIA_TYPE_SFP_BX80_DOWN;
+            }
+        }
+
+    } else if ((res_data->wavelength != 0xFFFF)
+            && (res_data->wavelength != 0x0)) {
+
+        if (res_data->wavelength < 1000) {
+
+            optics_type = PLATFORM_MEDIA_TYPE_SFP_SX;
+
+        } else if (res_data->wavelength < 1350) {
+
+            optics_type = PLATFORM_MEDIA_TYPE_SFP_LX;
+
+        }
+    } else {
+
+        optics_type = PLATFORM_MEDIA_TYPE_SFP_ZX;
+    }
+
+    return optics_type;
+}
+
+static PLATFORM_MEDIA_TYPE_t ref_std_optics_type_get (pas_media_t *res_data)
+{
+    uint8_t transmitter_code;
+    sdi_media_transceiver_descr_t *trans_desc =
+        (sdi_media_transceiver_descr_t *) res_data->transceiver;
+
+    if (res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP28) {
+        switch ((res_data->options >> QSFP28_OPTION1_BIT_SHIFT) &
+                (QSFP28_OPTION1_BIT_MASK)) {
+            case QSFP_100GBASE_AOC:
+                return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_AOC);
+            case QSFP_100GBASE_SR4:
+                return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_SR4);
+            case QSFP_100GBASE_LR4:
+                return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_LR4);
+            case QSFP_100GBASE_CWDM4:
+                return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CWDM4);
+            case QSFP_100GBASE_PSM4_IR:
+                return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_PSM4_IR);
+            case QSFP_100GBASE_CR4:
+            case QSFP28_BRKOUT_CR_CAS:
+            case QSFP28_BRKOUT_CR_CAN:
+                if (res_data->free_side_dev_prop == 0x40) {
+                    return PLATFORM_MEDIA_TYPE_4X25_25GBASE_CR1;
+                } else if (res_data->free_side_dev_prop == 0x50) {
+                    return PLATFORM_MEDIA_TYPE_2X50_50GBASE_CR2;
+                }
+                switch (res_data->length_cable) {
+                    case 1:
+                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_1M);
+                    case 2:
+                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_2M);
+                    case 3:
+                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_3M);
+                    case 4:
+                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_4M);
+                    case 5:
+                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_5M);
+                    default:
+                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4);
+                }
+            default:
+                break;
+        }
+
+        transmitter_code = res_data->device_tech >> PAS_QSFP_TRANS_TECH_OFFSET;
+        switch (transmitter_code) {
+            case QSFP_COPPER_UNEQ:
+            case QSFP_COPPER_PASSIVE_EQ:
+            case QSFP_COPPER_NEAR_FAR_EQ:
+            case QSFP_COPPER_FAR_EQ:
+            case QSFP_COPPER_NEAR_EQ:
+            case QSFP_COPPER_LINEAR_ACTIVE:
+                switch (res_data->length_cable) {
+                    case 1:
+                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_1M);
+                    case 2:
+                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_2M);
+                    case 3:
+                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_3M);
+                    case 4:
+                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_4M);
+                    case 5:
+                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4_5M);
+                    default:
+                        return (PLATFORM_MEDIA_TYPE_AR_QSFP28_100GBASE_CR4);
+                }
+        }
+    } else if ((res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP_PLUS)
+            || (res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP)) {
+        switch (trans_desc->qsfp_descr.sdi_qsfp_eth_1040g_code) {
+
+            case QSFP_40GBASE_LR4:
+                return(PLATFORM_MEDIA_TYPE_AR_QSFP_40GBASE_LR4);
+            case QSFP_40GBASE_SR4:
+                return(PLATFORM_MEDIA_TYPE_AR_QSFP_40GBASE_SR4);
+            case QSFP_40GBASE_CR4:
+                return(PLATFORM_MEDIA_TYPE_AR_QSFP_40GBASE_CR4);
+            case QSFP_40G_ACTIVE_CABLE:
+                return (PLATFORM_MEDIA_TYPE_QSFP_40GBASE_AOC);
+            default:
+                break;
+        }
+
+        if ((res_data->options & QSFP28_OPTION1_BIT_MASK)
+                == QSFP_40GBASE_ER4) {
+            return (PLATFORM_MEDIA_TYPE_QSFP_40GBASE_ER4);
+        }
+
+        transmitter_code = res_data->device_tech >> PAS_QSFP_TRANS_TECH_OFFSET;
+
+        switch (transmitter_code) {
+            case QSFP_COPPER_UNEQ:
+            case QSFP_COPPER_PASSIVE_EQ:
+            case QSFP_COPPER_NEAR_FAR_EQ:
+            case QSFP_COPPER_FAR_EQ:
+            case QSFP_COPPER_NEAR_EQ:
+            case QSFP_COPPER_LINEAR_ACTIVE:
+                return (PLATFORM_MEDIA_TYPE_AR_QSFP_40GBASE_CR4);
+            default:
+                break;
+        }
+    } else if (res_data->category == PLATFORM_MEDIA_CATEGORY_SFP_PLUS) {
+        /* \todo add support for handling sfp plus media type */
+
+        switch (trans_desc->sfp_descr.sdi_sfp_eth_10g_code) {
+            case SFP_10GBASE_SR:
+                return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_SR;
+            case SFP_10GBASE_LR:
+                return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_LR;
+            case SFP_10GBASE_LRM:
+                return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_LRM;
+            case SFP_10GBASE_ER:
+                return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_ER;
+            default:
+                break;
+        }
+
+        if (trans_desc->sfp_descr.sdi_sfp_plus_cable_technology
+                == SFP_PLUS_PASSIVE_CABLE) {
+            switch (res_data->length_cable) {
+                case 1:
+                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU1M;
+                case 2:
+                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU2M;
+                case 3:
+                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU3M;
+                case 5:
+                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU5M;
+                default:
+                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU1M;
+            }
+        } else if (trans_desc->sfp_descr.sdi_sfp_plus_cable_technology
+                == SFP_PLUS_ACTIVE_CABLE) {
+            switch (res_data->length_cable) {
+                case 7:
+                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU7M;
+                case 10:
+                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU10M;
+                default:
+                    return PLATFORM_MEDIA_TYPE_AR_SFPPLUS_10GBASE_CU7M;
+            }
+        } else if (trans_desc->sfp_descr.sdi_sfp_fc_media == 0x01) {
+            switch(dn_pas_max_fc_supported_speed(trans_desc->sfp_descr.sdi_sfp_fc_speed)) {
+                case BASE_IF_SPEED_8GFC:
+                    res_data->capability = BASE_IF_SPEED_8GFC;
+                    return PLATFORM_MEDIA_TYPE_SFPPLUS_8GBASE_FC_LW;
+                case BASE_IF_SPEED_16GFC:
+                    res_data->capability = BASE_IF_SPEED_16GFC;
+                    return PLATFORM_MEDIA_TYPE_SFPPLUS_16GBASE_FC_LW;
+                default:
+                    return PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN;
+            }
+        } else if (trans_desc->sfp_descr.sdi_sfp_fc_media & 0x04) {
+            switch(dn_pas_max_fc_supported_speed(trans_desc->sfp_descr.sdi_sfp_fc_speed)) {
+                case BASE_IF_SPEED_8GFC:
+                    res_data->capability = BASE_IF_SPEED_8GFC;
+                    return PLATFORM_MEDIA_TYPE_SFPPLUS_8GBASE_FC_SW;
+                case BASE_IF_SPEED_16GFC:
+                    res_data->capability = BASE_IF_SPEED_16GFC;
+                    return PLATFORM_MEDIA_TYPE_SFPPLUS_16GBASE_FC_SW;
+                default:
+                    return PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN;
+            }
+        }
+    } else if (res_data->category == PLATFORM_MEDIA_CATEGORY_QSFP_DD) {
+        /* \todo add extra support for handling QSFP-DD media types. */
+        uint_t length = res_data->length_cable;
+        /* This uses the information in the "options' field when the qualifier string fails*/
+        /* Relevant data is upper byte of 32 bits */
+        switch((char)( (res_data->options >> 24) & 0xFF) ){
+            /* 2xCR4 */
+            case 0x0B:
+                switch(length){
+                    case 0x01:
+                        return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4_1M;
+                    case 0x02:
+                        return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4_2M;
+                    case 0x03:
+                        return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4_3M;
+                    case 0x05:
+                        return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4_5M;
+                    default:
+                        return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CR4;
+                }
+            break;
+            /* 2xSR4 */
+            case 0x02:
+                    return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_SR4;
+            break;
+
+            /* 2xLR4 */
+            case 0x03:
+                return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_2SR4_AOC;
+            break;
+
+            /* 2xCWDM4 */
+            case 0x06:
+                return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_CWDM4;
+            break;
+
+            /* 2xPSM4 */
+            case 0x07:
+                return PLATFORM_MEDIA_TYPE_QSFP28_DD_200GBASE_PSM4_IR;
+            break;
+
+            /* Unkown or not yet supported*/
+            default:
+                return PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN;
+        }
+    } else if (res_data->category == PLATFORM_MEDIA_CATEGORY_SFP28) {
+        if (res_data->ext_transceiver == 0x2) {
+            if ((res_data->length_om3 == 0x7)
+                    && (res_data->length_cable == 0xA)) {
+                return PLATFORM_MEDIA_TYPE_SFP28_25GBASE_SR;
+            } else if ((res_data->length_om3 == 0x3)
+                    && (res_data->length_cable == 0x4)) {
+                return PLATFORM_MEDIA_TYPE_SFP28_25GBASE_SR_NOF;
+            } else if ((res_data->length_om3 == 0x14)
+                    && (res_data->length_cable == 0x1E)) {
+                return PLATFORM_MEDIA_TYPE_SFP28_25GBASE_ESR;
+            }
+        } else if (res_data->ext_transceiver == 0x3) {
+            if (res_data->length_sfm_km == 0xA) {
+                return PLATFORM_MEDIA_TYPE_SFP28_25GBASE_LR;
+            } else if (res_data->length_sfm_km == 0x2) {
+                return PLATFORM_MEDIA_TYPE_SFP28_25GBASE_LR_LITE;
+            }
+        } else if ((res_data->ext_transceiver == 0xB)
+                || (res_data->ext_transceiver == 0xC)
+                || (res_data->ext_transceiver == 0xD)) {
+            return PLATFORM_MEDIA_TYPE_SFP28_25GBASE_CR1;
+        }
+    } else if (res_data->category == PLATFORM_MEDIA_CATEGORY_DEPOP_QSFP28) {
+        return PLATFORM_MEDIA_TYPE_QSFPPLUS_50GBASE_CR2;
+    }
+
+    return (PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN);
+}
+
+PLATFORM_MEDIA_TYPE_t pas_media_type_ref_get (pas_media_t *res_data)
+{
+    PLATFORM_MEDIA_TYPE_t     op_type = PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN;
+    sdi_media_transceiver_descr_t *ptr = NULL;
+
+    /* read programmed product Id */
+
+    ptr = (sdi_media_transceiver_descr_t *) &(res_data->transceiver);
+
+    if ((res_data->category == PLATFORM_MEDIA_CATEGORY_SFP_PLUS)
+        && (ptr->sfp_descr.sdi_sfp_eth_10g_code == PAS_SFP_INVALID_GIGE_CODE)
+        && (ptr->sfp_descr.sdi_sfp_eth_10g_code == PAS_SFP_INVALID_GIGE_CODE)
+        && (ptr->sfp_descr.sdi_sfp_eth_1g_code != PAS_SFP_INVALID_GIGE_CODE)
+        && (ptr->sfp_descr.sdi_sfp_plus_cable_technology == PAS_SFP_INVALID_GIGE_CODE)) {
+
+        /* Must also not be 4,8,16,32GFC.
+           Anything higher will never get to this portion of code anyways so no need to check */
+        switch (dn_pas_max_fc_supported_speed(ptr->sfp_descr.sdi_sfp_fc_speed)){
+        case BASE_IF_SPEED_4GFC:
+        case BASE_IF_SPEED_8GFC:
+        case BASE_IF_SPEED_16GFC:
+        case BASE_IF_SPEED_32GFC:
+            break;
+
+        default:
+            /* Has to be SFP at this point */
+            res_data->category = PLATFORM_MEDIA_CATEGORY_SFP;
+            res_data->qualified = true;
+            return ref_sfp_media_type_find(res_data);
+        }
+    }
+
+    if(op_type == PLATFORM_MEDIA_TYPE_SFPPLUS_8GBASE_FC_SW) {
+
+        if(res_data->wavelength == 1310 && res_data->length_sfm_km == 10) {
+            op_type = PLATFORM_MEDIA_TYPE_SFPPLUS_8GBASE_FC_LW;
+        }
+    }
+
+    if (op_type == PLATFORM_MEDIA_TYPE_AR_POPTICS_UNKNOWN) {
+        /* Look at the optics serial ID EEPROM for further
+         * information about optics type */
+        op_type = ref_std_optics_type_get(res_data);
+    }
+    return(op_type);
+}
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: pas_media_type_test.c
+ *
+ * Equivalence test of the table driven media type decode: for every
+ * combination of compliance, technology and length codes the decoder
+ * looks at, dn_pas_media_type_get must give the same type, category,
+ * qualification and capability as the reference decoder, see
+ * pas_media_type_ref.c. Every row of the decode tables must also be
+ * matched by at least one case.
+ *
+ * pas_media_utils.c is included, rather than linked, for its tables.
+ */
+
+static void test_row_hit(const void *row);
+
+#define PAS_MEDIA_TYPE_ROW_HIT(_row)  test_row_hit(_row)
+
+#include "../pas_media_utils.c"
+
+#include <stdio.h>
+#include <string.h>
+
+PLATFORM_MEDIA_TYPE_t pas_media_type_ref_get (pas_media_t *res_data);
+
+/* Stubs for what pas_media_utils.c uses, outside of media type decode */
+
+struct pas_config_media *dn_pas_config_media_get(void)
+{
+    static struct pas_config_media cfg;
+
+    return (&cfg);
+}
+
+bool dn_pas_is_port_pluggable(uint_t port)
+{
+    return (false);
+}
+
+const pas_media_vpn_rec_t *dn_pas_media_vpn_db_find(const char *vendor_pn,
+                                                    const char *vendor_rev
+                                                    )
+{
+    return (NULL);
+}
+
+t_std_error sdi_media_qsa_adapter_type_get(sdi_resource_hdl_t resource_hdl,
+                                           sdi_qsa_adapter_type_t *qsa_adapter
+                                           )
+{
+    return (STD_ERR(PAS, FAIL, 0));
+}
+
+static const PLATFORM_MEDIA_CATEGORY_t test_categories[] = {
+    PLATFORM_MEDIA_CATEGORY_QSFP28,
+    PLATFORM_MEDIA_CATEGORY_QSFP_PLUS,
+    PLATFORM_MEDIA_CATEGORY_QSFP,
+    PLATFORM_MEDIA_CATEGORY_SFP_PLUS,
+    PLATFORM_MEDIA_CATEGORY_QSFP_DD,
+    PLATFORM_MEDIA_CATEGORY_SFP28,
+    PLATFORM_MEDIA_CATEGORY_DEPOP_QSFP28,
+    PLATFORM_MEDIA_CATEGORY_CXP
+};
+
+/* Lengths and distances decoded, and their neighbours; used for the cable,
+   OM3 and SMF lengths independently
+*/
+
+static const uint_t test_lengths[] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0x0a, 0x0b, 0x13, 0x14, 0x15, 0x1d, 0x1e,
+    0x1f, 0x27, 0x28, 0x29, 0x4f, 0x50, 0x51, 0xff
+};
+
+static const uint_t test_free_side[] = { 0, 0x40, 0x50, 0x60 };
+
+static const uint_t test_wavelengths[] = {
+    0, 850, 999, 1000, 1310, 1349, 1350, 0x051e, 1490, 0x05d2, 1550,
+    0x060e, 0xffff
+};
+
+static unsigned long test_cases = 0, test_failures = 0;
+
+/* Decode tables, and which of their rows have been matched */
+
+#define TEST_TBL(_tbl)  { #_tbl, (_tbl), sizeof((_tbl)[0]), ARRAY_SIZE(_tbl) }
+
+static const struct {
+    const char *name;
+    const void *rows;
+    size_t     row_size;
+    uint_t     count;
+} test_tbls[] = {
+    TEST_TBL(media_sfp_gige_type_tbl),
+    TEST_TBL(media_sfp_bx_type_tbl),
+    TEST_TBL(media_qsfp28_option_type_tbl),
+    TEST_TBL(media_qsfp28_option_copper_tbl),
+    TEST_TBL(media_qsfp_copper_tech_tbl),
+    TEST_TBL(media_qsfp28_breakout_type_tbl),
+    TEST_TBL(media_qsfp28_cr4_len_type_tbl),
+    TEST_TBL(media_qsfp_1040g_type_tbl),
+    TEST_TBL(media_sfpplus_10g_type_tbl),
+    TEST_TBL(media_sfpplus_passive_len_type_tbl),
+    TEST_TBL(media_sfpplus_active_len_type_tbl),
+    TEST_TBL(media_sfpplus_fc_lw_type_tbl),
+    TEST_TBL(media_sfpplus_fc_sw_type_tbl),
+    TEST_TBL(media_qsfp28_dd_option_type_tbl),
+    TEST_TBL(media_qsfp28_dd_cr4_len_type_tbl),
+    TEST_TBL(media_sfp28_sr_type_tbl),
+    TEST_TBL(media_sfp28_lr_type_tbl),
+    TEST_TBL(media_sfp28_ext_type_tbl)
+};
+
+#define TEST_TBL_ROWS_MAX  16
+
+static unsigned long test_tbl_hits[ARRAY_SIZE(test_tbls)][TEST_TBL_ROWS_MAX];
+
+static void test_row_hit(const void *row)
+{
+    uint_t t;
+
+    for (t = 0; t < ARRAY_SIZE(test_tbls); ++t) {
+        const char *base = (const char *) test_tbls[t].rows;
+        const char *p    = (const char *) row;
+
+        if (p >= base && p < base + test_tbls[t].count * test_tbls[t].row_size) {
+            ++test_tbl_hits[t][(p - base) / test_tbls[t].row_size];
+            return;
+        }
+    }
+}
+
+static void test_rows_check(void)
+{
+    uint_t t, r;
+
+    for (t = 0; t < ARRAY_SIZE(test_tbls); ++t) {
+        if (test_tbls[t].count > TEST_TBL_ROWS_MAX) {
+            fprintf(stderr, "FAIL %s: too many rows\n", test_tbls[t].name);
+            ++test_failures;
+            continue;
+        }
+        for (r = 0; r < test_tbls[t].count; ++r) {
+            if (test_tbl_hits[t][r] == 0) {
+                fprintf(stderr, "FAIL %s: row %u never matched\n",
+                        test_tbls[t].name, r
+                        );
+                ++test_failures;
+            }
+        }
+    }
+}
+
+static void test_compare(const pas_media_t *in, const char *what)
+{
+    pas_media_t           a = *in, b = *in;
+    PLATFORM_MEDIA_TYPE_t ta, tb;
+
+    ta = dn_pas_media_type_get(&a);
+    tb = pas_media_type_ref_get(&b);
+
+    ++test_cases;
+
+    if (ta != tb || a.category != b.category || a.qualified != b.qualified
+        || a.capability != b.capability
+        ) {
+        if (test_failures++ < 10) {
+            fprintf(stderr,
+                    "FAIL %s: category %u options 0x%x device tech 0x%x lengths %u/%u/%u: type %u, expected %u\n",
+                    what, in->category, in->options, in->device_tech,
+                    in->length_cable, in->length_om3, in->length_sfm_km,
+                    ta, tb
+                    );
+        }
+    }
+}
+
+/* SFP+ cable technology, and fibre channel media and speed codes */
+
+static const uint8_t test_cable_tech[] = {
+    0, 1, SFP_PLUS_PASSIVE_CABLE, SFP_PLUS_ACTIVE_CABLE,
+    SFP_PLUS_PASSIVE_CABLE | SFP_PLUS_ACTIVE_CABLE
+};
+
+static const uint8_t test_fc_media[] = { 0, 0x01, 0x02, 0x04, 0x05 };
+
+static const uint8_t test_fc_speed[] = { 0, 0x08, 0x10, 0x20, 0x40, 0x70 };
+
+/* Standard compliance decode, dn_pas_std_optics_type_get. Every value of
+   the code byte each category decodes is tried, with each technology
+   value, and each cable length. SFP28, the only category to decode OM3
+   and SMF lengths, gets every combination of the three lengths, and no
+   technology values, having no technology field.
+*/
+
+static void test_std_one(PLATFORM_MEDIA_CATEGORY_t cat, uint_t hi, uint_t lo,
+                         uint_t tech, uint_t cable, uint_t om3, uint_t smf,
+                         uint_t free_side
+                         )
+{
+    pas_media_t                   m;
+    sdi_media_transceiver_descr_t *d = (sdi_media_transceiver_descr_t *) m.transceiver;
+    bool qsfp = (cat == PLATFORM_MEDIA_CATEGORY_QSFP_PLUS)
+        || (cat == PLATFORM_MEDIA_CATEGORY_QSFP);
+
+    memset(&m, 0, sizeof(m));
+    m.category           = cat;
+    m.options            = (hi << 24) | (qsfp ? lo : 0);
+    m.device_tech        = tech << PAS_QSFP_TRANS_TECH_OFFSET;
+    m.length_cable       = cable;
+    m.length_om3         = om3;
+    m.length_sfm_km      = smf;
+    m.free_side_dev_prop = free_side;
+    m.ext_transceiver    = hi;
+
+    if (cat == PLATFORM_MEDIA_CATEGORY_SFP_PLUS) {
+        uint_t n = lo;
+
+        d->sfp_descr.sdi_sfp_eth_10g_code = hi;
+        d->sfp_descr.sdi_sfp_fc_speed = test_fc_speed[n % ARRAY_SIZE(test_fc_speed)];
+        n /= ARRAY_SIZE(test_fc_speed);
+        d->sfp_descr.sdi_sfp_fc_media = test_fc_media[n % ARRAY_SIZE(test_fc_media)];
+        n /= ARRAY_SIZE(test_fc_media);
+        d->sfp_descr.sdi_sfp_plus_cable_technology = test_cable_tech[n];
+    } else {
+        d->qsfp_descr.sdi_qsfp_eth_1040g_code = lo;
+    }
+
+    test_compare(&m, "standard");
+}
+
+static void test_std(void)
+{
+    uint_t c, hi, lo, tech, l, om3, smf, f;
+    uint_t hi_n, lo_n, tech_n, om3_n, smf_n, f_n;
+
+    for (c = 0; c < ARRAY_SIZE(test_categories); ++c) {
+        PLATFORM_MEDIA_CATEGORY_t cat = test_categories[c];
+        bool qsfp = (cat == PLATFORM_MEDIA_CATEGORY_QSFP_PLUS)
+            || (cat == PLATFORM_MEDIA_CATEGORY_QSFP);
+        bool sfp_plus = (cat == PLATFORM_MEDIA_CATEGORY_SFP_PLUS);
+        bool sfp28 = (cat == PLATFORM_MEDIA_CATEGORY_SFP28);
+
+        /* hi: options upper byte, extended compliance or 10G code;
+           lo: options lower byte and 40G code, or SFP+ cable and FC codes
+        */
+
+        hi_n   = qsfp ? 1 : 256;
+        lo_n   = qsfp ? 256
+            : sfp_plus ? (ARRAY_SIZE(test_cable_tech) * ARRAY_SIZE(test_fc_media)
+                          * ARRAY_SIZE(test_fc_speed))
+            : 1;
+        tech_n = (sfp_plus || sfp28) ? 1 : 16;
+        om3_n  = sfp28 ? ARRAY_SIZE(test_lengths) : 1;
+        smf_n  = sfp28 ? ARRAY_SIZE(test_lengths) : 1;
+        f_n    = (cat == PLATFORM_MEDIA_CATEGORY_QSFP28) ? ARRAY_SIZE(test_free_side) : 1;
+
+        for (hi = 0; hi < hi_n; ++hi) {
+            for (lo = 0; lo < lo_n; ++lo) {
+                for (tech = 0; tech < tech_n; ++tech) {
+                    for (l = 0; l < ARRAY_SIZE(test_lengths); ++l) {
+                        for (om3 = 0; om3 < om3_n; ++om3) {
+                            for (smf = 0; smf < smf_n; ++smf) {
+                                for (f = 0; f < f_n; ++f) {
+                                    test_std_one(cat, hi, lo, tech,
+                                                 test_lengths[l],
+                                                 test_lengths[om3],
+                                                 test_lengths[smf],
+                                                 test_free_side[f]
+                                                 );
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* 1G SFP decode, dn_pas_sfp_media_type_find */
+
+static void test_sfp(void)
+{
+    pas_media_t                   m;
+    sdi_media_transceiver_descr_t *d = (sdi_media_transceiver_descr_t *) m.transceiver;
+    uint_t                        code, w, l;
+
+    for (code = 0; code < 256; ++code) {
+        if (code == PAS_SFP_INVALID_GIGE_CODE)  continue;
+
+        for (w = 0; w < ARRAY_SIZE(test_wavelengths); ++w) {
+            for (l = 0; l < ARRAY_SIZE(test_lengths); ++l) {
+                memset(&m, 0, sizeof(m));
+                m.category      = PLATFORM_MEDIA_CATEGORY_SFP_PLUS;
+                m.wavelength    = test_wavelengths[w];
+                m.length_sfm_km = test_lengths[l];
+
+                d->sfp_descr.sdi_sfp_eth_10g_code          = PAS_SFP_INVALID_GIGE_CODE;
+                d->sfp_descr.sdi_sfp_plus_cable_technology = PAS_SFP_INVALID_GIGE_CODE;
+                d->sfp_descr.sdi_sfp_eth_1g_code           = code;
+                m.transceiver[SFP_GIGE_XCVR_CODE_OFFSET]   = code;
+
+                test_compare(&m, "SFP");
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    test_std();
+    test_sfp();
+    test_rows_check();
+
+    printf("%lu cases, %lu failures\n", test_cases, test_failures);
+
+    return ((test_failures == 0) ? 0 : 1);
+}